@@ -0,0 +1,661 @@
+// Copyright (c) 2025 Elias Engelbert Plank
+
+#include <assert.h>
+#include <ctype.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// NOTE: keep the order of includes as is, required for unity build
+// clang-format off
+#include "util/util.c"
+#include "arch/arch.c"
+#include "gpu/gpu.c"
+#include "core/core.c"
+// clang-format on
+
+#ifndef BENCH_PROGRAM_DIRECTORY
+#define BENCH_PROGRAM_DIRECTORY "bench/programs"
+#endif
+
+enum {
+    BENCH_RESULT_CAPACITY = 64,
+    BENCH_NAME_LENGTH = 64,
+    BENCH_REPETITIONS = 5,
+    BENCH_TOKENIZE_LINES = 10000,
+    BENCH_PROGRAM_LINES = 5000,
+    BENCH_EXPRESSION_DEPTH = 64,
+    BENCH_ARENA_ALLOCATIONS = 4096
+};
+
+/// The minimum time a single repetition of a benchmark runs for, in nanoseconds
+static u64 const BENCH_MINIMUM_TIME = 50000000ull;
+
+/// A benchmark function runs the specified amount of iterations and returns the time in
+/// nanoseconds that was spent in the measured section, so that setup can be excluded
+typedef u64 (*BenchFunction)(void *context, u64 iterations);
+
+typedef struct BenchResult {
+    char name[BENCH_NAME_LENGTH];
+    u64 iterations;
+    f64 best;
+    f64 median;
+    b32 skipped;
+} BenchResult;
+
+typedef struct Bench {
+    BenchResult results[BENCH_RESULT_CAPACITY];
+    u32 count;
+} Bench;
+
+/// Compares two durations for sorting
+static int bench_compare(void const *first, void const *second) {
+    f64 const a = *(f64 const *) first;
+    f64 const b = *(f64 const *) second;
+    return (a > b) - (a < b);
+}
+
+/// Runs the benchmark function until a repetition takes long enough to be measured reliably and
+/// records the best and median time per operation of several repetitions. An operation is one
+/// iteration divided by the amount of operations per iteration.
+static void bench_run(Bench *self, char const *name, BenchFunction function, void *context, u64 const operations) {
+    assert(self->count < BENCH_RESULT_CAPACITY && "too many benchmarks");
+    BenchResult *result = self->results + self->count++;
+    snprintf(result->name, sizeof result->name, "%s", name);
+    result->skipped = false;
+
+    u64 iterations = 1;
+    while (function(context, iterations) < BENCH_MINIMUM_TIME && iterations < (1ull << 40)) {
+        iterations *= 2;
+    }
+
+    f64 samples[BENCH_REPETITIONS];
+    for (u32 repetition = 0; repetition < BENCH_REPETITIONS; ++repetition) {
+        samples[repetition] = (f64) function(context, iterations) / (f64) (iterations * operations);
+    }
+    qsort(samples, BENCH_REPETITIONS, sizeof(f64), bench_compare);
+
+    result->iterations = iterations * operations;
+    result->best = samples[0];
+    result->median = samples[BENCH_REPETITIONS / 2];
+    fprintf(stderr, "%-40s %14.2f ns/op %14.2f ns/op (median)\n", name, result->best, result->median);
+}
+
+/// Records a benchmark that could not be run
+static void bench_skip(Bench *self, char const *name, char const *reason) {
+    assert(self->count < BENCH_RESULT_CAPACITY && "too many benchmarks");
+    BenchResult *result = self->results + self->count++;
+    snprintf(result->name, sizeof result->name, "%s", name);
+    result->iterations = 0;
+    result->best = 0.0;
+    result->median = 0.0;
+    result->skipped = true;
+    fprintf(stderr, "%-40s skipped: %s\n", name, reason);
+}
+
+/// Writes all results as JSON
+static void bench_write_json(Bench const *self, FILE *file) {
+    fprintf(file, "{\n  \"unit\": \"ns/op\",\n  \"benchmarks\": [\n");
+    for (u32 index = 0; index < self->count; ++index) {
+        BenchResult const *result = self->results + index;
+        fprintf(file,
+                "    { \"name\": \"%s\", \"skipped\": %s, \"operations\": %llu, \"best\": %.3f, \"median\": %.3f }%s\n",
+                result->name, result->skipped ? "true" : "false", (unsigned long long) result->iterations,
+                result->best, result->median, index + 1 < self->count ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+}
+
+typedef struct TokenizeContext {
+    char *source;
+    usize length;
+    TokenList tokens;
+} TokenizeContext;
+
+/// Tokenizes the whole source
+static u64 bench_tokenize(void *context, u64 const iterations) {
+    TokenizeContext *self = context;
+    u64 const begin = time_now();
+    for (u64 iteration = 0; iteration < iterations; ++iteration) {
+        tokenize(&self->tokens, self->source, self->length);
+    }
+    return time_now() - begin;
+}
+
+typedef struct ExpressionContext {
+    Emulator *emulator;
+    TokenList tokens;
+    ExpressionIndex expression;
+    Chunk chunk;
+} ExpressionContext;
+
+/// Compiles the expression, the expression pool is recreated in the measured section as its growth
+/// is part of the cost of compiling
+static u64 bench_expression_compile(void *context, u64 const iterations) {
+    ExpressionContext *self = context;
+    TokenIterator iterator;
+    token_iterator_create(&iterator, &self->tokens);
+
+    ExpressionPool pool;
+    expression_pool_create(&pool);
+    u64 const begin = time_now();
+    for (u64 iteration = 0; iteration < iterations; ++iteration) {
+        if ((iteration & 1023) == 1023) {
+            expression_pool_destroy(&pool);
+            expression_pool_create(&pool);
+        }
+        TokenIterator state = iterator;
+        ExpressionIndex const expression = expression_compile(&pool, &state);
+        assert(expression != EXPRESSION_NONE && "expression must compile");
+    }
+    u64 const elapsed = time_now() - begin;
+    expression_pool_destroy(&pool);
+    return elapsed;
+}
+
+/// Evaluates the expression by walking the syntax tree
+static u64 bench_expression_evaluate(void *context, u64 const iterations) {
+    ExpressionContext *self = context;
+    Program *program = &self->emulator->program;
+    f64 sink = 0.0;
+    u64 const begin = time_now();
+    for (u64 iteration = 0; iteration < iterations; ++iteration) {
+        sink += expression_evaluate(self->expression, program);
+    }
+    u64 const elapsed = time_now() - begin;
+    assert(sink == sink && "result must be a number");
+    return elapsed;
+}
+
+/// Evaluates the compiled expression on the virtual machine
+static u64 bench_vm_execute(void *context, u64 const iterations) {
+    ExpressionContext *self = context;
+    Program *program = &self->emulator->program;
+    f64 sink = 0.0;
+    u64 const begin = time_now();
+    for (u64 iteration = 0; iteration < iterations; ++iteration) {
+        sink += vm_execute(program, &self->chunk, 0);
+    }
+    u64 const elapsed = time_now() - begin;
+    assert(sink == sink && "result must be a number");
+    return elapsed;
+}
+
+typedef struct InternContext {
+    char *keys;
+    u32 count;
+
+    /// The table that holds all keys and the identifiers it assigned to them
+    InternTable table;
+    InternName *names;
+
+    /// The symbols that assigned a slot to every identifier
+    ProgramSymbols symbols;
+} InternContext;
+
+enum {
+    BENCH_KEY_LENGTH = 16
+};
+
+/// Interns all keys into a new intern table, like the parser does for the names of a new program
+static u64 bench_intern_table_insert(void *context, u64 const iterations) {
+    InternContext const *self = context;
+    u64 elapsed = 0;
+    for (u64 iteration = 0; iteration < iterations; ++iteration) {
+        InternTable table;
+        intern_table_create(&table);
+        u64 const begin = time_now();
+        for (u32 index = 0; index < self->count; ++index) {
+            char const *key = self->keys + (usize) index * BENCH_KEY_LENGTH;
+            intern_table_intern(&table, key, strlen(key));
+        }
+        elapsed += time_now() - begin;
+        intern_table_destroy(&table);
+    }
+    return elapsed;
+}
+
+/// Interns all keys again, which finds the identifiers the prepared table assigned before
+static u64 bench_intern_table_find(void *context, u64 const iterations) {
+    InternContext *self = context;
+    usize sink = 0;
+    u64 const begin = time_now();
+    for (u64 iteration = 0; iteration < iterations; ++iteration) {
+        for (u32 index = 0; index < self->count; ++index) {
+            char const *key = self->keys + (usize) index * BENCH_KEY_LENGTH;
+            sink += intern_table_intern(&self->table, key, strlen(key));
+        }
+    }
+    u64 const elapsed = time_now() - begin;
+    assert(sink != 0 && "keys must be found");
+    return elapsed;
+}
+
+/// Looks up the slots of all interned names, like the compiler does for every variable reference
+static u64 bench_program_symbol(void *context, u64 const iterations) {
+    InternContext *self = context;
+    u32 count = self->count;
+    usize sink = 0;
+    u64 const begin = time_now();
+    for (u64 iteration = 0; iteration < iterations; ++iteration) {
+        for (u32 index = 0; index < self->count; ++index) {
+            sink += program_symbol(&self->symbols, self->names[index], &count);
+        }
+    }
+    u64 const elapsed = time_now() - begin;
+    assert(count == self->count && "names must have a slot");
+    assert(sink == sink && "slots must be summed");
+    return elapsed;
+}
+
+/// Performs small allocations in a new arena
+static u64 bench_arena_alloc(void *context, u64 const iterations) {
+    (void) context;
+    u64 elapsed = 0;
+    for (u64 iteration = 0; iteration < iterations; ++iteration) {
+        MemoryArena arena = arena_identity(ALIGNMENT8);
+        u64 const begin = time_now();
+        for (u32 index = 0; index < BENCH_ARENA_ALLOCATIONS; ++index) {
+            u8 *memory = arena_alloc(&arena, 24);
+            memory[0] = (u8) index;
+        }
+        elapsed += time_now() - begin;
+        arena_destroy(&arena);
+    }
+    return elapsed;
+}
+
+/// Performs small allocations in an arena that is reset in between, so that its blocks are reused
+static u64 bench_arena_reset(void *context, u64 const iterations) {
+    (void) context;
+    MemoryArena arena = arena_identity(ALIGNMENT8);
+    u64 const begin = time_now();
+    for (u64 iteration = 0; iteration < iterations; ++iteration) {
+        for (u32 index = 0; index < BENCH_ARENA_ALLOCATIONS; ++index) {
+            u8 *memory = arena_alloc(&arena, 24);
+            memory[0] = (u8) index;
+        }
+        arena_reset(&arena);
+    }
+    u64 const elapsed = time_now() - begin;
+    arena_destroy(&arena);
+    return elapsed;
+}
+
+/// Allocates and frees fixed-size slots in a pool, so that the slots are reused through the free list
+static u64 bench_pool_alloc(void *context, u64 const iterations) {
+    (void) context;
+    static void *slots[BENCH_ARENA_ALLOCATIONS];
+    MemoryPool pool;
+    pool_create(&pool, 24);
+
+    // The slot that was freed last is handed out by the next allocation
+    void *slot = pool_alloc(&pool);
+    pool_free(&pool, slot);
+    assert(pool_alloc(&pool) == slot && "freed slots must be reused");
+    pool_free(&pool, slot);
+
+    u64 const begin = time_now();
+    for (u64 iteration = 0; iteration < iterations; ++iteration) {
+        for (u32 index = 0; index < BENCH_ARENA_ALLOCATIONS; ++index) {
+            u8 *memory = pool_alloc(&pool);
+            memory[0] = (u8) index;
+            slots[index] = memory;
+        }
+        for (u32 index = 0; index < BENCH_ARENA_ALLOCATIONS; ++index) {
+            pool_free(&pool, slots[index]);
+        }
+    }
+    u64 const elapsed = time_now() - begin;
+    assert(pool.used == 0 && "all slots must be freed");
+    pool_destroy(&pool);
+    return elapsed;
+}
+
+/// Pushes lines into a full text queue like the history of the emulator, every push drops the oldest
+/// entry and reuses its slot
+static u64 bench_text_queue_push(void *context, u64 const iterations) {
+    (void) context;
+    TextQueue *queue = text_queue_new(EMULATOR_HISTORY_CAPACITY);
+    static char const line[] = "10 PRINT A * 2 + SQR(B)";
+    for (u32 index = 0; index < EMULATOR_HISTORY_CAPACITY; ++index) {
+        text_queue_push(queue, line, sizeof line - 1);
+    }
+    TextEntry const *second = queue->begin->next;
+    u32 const used = queue->pool.used;
+
+    u64 const begin = time_now();
+    for (u64 iteration = 0; iteration < iterations; ++iteration) {
+        text_queue_push(queue, line, sizeof line - 1);
+    }
+    u64 const elapsed = time_now() - begin;
+    assert(queue->entries == EMULATOR_HISTORY_CAPACITY && queue->pool.used == used && "the queue must stay bounded");
+    assert((iterations != 1 || queue->begin == second) && "the oldest entry must be dropped first");
+    text_queue_free(queue);
+    return elapsed;
+}
+
+typedef struct RenderContext {
+    Renderer *renderer;
+    Vertex vertices[QUAD_VERTICES];
+    u32 indices[QUAD_INDICES];
+} RenderContext;
+
+/// Fills the render group up to its capacity
+static void bench_render_group_fill(RenderContext const *self, RenderGroup *group) {
+    for (u32 index = 0; index < RENDER_GROUP_COMMANDS_MAX; ++index) {
+        render_group_push(group, self->vertices, self->indices);
+    }
+}
+
+/// Pushes commands until the render group is full, as a full group blocks
+static u64 bench_render_group_push(void *context, u64 const iterations) {
+    RenderContext const *self = context;
+    RenderGroup *group = self->renderer->quad_group;
+    u64 elapsed = 0;
+    for (u64 iteration = 0; iteration < iterations; ++iteration) {
+        u64 const begin = time_now();
+        bench_render_group_fill(self, group);
+        elapsed += time_now() - begin;
+        render_group_clear(group);
+    }
+    return elapsed;
+}
+
+/// Submits a full render group
+static u64 bench_render_group_submit(void *context, u64 const iterations) {
+    RenderContext const *self = context;
+    RenderGroup *group = self->renderer->quad_group;
+    u64 elapsed = 0;
+    for (u64 iteration = 0; iteration < iterations; ++iteration) {
+        bench_render_group_fill(self, group);
+        u64 const begin = time_now();
+        render_group_submit(group, &self->renderer->quad_shader);
+        glFinish();
+        elapsed += time_now() - begin;
+        render_group_clear(group);
+    }
+    return elapsed;
+}
+
+typedef struct ProgramContext {
+    Emulator *emulator;
+} ProgramContext;
+
+/// Executes the loaded program
+static u64 bench_program_execute(void *context, u64 const iterations) {
+    ProgramContext const *self = context;
+    u64 const begin = time_now();
+    for (u64 iteration = 0; iteration < iterations; ++iteration) {
+        program_execute(&self->emulator->program);
+    }
+    return time_now() - begin;
+}
+
+/// Replaces a single line of the program and links it, just like entering a line and running the program
+static u64 bench_program_link(void *context, u64 const iterations) {
+    ProgramContext const *self = context;
+    ProgramLines *lines = &self->emulator->program.lines;
+    u64 const begin = time_now();
+    for (u64 iteration = 0; iteration < iterations; ++iteration) {
+        program_lines_insert(lines, lines->data[iteration % lines->count].stmt);
+        program_lines_link(lines);
+    }
+    return time_now() - begin;
+}
+
+/// Compiles all lines of the program file, the program must not print anything as
+/// headless programs print to the standard output
+static b32 bench_load_program(Emulator *emulator, char const *path) {
+    BinaryBuffer buffer = { 0 };
+    if (!file_read(&buffer, path) || buffer.data == NULL) {
+        return false;
+    }
+
+    b32 success = true;
+    char const *end = buffer.data + buffer.size;
+    for (char const *line = buffer.data; success && line < end;) {
+        char const *newline = memchr(line, '\n', (usize) (end - line));
+        char const *line_end = newline != NULL ? newline : end;
+        tokenize(&emulator->tokens, line, (usize) (line_end - line));
+        if (emulator->tokens.count > 0) {
+            StatementResult const result = statement_compile(&emulator->arena, &emulator->program, &emulator->tokens);
+            success = result.type == RESULT_OK && result.statement->type != STATEMENT_RUN;
+            if (success) {
+                program_lines_insert(&emulator->program.lines, result.statement);
+            }
+        }
+        line = line_end + 1;
+    }
+    free(buffer.data);
+    return success;
+}
+
+/// Runs the lexer and expression benchmarks
+static void bench_micro_core(Bench *bench) {
+    Emulator emulator;
+    emulator_create(&emulator, NULL);
+
+    // A program that resembles typical BASIC code
+    TokenizeContext tokenize_context;
+    static char const *lines[] = { "%u LET A = B * 2 + SQR(C) - 3.5\n", "%u PRINT \"HELLO, WORLD\"\n",
+                                   "%u DEF FN F(X) = X ^ 2 + 1\n", "%u PRINTA*(B+C)/2\n" };
+    usize const capacity = (usize) BENCH_TOKENIZE_LINES * 48;
+    tokenize_context.source = malloc(capacity);
+    tokenize_context.length = 0;
+    for (u32 line = 0; line < BENCH_TOKENIZE_LINES; ++line) {
+        tokenize_context.length += (usize) snprintf(tokenize_context.source + tokenize_context.length,
+                                                    capacity - tokenize_context.length,
+                                                    lines[line % STACK_ARRAY_SIZE(lines)], (line + 1) * 10);
+    }
+    token_list_create(&tokenize_context.tokens, TOKEN_LIST_CAPACITY);
+    tokenize(&tokenize_context.tokens, tokenize_context.source, tokenize_context.length);
+    bench_run(bench, "micro/tokenize/line", bench_tokenize, &tokenize_context, BENCH_TOKENIZE_LINES);
+    token_list_destroy(&tokenize_context.tokens);
+    free(tokenize_context.source);
+
+    // A deeply nested expression that cannot be folded, as every level depends on X
+    char source[BENCH_EXPRESSION_DEPTH * 16];
+    usize length = (usize) snprintf(source, sizeof source, "X");
+    static char const operators[] = { '+', '*', '-', '/' };
+    for (u32 level = 0; level < BENCH_EXPRESSION_DEPTH; ++level) {
+        char inner[sizeof source];
+        memcpy(inner, source, length);
+        length = (usize) snprintf(source, sizeof source, "(%.*s %c %u)", (int) length, inner,
+                                  operators[level % STACK_ARRAY_SIZE(operators)], level % 9 + 1);
+    }
+
+    ExpressionContext expression_context;
+    expression_context.emulator = &emulator;
+    token_list_create(&expression_context.tokens, TOKEN_LIST_CAPACITY);
+    tokenize(&expression_context.tokens, source, length);
+    TokenIterator iterator;
+    token_iterator_create(&iterator, &expression_context.tokens);
+    expression_context.expression = expression_compile(&emulator.program.expressions, &iterator);
+    expression_resolve(expression_context.expression, &emulator.program, EXPRESSION_NAME_NONE);
+    ExpressionName const name = expression_pool_intern(&emulator.program.expressions, "X", 1);
+    u32 const slot = program_variable_slot(&emulator.program, name);
+    emulator.program.variables[slot] = 1.5;
+    code_compile_expression(&emulator.arena, &emulator.program.expressions, expression_context.expression,
+                            &expression_context.chunk);
+
+    bench_run(bench, "micro/expression_compile/depth64", bench_expression_compile, &expression_context, 1);
+    bench_run(bench, "micro/expression_evaluate/depth64", bench_expression_evaluate, &expression_context, 1);
+    jit_enable(&emulator.program.jit, false);
+    bench_run(bench, "micro/vm_execute/depth64", bench_vm_execute, &expression_context, 1);
+    jit_enable(&emulator.program.jit, true);
+    bench_run(bench, "micro/jit_execute/depth64", bench_vm_execute, &expression_context, 1);
+    token_list_destroy(&expression_context.tokens);
+    emulator_destroy(&emulator);
+
+    // A long program in which every line jumps to the next one
+    emulator_create(&emulator, NULL);
+    b32 success = true;
+    for (u32 line = 1; success && line <= BENCH_PROGRAM_LINES; ++line) {
+        char text[64];
+        usize const text_length = (usize) snprintf(text, sizeof text, "%u GOTO %u", line * 10, line * 10 + 10);
+        tokenize(&emulator.tokens, text, text_length);
+        StatementResult const result = statement_compile(&emulator.arena, &emulator.program, &emulator.tokens);
+        success = result.type == RESULT_OK;
+        if (success) {
+            program_lines_insert(&emulator.program.lines, result.statement);
+        }
+    }
+    if (success) {
+        program_lines_link(&emulator.program.lines);
+        ProgramContext context = { &emulator };
+        bench_run(bench, "micro/program_link/5000", bench_program_link, &context, 1);
+    } else {
+        bench_skip(bench, "micro/program_link/5000", "program could not be compiled");
+    }
+    emulator_destroy(&emulator);
+}
+
+/// Runs the utility benchmarks
+static void bench_micro_util(Bench *bench) {
+    static u32 const sizes[] = { 16, 1024, 65536 };
+    u32 const maximum = sizes[STACK_ARRAY_SIZE(sizes) - 1];
+    char *keys = malloc((usize) maximum * BENCH_KEY_LENGTH);
+    for (u32 index = 0; index < maximum; ++index) {
+        snprintf(keys + (usize) index * BENCH_KEY_LENGTH, BENCH_KEY_LENGTH, "V%c%u", 'A' + index % 26, index);
+    }
+
+    for (usize size = 0; size < STACK_ARRAY_SIZE(sizes); ++size) {
+        InternContext context;
+        context.keys = keys;
+        context.count = sizes[size];
+        context.names = malloc(context.count * sizeof(InternName));
+        intern_table_create(&context.table);
+        program_symbols_create(&context.symbols);
+        u32 slots = 0;
+        for (u32 index = 0; index < context.count; ++index) {
+            char const *key = keys + (usize) index * BENCH_KEY_LENGTH;
+            context.names[index] = intern_table_intern(&context.table, key, strlen(key));
+            program_symbol(&context.symbols, context.names[index], &slots);
+        }
+
+        char name[BENCH_NAME_LENGTH];
+        snprintf(name, sizeof name, "micro/intern_table_insert/%u", context.count);
+        bench_run(bench, name, bench_intern_table_insert, &context, context.count);
+        snprintf(name, sizeof name, "micro/intern_table_find/%u", context.count);
+        bench_run(bench, name, bench_intern_table_find, &context, context.count);
+        snprintf(name, sizeof name, "micro/program_symbol/%u", context.count);
+        bench_run(bench, name, bench_program_symbol, &context, context.count);
+        program_symbols_destroy(&context.symbols);
+        intern_table_destroy(&context.table);
+        free(context.names);
+    }
+    free(keys);
+
+    bench_run(bench, "micro/arena_alloc/24", bench_arena_alloc, NULL, BENCH_ARENA_ALLOCATIONS);
+    bench_run(bench, "micro/arena_reset/24", bench_arena_reset, NULL, BENCH_ARENA_ALLOCATIONS);
+    bench_run(bench, "micro/pool_alloc/24", bench_pool_alloc, NULL, BENCH_ARENA_ALLOCATIONS);
+    bench_run(bench, "micro/text_queue_push/64", bench_text_queue_push, NULL, 1);
+}
+
+/// Runs the render group benchmarks, which require an OpenGL context and are skipped without one
+static void bench_micro_render(Bench *bench) {
+    glfwInit();
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    Display display;
+    if (!display_create(&display, "Benchmark", 800, 600)) {
+        bench_skip(bench, "micro/render_group_push/512", "no OpenGL context");
+        bench_skip(bench, "micro/render_group_submit/512", "no OpenGL context");
+        return;
+    }
+
+    Renderer renderer;
+    renderer_create(&renderer, "assets/pc21.ttf");
+    renderer_resize(&renderer, 800, 600);
+
+    RenderContext context;
+    context.renderer = &renderer;
+    for (u32 vertex = 0; vertex < QUAD_VERTICES; ++vertex) {
+        Vertex *it = context.vertices + vertex;
+        it->position = (F32Vector3) { (f32) (vertex & 1) * 8.0f, (f32) (vertex >> 1) * 8.0f, 0.0f };
+        it->color = (F32Vector3) { 1.0f, 0.6f, 0.0f };
+        it->texture = (F32Vector2) { (f32) (vertex & 1), (f32) (vertex >> 1) };
+    }
+    static u32 const indices[] = { 0, 1, 2, 2, 0, 3 };
+    memcpy(context.indices, indices, sizeof indices);
+
+    bench_run(bench, "micro/render_group_push/512", bench_render_group_push, &context, RENDER_GROUP_COMMANDS_MAX);
+    bench_run(bench, "micro/render_group_submit/512", bench_render_group_submit, &context, 1);
+
+    renderer_destroy(&renderer);
+    display_destroy(&display);
+}
+
+/// Runs a whole program in both execution modes, the virtual machine with and without native code
+static void bench_macro_program(Bench *bench, char const *name) {
+    char path[512];
+    snprintf(path, sizeof path, "%s/%s.bas", BENCH_PROGRAM_DIRECTORY, name);
+
+    static struct {
+        char const *name;
+        ProgramMode mode;
+        b32 jit;
+    } const modes[] = {
+        { "bytecode", PROGRAM_MODE_BYTECODE, false },
+        { "native", PROGRAM_MODE_BYTECODE, true },
+        { "reference", PROGRAM_MODE_REFERENCE, false },
+    };
+    for (usize mode = 0; mode < STACK_ARRAY_SIZE(modes); ++mode) {
+        char bench_name[BENCH_NAME_LENGTH];
+        snprintf(bench_name, sizeof bench_name, "macro/%s/%s", name, modes[mode].name);
+
+        Emulator emulator;
+        emulator_create(&emulator, NULL);
+        if (!bench_load_program(&emulator, path)) {
+            bench_skip(bench, bench_name, "program could not be loaded");
+            emulator_destroy(&emulator);
+            continue;
+        }
+
+        // Programs check their results and stop with an error if a result is wrong, which is reported here
+        emulator.program.mode = modes[mode].mode;
+        jit_enable(&emulator.program.jit, modes[mode].jit);
+        if (program_execute(&emulator.program)) {
+            ProgramContext context = { &emulator };
+            bench_run(bench, bench_name, bench_program_execute, &context, 1);
+        } else {
+            bench_skip(bench, bench_name, "program stopped with an error");
+        }
+        emulator_destroy(&emulator);
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc > 2) {
+        fprintf(stderr, "usage: %s [output.json]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    static Bench bench;
+    bench_micro_core(&bench);
+    bench_micro_util(&bench);
+    bench_micro_render(&bench);
+    bench_macro_program(&bench, "arithmetic");
+    bench_macro_program(&bench, "def_fn");
+    bench_macro_program(&bench, "arrays");
+    bench_macro_program(&bench, "loops");
+    bench_macro_program(&bench, "conditions");
+    bench_macro_program(&bench, "lines");
+    bench_macro_program(&bench, "integers");
+    bench_macro_program(&bench, "forward");
+    bench_macro_program(&bench, "mandelbrot");
+
+    FILE *file = argc == 2 ? fopen(argv[1], "w") : stdout;
+    if (file == NULL) {
+        fprintf(stderr, "could not open %s\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+    bench_write_json(&bench, file);
+    if (file != stdout) {
+        fclose(file);
+    }
+    return EXIT_SUCCESS;
+}
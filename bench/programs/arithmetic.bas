@@ -0,0 +1,104 @@
+10 A = 1.5
+20 B = 2.25
+30 C = 0.75
+40 S = 0
+100 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 0) - S / 7
+110 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 1) - S / 7
+120 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 2) - S / 7
+130 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 3) - S / 7
+140 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 4) - S / 7
+150 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 5) - S / 7
+160 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 6) - S / 7
+170 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 7) - S / 7
+180 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 8) - S / 7
+190 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 9) - S / 7
+200 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 10) - S / 7
+210 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 11) - S / 7
+220 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 12) - S / 7
+230 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 13) - S / 7
+240 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 14) - S / 7
+250 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 15) - S / 7
+260 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 16) - S / 7
+270 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 17) - S / 7
+280 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 18) - S / 7
+290 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 19) - S / 7
+300 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 20) - S / 7
+310 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 21) - S / 7
+320 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 22) - S / 7
+330 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 23) - S / 7
+340 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 24) - S / 7
+350 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 25) - S / 7
+360 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 26) - S / 7
+370 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 27) - S / 7
+380 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 28) - S / 7
+390 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 29) - S / 7
+400 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 30) - S / 7
+410 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 31) - S / 7
+420 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 32) - S / 7
+430 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 33) - S / 7
+440 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 34) - S / 7
+450 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 35) - S / 7
+460 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 36) - S / 7
+470 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 37) - S / 7
+480 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 38) - S / 7
+490 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 39) - S / 7
+500 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 40) - S / 7
+510 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 41) - S / 7
+520 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 42) - S / 7
+530 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 43) - S / 7
+540 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 44) - S / 7
+550 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 45) - S / 7
+560 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 46) - S / 7
+570 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 47) - S / 7
+580 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 48) - S / 7
+590 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 49) - S / 7
+600 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 50) - S / 7
+610 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 51) - S / 7
+620 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 52) - S / 7
+630 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 53) - S / 7
+640 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 54) - S / 7
+650 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 55) - S / 7
+660 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 56) - S / 7
+670 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 57) - S / 7
+680 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 58) - S / 7
+690 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 59) - S / 7
+700 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 60) - S / 7
+710 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 61) - S / 7
+720 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 62) - S / 7
+730 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 63) - S / 7
+740 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 64) - S / 7
+750 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 65) - S / 7
+760 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 66) - S / 7
+770 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 67) - S / 7
+780 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 68) - S / 7
+790 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 69) - S / 7
+800 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 70) - S / 7
+810 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 71) - S / 7
+820 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 72) - S / 7
+830 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 73) - S / 7
+840 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 74) - S / 7
+850 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 75) - S / 7
+860 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 76) - S / 7
+870 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 77) - S / 7
+880 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 78) - S / 7
+890 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 79) - S / 7
+900 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 80) - S / 7
+910 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 81) - S / 7
+920 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 82) - S / 7
+930 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 83) - S / 7
+940 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 84) - S / 7
+950 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 85) - S / 7
+960 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 86) - S / 7
+970 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 87) - S / 7
+980 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 88) - S / 7
+990 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 89) - S / 7
+1000 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 90) - S / 7
+1010 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 91) - S / 7
+1020 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 92) - S / 7
+1030 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 93) - S / 7
+1040 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 94) - S / 7
+1050 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 95) - S / 7
+1060 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 96) - S / 7
+1070 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 97) - S / 7
+1080 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 98) - S / 7
+1090 S = S + (A * B - C) ^ 2 / (1 + A ^ 3) + (B - C) * (A + 99) - S / 7
@@ -0,0 +1,104 @@
+10 DIM A(63), M(7,7)
+20 I = 3
+30 J = 5
+40 S = 0
+100 A(0) = A(63) * 0.5 + 0
+101 M(1,3) = M(3,1) + A(I + 1) * A(J)
+102 S = S + M(I, J) - A(2) / (1 + M(2,6))
+103 A(3) = A(2) * 0.5 + 3
+104 M(4,4) = M(4,4) + A(I + 4) * A(J)
+105 S = S + M(I, J) - A(5) / (1 + M(5,7))
+106 A(6) = A(5) * 0.5 + 6
+107 M(7,5) = M(5,7) + A(I + 7) * A(J)
+108 S = S + M(I, J) - A(8) / (1 + M(0,0))
+109 A(9) = A(8) * 0.5 + 9
+110 M(2,6) = M(6,2) + A(I + 10) * A(J)
+111 S = S + M(I, J) - A(11) / (1 + M(3,1))
+112 A(12) = A(11) * 0.5 + 12
+113 M(5,7) = M(7,5) + A(I + 13) * A(J)
+114 S = S + M(I, J) - A(14) / (1 + M(6,2))
+115 A(15) = A(14) * 0.5 + 15
+116 M(0,0) = M(0,0) + A(I + 16) * A(J)
+117 S = S + M(I, J) - A(17) / (1 + M(1,3))
+118 A(18) = A(17) * 0.5 + 18
+119 M(3,1) = M(1,3) + A(I + 19) * A(J)
+120 S = S + M(I, J) - A(20) / (1 + M(4,4))
+121 A(21) = A(20) * 0.5 + 21
+122 M(6,2) = M(2,6) + A(I + 22) * A(J)
+123 S = S + M(I, J) - A(23) / (1 + M(7,5))
+124 A(24) = A(23) * 0.5 + 24
+125 M(1,3) = M(3,1) + A(I + 25) * A(J)
+126 S = S + M(I, J) - A(26) / (1 + M(2,6))
+127 A(27) = A(26) * 0.5 + 27
+128 M(4,4) = M(4,4) + A(I + 28) * A(J)
+129 S = S + M(I, J) - A(29) / (1 + M(5,7))
+130 A(30) = A(29) * 0.5 + 30
+131 M(7,5) = M(5,7) + A(I + 31) * A(J)
+132 S = S + M(I, J) - A(32) / (1 + M(0,0))
+133 A(33) = A(32) * 0.5 + 33
+134 M(2,6) = M(6,2) + A(I + 34) * A(J)
+135 S = S + M(I, J) - A(35) / (1 + M(3,1))
+136 A(36) = A(35) * 0.5 + 36
+137 M(5,7) = M(7,5) + A(I + 37) * A(J)
+138 S = S + M(I, J) - A(38) / (1 + M(6,2))
+139 A(39) = A(38) * 0.5 + 39
+140 M(0,0) = M(0,0) + A(I + 40) * A(J)
+141 S = S + M(I, J) - A(41) / (1 + M(1,3))
+142 A(42) = A(41) * 0.5 + 42
+143 M(3,1) = M(1,3) + A(I + 43) * A(J)
+144 S = S + M(I, J) - A(44) / (1 + M(4,4))
+145 A(45) = A(44) * 0.5 + 45
+146 M(6,2) = M(2,6) + A(I + 46) * A(J)
+147 S = S + M(I, J) - A(47) / (1 + M(7,5))
+148 A(48) = A(47) * 0.5 + 48
+149 M(1,3) = M(3,1) + A(I + 49) * A(J)
+150 S = S + M(I, J) - A(50) / (1 + M(2,6))
+151 A(51) = A(50) * 0.5 + 51
+152 M(4,4) = M(4,4) + A(I + 52) * A(J)
+153 S = S + M(I, J) - A(53) / (1 + M(5,7))
+154 A(54) = A(53) * 0.5 + 54
+155 M(7,5) = M(5,7) + A(I + 55) * A(J)
+156 S = S + M(I, J) - A(56) / (1 + M(0,0))
+157 A(57) = A(56) * 0.5 + 57
+158 M(2,6) = M(6,2) + A(I + 58) * A(J)
+159 S = S + M(I, J) - A(59) / (1 + M(3,1))
+160 A(60) = A(59) * 0.5 + 60
+161 M(5,7) = M(7,5) + A(I + 1) * A(J)
+162 S = S + M(I, J) - A(62) / (1 + M(6,2))
+163 A(63) = A(62) * 0.5 + 63
+164 M(0,0) = M(0,0) + A(I + 0) * A(J)
+165 S = S + M(I, J) - A(1) / (1 + M(1,3))
+166 A(2) = A(1) * 0.5 + 66
+167 M(3,1) = M(1,3) + A(I + 3) * A(J)
+168 S = S + M(I, J) - A(4) / (1 + M(4,4))
+169 A(5) = A(4) * 0.5 + 69
+170 M(6,2) = M(2,6) + A(I + 6) * A(J)
+171 S = S + M(I, J) - A(7) / (1 + M(7,5))
+172 A(8) = A(7) * 0.5 + 72
+173 M(1,3) = M(3,1) + A(I + 9) * A(J)
+174 S = S + M(I, J) - A(10) / (1 + M(2,6))
+175 A(11) = A(10) * 0.5 + 75
+176 M(4,4) = M(4,4) + A(I + 12) * A(J)
+177 S = S + M(I, J) - A(13) / (1 + M(5,7))
+178 A(14) = A(13) * 0.5 + 78
+179 M(7,5) = M(5,7) + A(I + 15) * A(J)
+180 S = S + M(I, J) - A(16) / (1 + M(0,0))
+181 A(17) = A(16) * 0.5 + 81
+182 M(2,6) = M(6,2) + A(I + 18) * A(J)
+183 S = S + M(I, J) - A(19) / (1 + M(3,1))
+184 A(20) = A(19) * 0.5 + 84
+185 M(5,7) = M(7,5) + A(I + 21) * A(J)
+186 S = S + M(I, J) - A(22) / (1 + M(6,2))
+187 A(23) = A(22) * 0.5 + 87
+188 M(0,0) = M(0,0) + A(I + 24) * A(J)
+189 S = S + M(I, J) - A(25) / (1 + M(1,3))
+190 A(26) = A(25) * 0.5 + 90
+191 M(3,1) = M(1,3) + A(I + 27) * A(J)
+192 S = S + M(I, J) - A(28) / (1 + M(4,4))
+193 A(29) = A(28) * 0.5 + 93
+194 M(6,2) = M(2,6) + A(I + 30) * A(J)
+195 S = S + M(I, J) - A(31) / (1 + M(7,5))
+196 A(32) = A(31) * 0.5 + 96
+197 M(1,3) = M(3,1) + A(I + 33) * A(J)
+198 S = S + M(I, J) - A(34) / (1 + M(2,6))
+199 A(35) = A(34) * 0.5 + 99
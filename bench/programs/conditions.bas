@@ -0,0 +1,11 @@
+10 DIM V(255)
+20 FOR I = 0 TO 255
+30 V(I) = I * 37 - INT(I * 37 / 101) * 101
+40 NEXT I
+50 C = 0
+60 FOR R = 1 TO 8
+70 FOR I = 1 TO 255
+80 IF V(I) > V(I - 1) AND V(I) < 90 OR V(I) = 0 THEN C = C + 1
+90 IF NOT (V(I) >= 50) AND I <> 128 THEN C = C - 1
+100 NEXT I, R
+110 S = C
@@ -0,0 +1,104 @@
+10 DEF FN F(X) = X * X + 2 * X + 1
+20 DEF FN G(X) = F(X) / (1 + F(X - 1))
+30 DEF FN H(X) = SQR(G(X) + ABS(X)) - INT(X / 3)
+40 S = 1
+100 S = S + H(S / 1000 + 0) - G(0) * 0.5
+110 S = S + H(S / 1000 + 1) - G(1) * 0.5
+120 S = S + H(S / 1000 + 2) - G(2) * 0.5
+130 S = S + H(S / 1000 + 3) - G(3) * 0.5
+140 S = S + H(S / 1000 + 4) - G(4) * 0.5
+150 S = S + H(S / 1000 + 5) - G(5) * 0.5
+160 S = S + H(S / 1000 + 6) - G(6) * 0.5
+170 S = S + H(S / 1000 + 7) - G(0) * 0.5
+180 S = S + H(S / 1000 + 8) - G(1) * 0.5
+190 S = S + H(S / 1000 + 9) - G(2) * 0.5
+200 S = S + H(S / 1000 + 10) - G(3) * 0.5
+210 S = S + H(S / 1000 + 11) - G(4) * 0.5
+220 S = S + H(S / 1000 + 12) - G(5) * 0.5
+230 S = S + H(S / 1000 + 13) - G(6) * 0.5
+240 S = S + H(S / 1000 + 14) - G(0) * 0.5
+250 S = S + H(S / 1000 + 15) - G(1) * 0.5
+260 S = S + H(S / 1000 + 16) - G(2) * 0.5
+270 S = S + H(S / 1000 + 17) - G(3) * 0.5
+280 S = S + H(S / 1000 + 18) - G(4) * 0.5
+290 S = S + H(S / 1000 + 19) - G(5) * 0.5
+300 S = S + H(S / 1000 + 20) - G(6) * 0.5
+310 S = S + H(S / 1000 + 21) - G(0) * 0.5
+320 S = S + H(S / 1000 + 22) - G(1) * 0.5
+330 S = S + H(S / 1000 + 23) - G(2) * 0.5
+340 S = S + H(S / 1000 + 24) - G(3) * 0.5
+350 S = S + H(S / 1000 + 25) - G(4) * 0.5
+360 S = S + H(S / 1000 + 26) - G(5) * 0.5
+370 S = S + H(S / 1000 + 27) - G(6) * 0.5
+380 S = S + H(S / 1000 + 28) - G(0) * 0.5
+390 S = S + H(S / 1000 + 29) - G(1) * 0.5
+400 S = S + H(S / 1000 + 30) - G(2) * 0.5
+410 S = S + H(S / 1000 + 31) - G(3) * 0.5
+420 S = S + H(S / 1000 + 32) - G(4) * 0.5
+430 S = S + H(S / 1000 + 33) - G(5) * 0.5
+440 S = S + H(S / 1000 + 34) - G(6) * 0.5
+450 S = S + H(S / 1000 + 35) - G(0) * 0.5
+460 S = S + H(S / 1000 + 36) - G(1) * 0.5
+470 S = S + H(S / 1000 + 37) - G(2) * 0.5
+480 S = S + H(S / 1000 + 38) - G(3) * 0.5
+490 S = S + H(S / 1000 + 39) - G(4) * 0.5
+500 S = S + H(S / 1000 + 40) - G(5) * 0.5
+510 S = S + H(S / 1000 + 41) - G(6) * 0.5
+520 S = S + H(S / 1000 + 42) - G(0) * 0.5
+530 S = S + H(S / 1000 + 43) - G(1) * 0.5
+540 S = S + H(S / 1000 + 44) - G(2) * 0.5
+550 S = S + H(S / 1000 + 45) - G(3) * 0.5
+560 S = S + H(S / 1000 + 46) - G(4) * 0.5
+570 S = S + H(S / 1000 + 47) - G(5) * 0.5
+580 S = S + H(S / 1000 + 48) - G(6) * 0.5
+590 S = S + H(S / 1000 + 49) - G(0) * 0.5
+600 S = S + H(S / 1000 + 50) - G(1) * 0.5
+610 S = S + H(S / 1000 + 51) - G(2) * 0.5
+620 S = S + H(S / 1000 + 52) - G(3) * 0.5
+630 S = S + H(S / 1000 + 53) - G(4) * 0.5
+640 S = S + H(S / 1000 + 54) - G(5) * 0.5
+650 S = S + H(S / 1000 + 55) - G(6) * 0.5
+660 S = S + H(S / 1000 + 56) - G(0) * 0.5
+670 S = S + H(S / 1000 + 57) - G(1) * 0.5
+680 S = S + H(S / 1000 + 58) - G(2) * 0.5
+690 S = S + H(S / 1000 + 59) - G(3) * 0.5
+700 S = S + H(S / 1000 + 60) - G(4) * 0.5
+710 S = S + H(S / 1000 + 61) - G(5) * 0.5
+720 S = S + H(S / 1000 + 62) - G(6) * 0.5
+730 S = S + H(S / 1000 + 63) - G(0) * 0.5
+740 S = S + H(S / 1000 + 64) - G(1) * 0.5
+750 S = S + H(S / 1000 + 65) - G(2) * 0.5
+760 S = S + H(S / 1000 + 66) - G(3) * 0.5
+770 S = S + H(S / 1000 + 67) - G(4) * 0.5
+780 S = S + H(S / 1000 + 68) - G(5) * 0.5
+790 S = S + H(S / 1000 + 69) - G(6) * 0.5
+800 S = S + H(S / 1000 + 70) - G(0) * 0.5
+810 S = S + H(S / 1000 + 71) - G(1) * 0.5
+820 S = S + H(S / 1000 + 72) - G(2) * 0.5
+830 S = S + H(S / 1000 + 73) - G(3) * 0.5
+840 S = S + H(S / 1000 + 74) - G(4) * 0.5
+850 S = S + H(S / 1000 + 75) - G(5) * 0.5
+860 S = S + H(S / 1000 + 76) - G(6) * 0.5
+870 S = S + H(S / 1000 + 77) - G(0) * 0.5
+880 S = S + H(S / 1000 + 78) - G(1) * 0.5
+890 S = S + H(S / 1000 + 79) - G(2) * 0.5
+900 S = S + H(S / 1000 + 80) - G(3) * 0.5
+910 S = S + H(S / 1000 + 81) - G(4) * 0.5
+920 S = S + H(S / 1000 + 82) - G(5) * 0.5
+930 S = S + H(S / 1000 + 83) - G(6) * 0.5
+940 S = S + H(S / 1000 + 84) - G(0) * 0.5
+950 S = S + H(S / 1000 + 85) - G(1) * 0.5
+960 S = S + H(S / 1000 + 86) - G(2) * 0.5
+970 S = S + H(S / 1000 + 87) - G(3) * 0.5
+980 S = S + H(S / 1000 + 88) - G(4) * 0.5
+990 S = S + H(S / 1000 + 89) - G(5) * 0.5
+1000 S = S + H(S / 1000 + 90) - G(6) * 0.5
+1010 S = S + H(S / 1000 + 91) - G(0) * 0.5
+1020 S = S + H(S / 1000 + 92) - G(1) * 0.5
+1030 S = S + H(S / 1000 + 93) - G(2) * 0.5
+1040 S = S + H(S / 1000 + 94) - G(3) * 0.5
+1050 S = S + H(S / 1000 + 95) - G(4) * 0.5
+1060 S = S + H(S / 1000 + 96) - G(5) * 0.5
+1070 S = S + H(S / 1000 + 97) - G(6) * 0.5
+1080 S = S + H(S / 1000 + 98) - G(0) * 0.5
+1090 S = S + H(S / 1000 + 99) - G(1) * 0.5
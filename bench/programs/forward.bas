@@ -0,0 +1,13 @@
+10 GOTO 200
+100 FOR R = 1 TO 50
+110 FOR I = 1 TO 100
+120 S = S + B(I) - F(I) + C(I - INT(I / 10) * 10)
+130 C(I - INT(I / 10) * 10) = 1
+140 NEXT I, R
+150 IF S <> 131240 THEN B(101) = S
+160 GOTO 300
+200 DIM B(100)
+210 DEF FN F(X) = X / 2
+220 FOR I = 0 TO 100: B(I) = I: NEXT I
+230 GOTO 100
+300 S = 0
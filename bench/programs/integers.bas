@@ -0,0 +1,6 @@
+10 DIM H%(255)
+20 S% = 0: C% = 0
+30 FOR I = 1 TO 5000
+40 K% = C% * 5 + 3: C% = K% - ((K% > 255) + (K% > 511) + (K% > 767) + (K% > 1023)) * 256
+50 H%(C%) = H%(C%) + 1: S% = S% + H%(C%) - (S% > 10000) * 10000
+60 NEXT I
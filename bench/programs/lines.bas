@@ -0,0 +1,4 @@
+10 DIM F(2000)
+20 FOR R = 1 TO 20: FOR I = 2 TO 2000: F(I) = 0: NEXT I
+30 FOR I = 2 TO 44: IF F(I) = 0 THEN FOR J = I * I TO 2000 STEP I: F(J) = 1: NEXT J
+40 NEXT I: C = 0: FOR I = 2 TO 2000: C = C + 1 - F(I): NEXT I, R
@@ -0,0 +1,18 @@
+10 DIM F(2000)
+20 FOR R = 1 TO 20
+30 FOR I = 2 TO 2000
+40 F(I) = 0
+50 NEXT I
+60 FOR I = 2 TO 44
+70 ON F(I) + 1 GOSUB 200
+80 NEXT I
+90 C = 0
+100 FOR I = 2 TO 2000
+110 C = C + 1 - F(I)
+120 NEXT I, R
+130 GOTO 300
+200 FOR J = I * I TO 2000 STEP I
+210 F(J) = 1
+220 NEXT J
+230 RETURN
+300 S = C
@@ -0,0 +1,13 @@
+10 DIM B(100)
+20 N = 0
+30 FOR J = 0 TO 15
+40 Q = J / 8 - 1
+50 FOR I = 0 TO 31
+60 P = I / 12 - 2
+70 X = 0: Y = 0
+80 FOR K = 1 TO 30
+90 T = X * X - Y * Y + P: Y = 2 * X * Y + Q: X = T
+100 N = N + 1
+110 IF X * X + Y * Y > 4 THEN K = 30
+120 NEXT K, I, J
+130 IF N <> 6784 THEN B(101) = N
@@ -3,6 +3,7 @@
 #ifndef RETRO_ARCH_H
 #define RETRO_ARCH_H
 
+#include "memory.h"
 #include "thread.h"
 #include "time.h"
 
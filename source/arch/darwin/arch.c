@@ -2,6 +2,8 @@
 
 #include <unistd.h>
 #include <pthread.h>
+#include <sys/mman.h>
 
+#include "darwin_memory.c"
 #include "darwin_thread.c"
 #include "darwin_time.c"
@@ -1,8 +1,10 @@
 // Copyright (c) 2025 Elias Engelbert Plank
 
 #include <pthread.h>
+#include <sys/mman.h>
 #include <stdlib.h>
 #include <unistd.h>
 
+#include "linux_memory.c"
 #include "linux_thread.c"
 #include "linux_time.c"
@@ -0,0 +1,34 @@
+// Copyright (c) 2025 Elias Engelbert Plank
+
+/// Retrieves the size of a page of virtual memory
+static usize memory_page_size(void) {
+    return (usize) sysconf(_SC_PAGESIZE);
+}
+
+/// Maps readable and writable pages of virtual memory
+static void *memory_map(usize const size) {
+    void *memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return memory == MAP_FAILED ? NULL : memory;
+}
+
+/// Reserves pages of virtual memory without committing them
+static void *memory_reserve(usize const size) {
+    void *memory = mmap(NULL, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    return memory == MAP_FAILED ? NULL : memory;
+}
+
+/// Commits reserved pages
+static b32 memory_commit(void *memory, usize const size) {
+    return mprotect(memory, size, PROT_READ | PROT_WRITE) == 0;
+}
+
+/// Changes the protection of mapped pages
+static b32 memory_protect(void *memory, usize const size, MemoryProtection const protection) {
+    int const flags = protection == MEMORY_PROTECTION_READ_EXECUTE ? PROT_READ | PROT_EXEC : PROT_READ | PROT_WRITE;
+    return mprotect(memory, size, flags) == 0;
+}
+
+/// Unmaps pages that were mapped with memory_map or reserved with memory_reserve
+static void memory_unmap(void *memory, usize const size) {
+    munmap(memory, size);
+}
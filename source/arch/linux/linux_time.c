@@ -4,3 +4,10 @@
 static void time_sleep(u32 milliseconds) {
     usleep(milliseconds * 1000);
 }
+
+/// Retrieves the current value of a monotonic clock
+static u64 time_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (u64) now.tv_sec * 1000000000ull + (u64) now.tv_nsec;
+}
@@ -0,0 +1,46 @@
+// Copyright (c) 2025 Elias Engelbert Plank
+
+#ifndef RETRO_ARCH_MEMORY_H
+#define RETRO_ARCH_MEMORY_H
+
+typedef enum MemoryProtection {
+    /// The memory can be read and written, but not executed
+    MEMORY_PROTECTION_READ_WRITE,
+
+    /// The memory can be read and executed, but not written
+    MEMORY_PROTECTION_READ_EXECUTE
+} MemoryProtection;
+
+/// Retrieves the size of a page of virtual memory
+/// @return The page size in bytes
+static usize memory_page_size(void);
+
+/// Maps readable and writable pages of virtual memory, which are zero initialized
+/// @param size The size in bytes, which must be a multiple of the page size
+/// @return The mapped memory or NULL if the memory could not be mapped
+static void *memory_map(usize size);
+
+/// Reserves pages of virtual memory without committing them, the pages must be committed before they are used
+/// @param size The size in bytes, which must be a multiple of the page size
+/// @return The reserved memory or NULL if the memory could not be reserved
+static void *memory_reserve(usize size);
+
+/// Commits reserved pages, which are then readable, writable and zero initialized
+/// @param memory The first page, which must be page aligned
+/// @param size The size in bytes
+/// @return A boolean value that indicates whether the pages could be committed
+static b32 memory_commit(void *memory, usize size);
+
+/// Changes the protection of mapped pages
+/// @param memory The first page, which must be page aligned
+/// @param size The size in bytes
+/// @param protection The new protection of the pages
+/// @return A boolean value that indicates whether the protection could be changed
+static b32 memory_protect(void *memory, usize size, MemoryProtection protection);
+
+/// Unmaps pages that were mapped with memory_map or reserved with memory_reserve
+/// @param memory The mapped memory
+/// @param size The size in bytes that was mapped
+static void memory_unmap(void *memory, usize size);
+
+#endif// RETRO_ARCH_MEMORY_H
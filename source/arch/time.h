@@ -7,4 +7,9 @@
 /// @param milliseconds The time in milliseconds
 static void time_sleep(u32 milliseconds);
 
+/// Retrieves the current value of a monotonic clock, which is only meaningful
+/// when compared to other values of the clock
+/// @return The time in nanoseconds
+static u64 time_now(void);
+
 #endif// RETRO_ARCH_TIME_H
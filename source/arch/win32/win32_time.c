@@ -4,3 +4,16 @@
 void time_sleep(u32 milliseconds) {
     Sleep(milliseconds);
 }
+
+/// Retrieves the current value of a monotonic clock
+static u64 time_now(void) {
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+
+    // Split the conversion so that the counter cannot overflow when it is scaled to nanoseconds
+    u64 const seconds = (u64) counter.QuadPart / (u64) frequency.QuadPart;
+    u64 const remainder = (u64) counter.QuadPart % (u64) frequency.QuadPart;
+    return seconds * 1000000000ull + remainder * 1000000000ull / (u64) frequency.QuadPart;
+}
@@ -3,6 +3,7 @@
 #include <assert.h>
 #include <ctype.h>
 #include <stdarg.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -19,11 +20,33 @@
 // TODO(elias):
 // [ ] get rid of malloc everywhere except for arena
 // [ ] separate parsing and interpreting/executing
-// [ ] add proper symbol resolving during execution
-// [ ] revisit prog.c - replace binary tree with heap
-// [ ] clean up arena implementation
+// [x] add proper symbol resolving during execution
+// [x] revisit prog.c - replace binary tree with heap
+// [x] clean up arena implementation
+
+/// Runs the specified program without creating a window, the output is written to stdout and errors
+/// are written to stderr. The run fails if the program does not compile or stops with an error.
+static int basic_run_headless(char const *path, b32 const jit) {
+    Emulator emulator;
+    emulator_create(&emulator, NULL);
+    jit_enable(&emulator.program.jit, jit);
+    b32 const success = emulator_run_file(&emulator, path);
+    emulator_destroy(&emulator);
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int main(int argc, char **argv) {
+    if (argc == 3 && strcmp(argv[1], "--run") == 0) {
+        return basic_run_headless(argv[2], true);
+    }
+    if (argc == 4 && strcmp(argv[1], "--run") == 0 && strcmp(argv[2], "--no-jit") == 0) {
+        return basic_run_headless(argv[3], false);
+    }
+    if (argc != 1) {
+        fprintf(stderr, "usage: %s [--run [--no-jit] <file.bas>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
 
-int main() {
     Display display;
     display_create(&display, "Emulator", 800, 600);
 
@@ -0,0 +1,67 @@
+// Copyright (c) 2025 Elias Engelbert Plank
+
+/// Reads a soft switch. The keyboard latch is mirrored across its 16 addresses, accessing the
+/// keyboard strobe clears the pending bit of the latch.
+static u8 address_soft_switch_read(AddressSpace *self, u16 const address) {
+    if (address < ADDRESS_KEYBOARD + 0x10) {
+        return self->keyboard;
+    }
+    if (address < ADDRESS_KEYBOARD_STROBE + 0x10) {
+        u8 const keyboard = self->keyboard;
+        self->keyboard &= (u8) ~ADDRESS_KEYBOARD_PENDING;
+        return keyboard;
+    }
+    return 0;
+}
+
+/// Writes a soft switch, only the keyboard strobe reacts to writes
+static void address_soft_switch_write(AddressSpace *self, u16 const address, u8 const value) {
+    (void) value;
+    if (address >= ADDRESS_KEYBOARD_STROBE && address < ADDRESS_KEYBOARD_STROBE + 0x10) {
+        self->keyboard &= (u8) ~ADDRESS_KEYBOARD_PENDING;
+    }
+}
+
+/// Creates the address space, all memory is zero and the devices are mapped into their pages
+static void address_space_create(AddressSpace *self) {
+    static AddressDevice const soft_switches = { .read = address_soft_switch_read,
+                                                 .write = address_soft_switch_write };
+
+    memset(self->memory, 0, sizeof self->memory);
+    address_space_map(self, 0, ADDRESS_SPACE_SIZE, NULL);
+    address_space_map(self, ADDRESS_SOFT_SWITCHES, ADDRESS_PAGE_SIZE, &soft_switches);
+    self->keyboard = 0;
+}
+
+/// Maps the device into the pages that span the specified range
+static void address_space_map(AddressSpace *self, u16 const address, u32 const size, AddressDevice const *device) {
+    u32 const first = address >> ADDRESS_PAGE_SHIFT;
+    u32 const count = (size + ADDRESS_PAGE_SIZE - 1) >> ADDRESS_PAGE_SHIFT;
+    for (u32 page = first; page < first + count && page < ADDRESS_PAGE_COUNT; ++page) {
+        self->pages[page] = device;
+    }
+}
+
+/// Reads the byte at the specified address
+static u8 address_space_read(AddressSpace *self, u16 const address) {
+    AddressDevice const *device = self->pages[address >> ADDRESS_PAGE_SHIFT];
+    if (device == NULL || device->read == NULL) {
+        return self->memory[address];
+    }
+    return device->read(self, address);
+}
+
+/// Writes the byte to the specified address
+static void address_space_write(AddressSpace *self, u16 const address, u8 const value) {
+    AddressDevice const *device = self->pages[address >> ADDRESS_PAGE_SHIFT];
+    if (device == NULL || device->write == NULL) {
+        self->memory[address] = value;
+        return;
+    }
+    device->write(self, address, value);
+}
+
+/// Latches the key, so that it can be read from the keyboard soft switch
+static void address_space_key(AddressSpace *self, u8 const code) {
+    self->keyboard = (u8) (code | ADDRESS_KEYBOARD_PENDING);
+}
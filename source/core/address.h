@@ -0,0 +1,78 @@
+// Copyright (c) 2025 Elias Engelbert Plank
+
+#ifndef RETRO_ADDRESS_H
+#define RETRO_ADDRESS_H
+
+enum {
+    ADDRESS_SPACE_SIZE = 0x10000,
+    ADDRESS_PAGE_SHIFT = 8,
+    ADDRESS_PAGE_SIZE = 1 << ADDRESS_PAGE_SHIFT,
+    ADDRESS_PAGE_COUNT = ADDRESS_SPACE_SIZE / ADDRESS_PAGE_SIZE
+};
+
+enum {
+    /// The soft switches, reading the keyboard latch yields the last key with bit 7 set until
+    /// the keyboard strobe is accessed, which clears bit 7
+    ADDRESS_SOFT_SWITCHES = 0xC000,
+    ADDRESS_KEYBOARD = 0xC000,
+    ADDRESS_KEYBOARD_STROBE = 0xC010,
+
+    /// Bit 7 of the keyboard latch, which is set while a key is pending
+    ADDRESS_KEYBOARD_PENDING = 0x80
+};
+
+/// Forward declare address space
+typedef struct AddressSpace AddressSpace;
+
+typedef u8 (*AddressRead)(AddressSpace *, u16);
+typedef void (*AddressWrite)(AddressSpace *, u16, u8);
+
+/// A device that is mapped into one or more pages of the address space. Reads of a device
+/// without a read function go to the memory of the page.
+typedef struct AddressDevice {
+    AddressRead read;
+    AddressWrite write;
+} AddressDevice;
+
+/// The 64 Kb address space of the machine. Every page of 256 bytes is either plain memory or
+/// belongs to a device, which is dispatched through the page table. Accessing plain memory is
+/// a single load or store, only the pages of devices call a function.
+typedef struct AddressSpace {
+    u8 memory[ADDRESS_SPACE_SIZE];
+
+    /// The device of every page, pages without a device are plain memory
+    AddressDevice const *pages[ADDRESS_PAGE_COUNT];
+
+    /// The keyboard latch, which holds the code of the last key
+    u8 keyboard;
+} AddressSpace;
+
+/// Creates the address space, all memory is zero and the devices are mapped into their pages
+/// @param self The address space
+static void address_space_create(AddressSpace *self);
+
+/// Maps the device into the pages that span the specified range
+/// @param self The address space
+/// @param address The first address of the range, which must be the start of a page
+/// @param size The size of the range in bytes
+/// @param device The device, or NULL to map plain memory
+static void address_space_map(AddressSpace *self, u16 address, u32 size, AddressDevice const *device);
+
+/// Reads the byte at the specified address
+/// @param self The address space
+/// @param address The address
+/// @return The byte
+static u8 address_space_read(AddressSpace *self, u16 address);
+
+/// Writes the byte to the specified address
+/// @param self The address space
+/// @param address The address
+/// @param value The byte
+static void address_space_write(AddressSpace *self, u16 address, u8 value);
+
+/// Latches the key, so that it can be read from the keyboard soft switch
+/// @param self The address space
+/// @param code The ASCII code of the key
+static void address_space_key(AddressSpace *self, u8 code);
+
+#endif// RETRO_ADDRESS_H
@@ -0,0 +1,64 @@
+// Copyright (c) 2025 Elias Engelbert Plank
+
+/// Creates an empty expression pool
+static void expression_pool_create(ExpressionPool *self) {
+    self->node_capacity = EXPRESSION_POOL_CAPACITY;
+    self->nodes = malloc(self->node_capacity * sizeof(Expression));
+    self->argument_count = 0;
+    self->argument_capacity = EXPRESSION_POOL_CAPACITY;
+    self->arguments = malloc(self->argument_capacity * sizeof(ExpressionIndex));
+    intern_table_create(&self->names);
+    self->text = arena_identity(ALIGNMENT8);
+
+    // The first node is reserved, so that its index can stand for none
+    memset(self->nodes, 0, sizeof(Expression));
+    self->node_count = 1;
+}
+
+/// Destroys the expression pool and all its nodes
+static void expression_pool_destroy(ExpressionPool *self) {
+    free(self->nodes);
+    free(self->arguments);
+    intern_table_destroy(&self->names);
+    arena_destroy(&self->text);
+    self->nodes = NULL;
+    self->arguments = NULL;
+}
+
+/// Doubles the capacity of a pool array once it is full
+static void *expression_pool_reserve(void *data, u32 const count, u32 *capacity, usize const size) {
+    if (count < *capacity) {
+        return data;
+    }
+    *capacity *= 2;
+    return realloc(data, *capacity * size);
+}
+
+/// Creates a node of the specified type at the end of the pool
+static ExpressionIndex expression_pool_push(ExpressionPool *self, ExpressionType const type) {
+    self->nodes = expression_pool_reserve(self->nodes, self->node_count, &self->node_capacity, sizeof(Expression));
+    Expression *node = self->nodes + self->node_count;
+    memset(node, 0, sizeof(Expression));
+    node->type = type;
+    return self->node_count++;
+}
+
+/// Retrieves the node at the specified index
+static Expression *expression_pool_get(ExpressionPool const *self, ExpressionIndex const index) {
+    return self->nodes + index;
+}
+
+/// Interns the name, so that equal names have the same identifier
+static ExpressionName expression_pool_intern(ExpressionPool *self, char const *name, usize const length) {
+    return intern_table_intern(&self->names, name, length);
+}
+
+/// Retrieves the interned name with the specified identifier
+static char const *expression_pool_name(ExpressionPool const *self, ExpressionName const name) {
+    return intern_table_entry(&self->names, name)->string;
+}
+
+/// Retrieves the length of the interned name with the specified identifier
+static usize expression_pool_name_length(ExpressionPool const *self, ExpressionName const name) {
+    return intern_table_entry(&self->names, name)->length;
+}
@@ -0,0 +1,84 @@
+// Copyright (c) 2025 Elias Engelbert Plank
+
+#ifndef RETRO_AST_H
+#define RETRO_AST_H
+
+/// Forward declares
+typedef struct Expression Expression;
+
+enum {
+    /// The initial capacity of the nodes and arguments of an expression pool
+    EXPRESSION_POOL_CAPACITY = 256
+};
+
+/// The index of an expression node in the expression pool of its program. Nodes refer to their
+/// children by index, so that a 32 bit index replaces a pointer and all nodes share one allocation.
+typedef u32 ExpressionIndex;
+
+/// The identifier of an interned name in the expression pool
+typedef InternName ExpressionName;
+
+enum {
+    /// The index of no expression, which is never assigned to a node
+    EXPRESSION_NONE = 0,
+
+    /// The identifier of no name, which is never assigned to a name
+    EXPRESSION_NAME_NONE = INTERN_NAME_NONE
+};
+
+/// The nodes of all expressions of a program, which are stored next to each other in a single
+/// array. Index zero is reserved for EXPRESSION_NONE. Names are interned, every name is stored once
+/// and nodes with the same name refer to the same name identifier, which the program also uses to
+/// look up the slots of its variables, arrays and functions.
+typedef struct ExpressionPool {
+    Expression *nodes;
+    u32 node_count;
+    u32 node_capacity;
+
+    /// The arguments of all function calls and the indices of all elements
+    ExpressionIndex *arguments;
+    u32 argument_count;
+    u32 argument_capacity;
+
+    /// The interned names of all variables, arrays and functions
+    InternTable names;
+
+    /// The characters of the string literals
+    MemoryArena text;
+} ExpressionPool;
+
+/// Creates an empty expression pool
+/// @param self The expression pool
+static void expression_pool_create(ExpressionPool *self);
+
+/// Destroys the expression pool and all its nodes
+/// @param self The expression pool
+static void expression_pool_destroy(ExpressionPool *self);
+
+/// Retrieves the node at the specified index. Nodes move when the pool grows, so the node
+/// must not be used after another node has been created.
+/// @param self The expression pool
+/// @param index The index of the node
+/// @return The node
+static Expression *expression_pool_get(ExpressionPool const *self, ExpressionIndex index);
+
+/// Interns the name, so that equal names have the same identifier
+/// @param self The expression pool
+/// @param name The name, which does not need to be terminated
+/// @param length The length of the name
+/// @return The identifier of the name
+static ExpressionName expression_pool_intern(ExpressionPool *self, char const *name, usize length);
+
+/// Retrieves the interned name with the specified identifier
+/// @param self The expression pool
+/// @param name The identifier of the name
+/// @return The terminated name
+static char const *expression_pool_name(ExpressionPool const *self, ExpressionName name);
+
+/// Retrieves the length of the interned name with the specified identifier
+/// @param self The expression pool
+/// @param name The identifier of the name
+/// @return The length of the name
+static usize expression_pool_name_length(ExpressionPool const *self, ExpressionName name);
+
+#endif// RETRO_AST_H
@@ -0,0 +1,613 @@
+// Copyright (c) 2025 Elias Engelbert Plank
+
+/// Creates an empty chunk builder
+static void chunk_builder_create(ChunkBuilder *self, ExpressionPool const *pool) {
+    self->pool = pool;
+    self->length = 0;
+    self->number_count = 0;
+    self->object_count = 0;
+    self->registers = 0;
+    self->error = NULL;
+}
+
+/// Emits an instruction
+static b32 chunk_builder_emit(ChunkBuilder *self, Opcode const opcode, u32 const a, u32 const b, u32 const c) {
+    if (self->length == CHUNK_CODE_CAPACITY) {
+        self->error = "Statement is too long";
+        return false;
+    }
+    Instruction *instruction = self->code + self->length++;
+    instruction->opcode = (u8) opcode;
+    instruction->a = (u8) a;
+    instruction->b = (u16) b;
+    instruction->c = c;
+    return true;
+}
+
+/// Points the branch that was emitted at the specified index to the next instruction that is emitted
+static void chunk_builder_patch(ChunkBuilder *self, u32 const branch) {
+    self->code[branch].c = self->length;
+}
+
+/// Adds a number to the constant pool, equal numbers share one entry
+static b32 chunk_builder_number(ChunkBuilder *self, f64 const number, u32 *index) {
+    for (u32 it = 0; it < self->number_count; ++it) {
+        if (memcmp(self->numbers + it, &number, sizeof number) == 0) {
+            *index = it;
+            return true;
+        }
+    }
+    if (self->number_count == CHUNK_NUMBER_CAPACITY) {
+        self->error = "Statement has too many constants";
+        return false;
+    }
+    *index = self->number_count;
+    self->numbers[self->number_count++] = number;
+    return true;
+}
+
+/// Adds an object to the object pool, equal objects share one entry
+static b32 chunk_builder_object(ChunkBuilder *self, void const *object, u32 *index) {
+    for (u32 it = 0; it < self->object_count; ++it) {
+        if (self->objects[it] == object) {
+            *index = it;
+            return true;
+        }
+    }
+    if (self->object_count == CHUNK_OBJECT_CAPACITY) {
+        self->error = "Statement has too many objects";
+        return false;
+    }
+    *index = self->object_count;
+    self->objects[self->object_count++] = object;
+    return true;
+}
+
+/// Reserves the specified register, so that it is accounted for in the register count
+static b32 chunk_builder_register(ChunkBuilder *self, u32 const index) {
+    if (index >= CHUNK_REGISTER_COUNT) {
+        self->error = "Expression is too complex";
+        return false;
+    }
+    if (index + 1 > self->registers) {
+        self->registers = index + 1;
+    }
+    return true;
+}
+
+/// Copies the emitted code and constants into the arena
+static void chunk_builder_finish(ChunkBuilder const *self, MemoryArena *arena, Chunk *chunk) {
+    chunk->length = self->length;
+    chunk->code = arena_alloc(arena, self->length * sizeof(Instruction));
+    memcpy(chunk->code, self->code, self->length * sizeof(Instruction));
+
+    chunk->number_count = self->number_count;
+    chunk->numbers = arena_alloc(arena, self->number_count * sizeof(f64));
+    memcpy(chunk->numbers, self->numbers, self->number_count * sizeof(f64));
+
+    chunk->object_count = self->object_count;
+    chunk->objects = arena_alloc(arena, self->object_count * sizeof(void *));
+    memcpy(chunk->objects, self->objects, self->object_count * sizeof(void *));
+
+    chunk->registers = self->registers;
+
+    chunk->native = arena_alloc(arena, sizeof(JitCode));
+    chunk->native->executions = 0;
+    chunk->native->interpreted = false;
+    chunk->native->offsets = NULL;
+    chunk->native->generation = 0;
+}
+
+/// Maps an arithmetic or relational operator to its opcode
+static Opcode code_operator_opcode(Operator const operator) {
+    switch (operator) {
+        case OPERATOR_ADD:
+            return OPCODE_ADD;
+        case OPERATOR_SUB:
+            return OPCODE_SUB;
+        case OPERATOR_MUL:
+            return OPCODE_MUL;
+        case OPERATOR_EQUAL:
+            return OPCODE_EQUAL;
+        case OPERATOR_NOT_EQUAL:
+            return OPCODE_NOT_EQUAL;
+        case OPERATOR_LESS:
+            return OPCODE_LESS;
+        case OPERATOR_LESS_EQUAL:
+            return OPCODE_LESS_EQUAL;
+        case OPERATOR_GREATER:
+            return OPCODE_GREATER;
+        case OPERATOR_GREATER_EQUAL:
+            return OPCODE_GREATER_EQUAL;
+        case OPERATOR_DIV:
+        default:
+            return OPCODE_DIV;
+    }
+}
+
+/// Maps an arithmetic or relational operator to the opcode that works on the integer parts of registers
+static Opcode code_operator_integer_opcode(Operator const operator) {
+    switch (operator) {
+        case OPERATOR_ADD:
+            return OPCODE_INTEGER_ADD;
+        case OPERATOR_SUB:
+            return OPCODE_INTEGER_SUB;
+        case OPERATOR_MUL:
+            return OPCODE_INTEGER_MUL;
+        case OPERATOR_EQUAL:
+            return OPCODE_INTEGER_EQUAL;
+        case OPERATOR_NOT_EQUAL:
+            return OPCODE_INTEGER_NOT_EQUAL;
+        case OPERATOR_LESS:
+            return OPCODE_INTEGER_LESS;
+        case OPERATOR_LESS_EQUAL:
+            return OPCODE_INTEGER_LESS_EQUAL;
+        case OPERATOR_GREATER:
+            return OPCODE_INTEGER_GREATER;
+        case OPERATOR_GREATER_EQUAL:
+        default:
+            return OPCODE_INTEGER_GREATER_EQUAL;
+    }
+}
+
+enum {
+    /// The bound of a value that is held by the number part of its register
+    CODE_BOUND_REAL = -1,
+
+    /// The largest magnitude of a value in the integer part of a register
+    CODE_INTEGER_MAX = INT32_MAX
+};
+
+/// An operand of a binary expression. Integral constants are only loaded once it is known
+/// whether the operation is carried out on integers or on real numbers.
+typedef struct CodeOperand {
+    ExpressionIndex expression;
+    b32 constant;
+    s32 value;
+
+    /// The largest magnitude the integer value may have, or CODE_BOUND_REAL
+    s64 bound;
+} CodeOperand;
+
+/// Emits the code that evaluates an arithmetic expression into the target register
+static b32 code_emit_expression(ChunkBuilder *builder, ExpressionIndex expression, u32 target);
+
+/// Emits the code that evaluates an arithmetic expression into the target register. Expressions that
+/// are integral are evaluated into the integer part of the register, bound receives the largest
+/// magnitude of their value. Otherwise, bound is CODE_BOUND_REAL.
+static b32 code_emit_value(ChunkBuilder *builder, ExpressionIndex expression, u32 target, s64 *bound);
+
+/// Emits the code that evaluates the operand into the target register, unless it is an integral constant
+static b32 code_emit_operand(ChunkBuilder *builder,
+                             CodeOperand *operand,
+                             ExpressionIndex const expression,
+                             u32 const target) {
+    operand->expression = expression;
+    operand->constant = false;
+    Expression const *node = expression_pool_get(builder->pool, expression);
+    if (node->type != EXPRESSION_NUMBER) {
+        return code_emit_value(builder, expression, target, &operand->bound);
+    }
+
+    // Negative zero is excluded, as integers cannot represent it
+    f64 const number = node->number;
+    operand->constant =
+            number == trunc(number) && fabs(number) <= CODE_INTEGER_MAX && !(number == 0.0 && signbit(number));
+    operand->value = operand->constant ? (s32) number : 0;
+    operand->bound = operand->constant ? (s64) fabs(number) : CODE_BOUND_REAL;
+    return operand->constant || code_emit_value(builder, expression, target, &operand->bound);
+}
+
+/// Finishes the operand in the target register, either in its integer or in its number part
+static b32 code_finish_operand(ChunkBuilder *builder, CodeOperand const *operand, u32 const target, b32 const integer) {
+    if (operand->constant) {
+        return integer ? chunk_builder_register(builder, target) &&
+                                 chunk_builder_emit(builder, OPCODE_INTEGER_CONSTANT, target, 0, (u32) operand->value)
+                       : code_emit_expression(builder, operand->expression, target);
+    }
+    if (!integer && operand->bound != CODE_BOUND_REAL) {
+        return chunk_builder_emit(builder, OPCODE_INTEGER_TO_REAL, target, target, 0);
+    }
+    return true;
+}
+
+/// Retrieves the bound of the result of a binary operation on the operands, the operation is carried
+/// out on integers if neither the operands nor the result exceed the integer part of the registers.
+/// Integer results must be exactly the real results, therefore products are only integral if they
+/// cannot be negative zero.
+static s64 code_integer_bound(Operator const operator, CodeOperand const *left, CodeOperand const *right) {
+    if (left->bound == CODE_BOUND_REAL || right->bound == CODE_BOUND_REAL || (left->constant && right->constant)) {
+        return CODE_BOUND_REAL;
+    }
+    s64 bound;
+    switch (operator) {
+        case OPERATOR_ADD:
+        case OPERATOR_SUB:
+            bound = left->bound + right->bound;
+            break;
+        case OPERATOR_MUL:
+            if (!(left->constant && left->value > 0) && !(right->constant && right->value > 0)) {
+                return CODE_BOUND_REAL;
+            }
+            bound = left->bound * right->bound;
+            break;
+        default:
+            return operator_is_relational(operator) ? 1 : CODE_BOUND_REAL;
+    }
+    return bound <= CODE_INTEGER_MAX ? bound : CODE_BOUND_REAL;
+}
+
+/// Emits the code that evaluates the arguments of a function or the indices of an element into consecutive
+/// registers, starting at first
+static b32 code_emit_indices(ChunkBuilder *builder, Expression const *element, u32 const first) {
+    ExpressionIndex const *indices = function_expression_arguments(builder->pool, element);
+    for (u32 index = 0; index < element->element.argument_count; ++index) {
+        if (!code_emit_expression(builder, indices[index], first + index)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Emits the code for a conjunction or disjunction, the right operand is skipped if the left one
+/// already decides the result. Either way the result is turned into 1 or 0.
+static b32 code_emit_logical(ChunkBuilder *builder, BinaryExpression const *binary, u32 const target) {
+    if (!code_emit_expression(builder, binary->left, target)) {
+        return false;
+    }
+    u32 const branch = builder->length;
+    Opcode const opcode = binary->operator== OPERATOR_AND ? OPCODE_BRANCH_FALSE : OPCODE_BRANCH_TRUE;
+    if (!chunk_builder_emit(builder, opcode, target, 0, 0) || !code_emit_expression(builder, binary->right, target)) {
+        return false;
+    }
+    chunk_builder_patch(builder, branch);
+    return chunk_builder_emit(builder, OPCODE_BOOLEAN, target, target, 0);
+}
+
+/// Emits the code for a comparison of two strings, whose order is compared against zero
+static b32 code_emit_string_comparison(ChunkBuilder *builder, BinaryExpression const *binary, u32 const target) {
+    u32 zero;
+    return code_emit_expression(builder, binary->left, target) &&
+           code_emit_expression(builder, binary->right, target + 1) &&
+           chunk_builder_emit(builder, OPCODE_COMPARE_STRING, target, target, target + 1) &&
+           chunk_builder_number(builder, 0.0, &zero) &&
+           chunk_builder_emit(builder, OPCODE_LOAD_CONSTANT, target + 1, 0, zero) &&
+           chunk_builder_emit(builder, code_operator_opcode(binary->operator), target, target, target + 1);
+}
+
+/// Emits the code for an arithmetic or relational binary expression, which is carried out on integers
+/// if the operands are integral
+static b32 code_emit_binary(ChunkBuilder *builder, BinaryExpression const *binary, u32 const target, s64 *bound) {
+    // The left operand is evaluated into the target register, the right one into
+    // the register above, which also serves as the base for its temporaries
+    CodeOperand left;
+    CodeOperand right;
+    if (!code_emit_operand(builder, &left, binary->left, target) ||
+        !code_emit_operand(builder, &right, binary->right, target + 1)) {
+        return false;
+    }
+    *bound = code_integer_bound(binary->operator, &left, &right);
+    b32 const integer = *bound != CODE_BOUND_REAL;
+    Opcode const opcode = integer ? code_operator_integer_opcode(binary->operator)
+                                  : code_operator_opcode(binary->operator);
+    return code_finish_operand(builder, &left, target, integer) &&
+           code_finish_operand(builder, &right, target + 1, integer) &&
+           chunk_builder_emit(builder, opcode, target, target, target + 1);
+}
+
+/// Emits the code that evaluates an arithmetic expression into the target register
+static b32 code_emit_expression(ChunkBuilder *builder, ExpressionIndex const expression, u32 const target) {
+    s64 bound;
+    if (!code_emit_value(builder, expression, target, &bound)) {
+        return false;
+    }
+    return bound == CODE_BOUND_REAL || chunk_builder_emit(builder, OPCODE_INTEGER_TO_REAL, target, target, 0);
+}
+
+/// Emits the code that evaluates an arithmetic expression into the target register
+static b32 code_emit_value(ChunkBuilder *builder, ExpressionIndex const index, u32 const target, s64 *bound) {
+    if (!chunk_builder_register(builder, target)) {
+        return false;
+    }
+
+    Expression const *expression = expression_pool_get(builder->pool, index);
+    *bound = CODE_BOUND_REAL;
+    switch (expression->type) {
+        case EXPRESSION_NUMBER: {
+            u32 index;
+            return chunk_builder_number(builder, expression->number, &index) &&
+                   chunk_builder_emit(builder, OPCODE_LOAD_CONSTANT, target, 0, index);
+        }
+        case EXPRESSION_VARIABLE: {
+            Opcode load = OPCODE_LOAD_VARIABLE;
+            if (expression->variable.type == VARIABLE_TYPE_INTEGER) {
+                load = OPCODE_LOAD_INTEGER;
+                *bound = PROGRAM_INTEGER_MAX;
+            } else if (expression->variable.type == VARIABLE_TYPE_STRING) {
+                load = OPCODE_LOAD_STRING_VARIABLE;
+            }
+            return chunk_builder_emit(builder, load, target, 0, expression->variable.slot);
+        }
+        case EXPRESSION_PARAMETER:
+            return chunk_builder_emit(builder, OPCODE_LOAD_PARAMETER, target, 0, expression->parameter.slot);
+        case EXPRESSION_STRING: {
+            // The characters of the literal are an object, the length is stored in `b`
+            u32 object;
+            return chunk_builder_object(builder, expression->string.data, &object) &&
+                   chunk_builder_emit(builder, OPCODE_LOAD_STRING, target, expression->string.length, object);
+        }
+        case EXPRESSION_UNARY: {
+            if (!code_emit_expression(builder, expression->unary.expression, target)) {
+                return false;
+            }
+            if (expression->unary.operator== OPERATOR_SUB) {
+                return chunk_builder_emit(builder, OPCODE_NEGATE, target, target, 0);
+            }
+            if (expression->unary.operator== OPERATOR_NOT) {
+                return chunk_builder_emit(builder, OPCODE_NOT, target, target, 0);
+            }
+            return true;
+        }
+        case EXPRESSION_BINARY: {
+            BinaryExpression const *binary = &expression->binary;
+            if (binary->operator== OPERATOR_AND || binary->operator== OPERATOR_OR) {
+                return code_emit_logical(builder, binary, target);
+            }
+            if (operator_is_relational(binary->operator) && expression_is_string(builder->pool, binary->left)) {
+                return code_emit_string_comparison(builder, binary, target);
+            }
+
+            // Squares produced by constant folding share their operand, which is evaluated only once
+            if (expression->binary.left == expression->binary.right) {
+                return code_emit_expression(builder, expression->binary.left, target) &&
+                       chunk_builder_emit(builder, code_operator_opcode(expression->binary.operator), target, target,
+                                          target);
+            }
+
+            b32 const string = expression_is_string(builder->pool, index);
+            if (!string && binary->operator!= OPERATOR_DIV) {
+                return code_emit_binary(builder, binary, target, bound);
+            }
+            Opcode const opcode = string ? OPCODE_CONCATENATE : OPCODE_DIV;
+            return code_emit_expression(builder, expression->binary.left, target) &&
+                   code_emit_expression(builder, expression->binary.right, target + 1) &&
+                   chunk_builder_emit(builder, opcode, target, target, target + 1);
+        }
+        case EXPRESSION_EXPONENTIAL: {
+            return code_emit_expression(builder, expression->exponential.base, target) &&
+                   code_emit_expression(builder, expression->exponential.exponent, target + 1) &&
+                   chunk_builder_emit(builder, OPCODE_POWER, target, target, target + 1);
+        }
+        case EXPRESSION_FUNCTION: {
+            // Arguments are placed in consecutive registers, starting at the target register
+            FunctionExpression const *function = &expression->function;
+            return code_emit_indices(builder, expression, target) &&
+                   chunk_builder_emit(builder, OPCODE_CALL, target, function->argument_count, function->slot);
+        }
+        case EXPRESSION_ELEMENT: {
+            // The indices are evaluated into consecutive registers, the element replaces the first index
+            FunctionExpression const *element = &expression->element;
+            char const *name = expression_pool_name(builder->pool, element->name);
+            Opcode load = OPCODE_LOAD_ELEMENT;
+            switch (program_variable_type(name, strlen(name))) {
+                case VARIABLE_TYPE_INTEGER:
+                    load = OPCODE_LOAD_INTEGER_ELEMENT;
+                    *bound = PROGRAM_INTEGER_MAX;
+                    break;
+                case VARIABLE_TYPE_STRING:
+                    load = OPCODE_LOAD_STRING_ELEMENT;
+                    break;
+                default:
+                    break;
+            }
+            return code_emit_indices(builder, expression, target) &&
+                   chunk_builder_emit(builder, load, target, element->argument_count, element->slot);
+        }
+        case EXPRESSION_PEEK:
+            return code_emit_indices(builder, expression, target) &&
+                   chunk_builder_emit(builder, OPCODE_PEEK, target, target, 0);
+        case EXPRESSION_STRING_FUNCTION: {
+            // The string functions are bound at compile time, the slot names the string function
+            FunctionExpression const *function = &expression->function;
+            Opcode const opcode = string_function_returns_string((StringFunction) function->slot)
+                                          ? OPCODE_CALL_STRING
+                                          : OPCODE_CALL_STRING_NUMBER;
+            return code_emit_indices(builder, expression, target) &&
+                   chunk_builder_emit(builder, opcode, target, function->argument_count, function->slot);
+        }
+        default:
+            builder->error = "Expression must be arithmetic";
+            return false;
+    }
+}
+
+/// Compiles an arithmetic expression into a standalone chunk whose return value
+/// is the value of the expression
+static const char *code_compile_expression(MemoryArena *arena,
+                                           ExpressionPool const *pool,
+                                           ExpressionIndex const expression,
+                                           Chunk *chunk) {
+    ChunkBuilder builder;
+    chunk_builder_create(&builder, pool);
+    if (!code_emit_expression(&builder, expression, 0) || !chunk_builder_emit(&builder, OPCODE_RETURN, 0, 0, 0)) {
+        return builder.error;
+    }
+    chunk_builder_finish(&builder, arena, chunk);
+    return NULL;
+}
+
+/// Emits the code for a let statement that assigns an array element
+static b32 code_emit_let_element(ChunkBuilder *builder, Statement const *statement) {
+    Expression const *target = expression_pool_get(builder->pool, statement->let.variable);
+    char const *name = expression_pool_name(builder->pool, target->element.name);
+    s64 bound;
+    if (!code_emit_value(builder, statement->let.initializer, 0, &bound)) {
+        return false;
+    }
+    Opcode store = OPCODE_STORE_ELEMENT;
+    switch (program_variable_type(name, strlen(name))) {
+        case VARIABLE_TYPE_INTEGER:
+            store = bound != CODE_BOUND_REAL ? OPCODE_INTEGER_STORE_ELEMENT : OPCODE_STORE_INTEGER_ELEMENT;
+            break;
+        case VARIABLE_TYPE_STRING:
+            store = OPCODE_STORE_STRING_ELEMENT;
+            break;
+        default:
+            if (bound != CODE_BOUND_REAL && !chunk_builder_emit(builder, OPCODE_INTEGER_TO_REAL, 0, 0, 0)) {
+                return false;
+            }
+            break;
+    }
+    return code_emit_indices(builder, target, 1) &&
+           chunk_builder_emit(builder, store, 0, target->element.argument_count, target->element.slot);
+}
+
+/// Emits the code for a let statement
+static b32 code_emit_let(ChunkBuilder *builder, Statement const *statement) {
+    Expression const *target = expression_pool_get(builder->pool, statement->let.variable);
+    if (target->type == EXPRESSION_ELEMENT) {
+        return code_emit_let_element(builder, statement);
+    }
+    // Integral values are assigned to integer variables without being converted to real numbers
+    VariableExpression const *variable = &target->variable;
+    if (variable->type == VARIABLE_TYPE_INTEGER) {
+        s64 bound;
+        return code_emit_value(builder, statement->let.initializer, 0, &bound) &&
+               chunk_builder_emit(builder, bound != CODE_BOUND_REAL ? OPCODE_INTEGER_STORE : OPCODE_STORE_INTEGER, 0,
+                                  0, variable->slot);
+    }
+    Opcode const store = variable->type == VARIABLE_TYPE_STRING ? OPCODE_STORE_STRING : OPCODE_STORE_VARIABLE;
+    return code_emit_expression(builder, statement->let.initializer, 0) &&
+           chunk_builder_emit(builder, store, 0, 0, variable->slot);
+}
+
+/// Emits the code for a dim statement, every array is dimensioned on its own
+static b32 code_emit_dim(ChunkBuilder *builder, Statement const *statement) {
+    for (u32 index = 0; index < statement->dim.array_count; ++index) {
+        Expression const *array = expression_pool_get(builder->pool, statement->dim.arrays[index]);
+        if (!code_emit_indices(builder, array, 0) ||
+            !chunk_builder_emit(builder, OPCODE_DIMENSION, 0, array->element.argument_count, array->element.slot)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Emits the code for a for statement, which evaluates the start, the limit and the step into
+/// the first three registers
+static b32 code_emit_for(ChunkBuilder *builder, Statement const *statement) {
+    ForStatement const *loop = &statement->for_loop;
+    return code_emit_expression(builder, loop->start, 0) && code_emit_expression(builder, loop->limit, 1) &&
+           code_emit_expression(builder, loop->step, 2) &&
+           chunk_builder_emit(builder, OPCODE_FOR, 0, statement->index + 1,
+                              expression_pool_get(builder->pool, loop->variable)->variable.slot);
+}
+
+/// Emits the code for a next statement, every loop variable is advanced by its own instruction
+static b32 code_emit_next(ChunkBuilder *builder, Statement const *statement) {
+    NextStatement const *next = &statement->next;
+    if (next->variable_count == 0) {
+        return chunk_builder_emit(builder, OPCODE_NEXT, 0, 0, PROGRAM_LOOP_ANY);
+    }
+    for (u32 index = 0; index < next->variable_count; ++index) {
+        u32 const slot = expression_pool_get(builder->pool, next->variables[index])->variable.slot;
+        if (!chunk_builder_emit(builder, OPCODE_NEXT, 0, 0, slot)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Emits the code for a poke statement, which evaluates the address and the value into the first two registers
+static b32 code_emit_poke(ChunkBuilder *builder, Statement const *statement) {
+    return code_emit_expression(builder, statement->poke.address, 0) &&
+           code_emit_expression(builder, statement->poke.value, 1) &&
+           chunk_builder_emit(builder, OPCODE_POKE, 0, 1, 0);
+}
+
+/// Emits the code for a print statement
+static b32 code_emit_print(ChunkBuilder *builder, Statement const *statement) {
+    ExpressionIndex const printable = statement->print.printable;
+    Opcode const print = expression_is_string(builder->pool, printable) ? OPCODE_PRINT_STRING : OPCODE_PRINT_NUMBER;
+    return code_emit_expression(builder, printable, 0) && chunk_builder_emit(builder, print, 0, 0, 0);
+}
+
+/// Emits the code for an if statement, whose branch is the last instruction of the statement. It is patched
+/// once the whole line has been emitted.
+static b32 code_emit_if(ChunkBuilder *builder, Statement const *statement) {
+    return code_emit_expression(builder, statement->if_then.condition, 0) &&
+           chunk_builder_emit(builder, OPCODE_BRANCH_FALSE, 0, 0, 0);
+}
+
+/// Emits the code for a statement
+static b32 code_emit_statement(ChunkBuilder *builder, Statement const *statement) {
+    switch (statement->type) {
+        case STATEMENT_LET:
+            return code_emit_let(builder, statement);
+        case STATEMENT_CLEAR:
+            return chunk_builder_emit(builder, OPCODE_CLEAR, 0, 0, 0);
+        case STATEMENT_DIM:
+            return code_emit_dim(builder, statement);
+        case STATEMENT_DEF_FN: {
+            u32 object;
+            return chunk_builder_object(builder, statement, &object) &&
+                   chunk_builder_emit(builder, OPCODE_DEFINE_FUNCTION, 0, 0, object);
+        }
+        case STATEMENT_GOTO:
+        case STATEMENT_GOSUB: {
+            // The target is read from the statement, as it is only linked when the program is run
+            u32 object;
+            return chunk_builder_object(builder, statement, &object) &&
+                   chunk_builder_emit(builder, OPCODE_JUMP, 0, 0, object);
+        }
+        case STATEMENT_RETURN:
+            return chunk_builder_emit(builder, OPCODE_RETURN_SUBROUTINE, 0, 0, 0);
+        case STATEMENT_ON: {
+            u32 object;
+            return code_emit_expression(builder, statement->on.selector, 0) &&
+                   chunk_builder_object(builder, statement, &object) &&
+                   chunk_builder_emit(builder, OPCODE_JUMP_ON, 0, 0, object);
+        }
+        case STATEMENT_FOR:
+            return code_emit_for(builder, statement);
+        case STATEMENT_NEXT:
+            return code_emit_next(builder, statement);
+        case STATEMENT_IF:
+            return code_emit_if(builder, statement);
+        case STATEMENT_POKE:
+            return code_emit_poke(builder, statement);
+        case STATEMENT_PRINT:
+            return code_emit_print(builder, statement);
+        default:
+            return true;
+    }
+}
+
+/// Compiles the statements of a line into a single chunk
+static const char *code_compile_line(MemoryArena *arena,
+                                     ExpressionPool const *pool,
+                                     Statement const *line,
+                                     Chunk *chunk) {
+    BlockStatement const *block = &line->block;
+    ChunkBuilder builder;
+    chunk_builder_create(&builder, pool);
+    for (u32 index = 0; index < block->statement_count; ++index) {
+        block->entries[index] = builder.length;
+        if (!code_emit_statement(&builder, block->statements + index)) {
+            return builder.error;
+        }
+    }
+    block->entries[block->statement_count] = builder.length;
+
+    // A condition that does not hold skips the rest of the line
+    for (u32 index = 0; index < block->statement_count; ++index) {
+        if (block->statements[index].type == STATEMENT_IF) {
+            chunk_builder_patch(&builder, block->entries[index + 1] - 1);
+        }
+    }
+    if (!chunk_builder_emit(&builder, OPCODE_RETURN, 0, 0, 0)) {
+        return builder.error;
+    }
+    chunk_builder_finish(&builder, arena, chunk);
+    return NULL;
+}
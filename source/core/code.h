@@ -0,0 +1,221 @@
+// Copyright (c) 2025 Elias Engelbert Plank
+
+#ifndef RETRO_CODE_H
+#define RETRO_CODE_H
+
+/// Forward declares
+typedef struct Statement Statement;
+
+typedef enum Opcode {
+    // Loads and stores
+    OPCODE_LOAD_CONSTANT,
+    OPCODE_LOAD_VARIABLE,
+    OPCODE_LOAD_INTEGER,
+    OPCODE_LOAD_PARAMETER,
+    OPCODE_LOAD_STRING,
+    OPCODE_LOAD_STRING_VARIABLE,
+    OPCODE_LOAD_ELEMENT,
+    OPCODE_LOAD_INTEGER_ELEMENT,
+    OPCODE_LOAD_STRING_ELEMENT,
+    OPCODE_STORE_VARIABLE,
+    OPCODE_STORE_INTEGER,
+    OPCODE_STORE_STRING,
+    OPCODE_STORE_ELEMENT,
+    OPCODE_STORE_INTEGER_ELEMENT,
+    OPCODE_STORE_STRING_ELEMENT,
+
+    // Memory, PEEK loads the byte at the address in register `b` and POKE stores the byte in
+    // register `b` at the address in register `a`
+    OPCODE_PEEK,
+    OPCODE_POKE,
+
+    // Arithmetic
+    OPCODE_NEGATE,
+    OPCODE_ADD,
+    OPCODE_SUB,
+    OPCODE_MUL,
+    OPCODE_DIV,
+    OPCODE_POWER,
+    OPCODE_CALL,
+
+    // Comparisons and boolean operators, which yield 1 or 0
+    OPCODE_EQUAL,
+    OPCODE_NOT_EQUAL,
+    OPCODE_LESS,
+    OPCODE_LESS_EQUAL,
+    OPCODE_GREATER,
+    OPCODE_GREATER_EQUAL,
+    OPCODE_NOT,
+    OPCODE_BOOLEAN,
+
+    // Integer arithmetic on the integer part of the registers, the constant is stored in `c`
+    OPCODE_INTEGER_CONSTANT,
+    OPCODE_INTEGER_ADD,
+    OPCODE_INTEGER_SUB,
+    OPCODE_INTEGER_MUL,
+    OPCODE_INTEGER_EQUAL,
+    OPCODE_INTEGER_NOT_EQUAL,
+    OPCODE_INTEGER_LESS,
+    OPCODE_INTEGER_LESS_EQUAL,
+    OPCODE_INTEGER_GREATER,
+    OPCODE_INTEGER_GREATER_EQUAL,
+    OPCODE_INTEGER_STORE,
+    OPCODE_INTEGER_STORE_ELEMENT,
+    OPCODE_INTEGER_TO_REAL,
+
+    // Branches to the instruction at index `c` of the chunk, depending on register `a`
+    OPCODE_BRANCH_FALSE,
+    OPCODE_BRANCH_TRUE,
+
+    // Strings
+    OPCODE_CONCATENATE,
+    OPCODE_CALL_STRING,
+    OPCODE_CALL_STRING_NUMBER,
+    OPCODE_COMPARE_STRING,
+
+    // Control flow, every instruction that redirects the program ends the chunk. FOR takes the
+    // index of the statement that starts the loop body in `b`.
+    OPCODE_JUMP,
+    OPCODE_JUMP_ON,
+    OPCODE_RETURN_SUBROUTINE,
+    OPCODE_FOR,
+    OPCODE_NEXT,
+
+    // Statements
+    OPCODE_CLEAR,
+    OPCODE_DIMENSION,
+    OPCODE_DEFINE_FUNCTION,
+    OPCODE_PRINT_NUMBER,
+    OPCODE_PRINT_STRING,
+    OPCODE_RETURN
+} Opcode;
+
+/// A single instruction of the register machine. Operand `a` usually names
+/// the target register, `b` the left source register (or an argument count)
+/// and `c` the right source register, a constant index, a slot or an object index. String literals are
+/// loaded from the characters in object `c`, whose length is `b`.
+/// Every register has a number, an integer and a string part, string instructions only
+/// use the string part of their registers. Integer variables and elements are loaded into
+/// the integer part, which is converted once it is used as a real number. Array instructions
+/// take the indices (or bounds) of `b` dimensions in consecutive registers, which start at
+/// `a` for loads and dimensions and above the value register `a` for stores.
+typedef struct Instruction {
+    u8 opcode;
+    u8 a;
+    u16 b;
+    u32 c;
+} Instruction;
+
+enum {
+    CHUNK_CODE_CAPACITY = 1024,
+    CHUNK_NUMBER_CAPACITY = 256,
+    CHUNK_OBJECT_CAPACITY = 256,
+    CHUNK_REGISTER_COUNT = 256
+};
+
+/// A chunk is a compiled, immutable piece of bytecode together with its
+/// constant pool. Numbers are stored unboxed, while strings and statements
+/// are referenced through the object pool.
+typedef struct Chunk {
+    Instruction *code;
+    u32 length;
+    f64 *numbers;
+    u32 number_count;
+    void const **objects;
+    u32 object_count;
+
+    /// The amount of registers the chunk requires, starting at zero
+    u32 registers;
+
+    /// The profile of the chunk and its native code, which is the only part that changes once
+    /// the chunk is finished
+    JitCode *native;
+} Chunk;
+
+/// The chunk builder is a fixed size scratch buffer that instructions and
+/// constants are emitted into. Once compilation is done, the chunk is copied
+/// into an arena with its exact size.
+typedef struct ChunkBuilder {
+    /// The expression pool that holds the nodes of the compiled expressions
+    ExpressionPool const *pool;
+    Instruction code[CHUNK_CODE_CAPACITY];
+    u32 length;
+    f64 numbers[CHUNK_NUMBER_CAPACITY];
+    u32 number_count;
+    void const *objects[CHUNK_OBJECT_CAPACITY];
+    u32 object_count;
+    u32 registers;
+    const char *error;
+} ChunkBuilder;
+
+/// Creates an empty chunk builder
+/// @param self The chunk builder
+/// @param pool The expression pool that holds the nodes of the compiled expressions
+static void chunk_builder_create(ChunkBuilder *self, ExpressionPool const *pool);
+
+/// Emits an instruction
+/// @param self The chunk builder
+/// @param opcode The opcode
+/// @param a The first operand
+/// @param b The second operand
+/// @param c The third operand
+/// @return A boolean value that indicates whether the instruction could be emitted
+static b32 chunk_builder_emit(ChunkBuilder *self, Opcode opcode, u32 a, u32 b, u32 c);
+
+/// Points the branch that was emitted at the specified index to the next instruction that is emitted
+/// @param self The chunk builder
+/// @param branch The index of the branch instruction
+static void chunk_builder_patch(ChunkBuilder *self, u32 branch);
+
+/// Adds a number to the constant pool, equal numbers share one entry
+/// @param self The chunk builder
+/// @param number The number
+/// @param index The resulting constant index
+/// @return A boolean value that indicates whether the number could be added
+static b32 chunk_builder_number(ChunkBuilder *self, f64 number, u32 *index);
+
+/// Adds an object to the object pool, equal objects share one entry
+/// @param self The chunk builder
+/// @param object The object
+/// @param index The resulting object index
+/// @return A boolean value that indicates whether the object could be added
+static b32 chunk_builder_object(ChunkBuilder *self, void const *object, u32 *index);
+
+/// Copies the emitted code and constants into the arena
+/// @param self The chunk builder
+/// @param arena The arena for allocations
+/// @param chunk The resulting chunk
+static void chunk_builder_finish(ChunkBuilder const *self, MemoryArena *arena, Chunk *chunk);
+
+/// Emits the code that evaluates an arithmetic expression into the target register
+/// @param builder The chunk builder
+/// @param expression The index of the expression
+/// @param target The target register, registers above it are used as temporaries
+/// @return A boolean value that indicates whether the expression could be compiled
+static b32 code_emit_expression(ChunkBuilder *builder, ExpressionIndex expression, u32 target);
+
+/// Compiles an arithmetic expression into a standalone chunk whose return value
+/// is the value of the expression
+/// @param arena The arena for allocations
+/// @param pool The expression pool
+/// @param expression The index of the expression
+/// @param chunk The resulting chunk
+/// @return An error message or NULL on success
+static const char *code_compile_expression(MemoryArena *arena,
+                                           ExpressionPool const *pool,
+                                           ExpressionIndex expression,
+                                           Chunk *chunk);
+
+/// Compiles the statements of a line into a single chunk, the entry of every statement is
+/// recorded in the block statement of the line
+/// @param arena The arena for allocations
+/// @param pool The expression pool
+/// @param line The block statement of the line
+/// @param chunk The resulting chunk
+/// @return An error message or NULL on success
+static const char *code_compile_line(MemoryArena *arena,
+                                     ExpressionPool const *pool,
+                                     Statement const *line,
+                                     Chunk *chunk);
+
+#endif// RETRO_CODE_H
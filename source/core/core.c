@@ -2,11 +2,17 @@
 
 #include "core.h"
 
+#include "address.c"
+#include "ast.c"
+#include "code.c"
 #include "display.c"
 #include "emu.c"
 #include "expr.c"
+#include "heap.c"
 #include "input.c"
+#include "jit.c"
 #include "lexer.c"
 #include "prog.c"
 #include "stmt.c"
+#include "vm.c"
 
@@ -8,11 +8,17 @@
 // clang-format off
 #include "display.h"
 #include "lexer.h"
+#include "heap.h"
+#include "jit.h"
+#include "ast.h"
+#include "address.h"
 #include "prog.h"
 #include "emu.h"
 #include "expr.h"
+#include "code.h"
 #include "input.h"
 #include "stmt.h"
+#include "vm.h"
 // clang-format on
 
 #endif// RETRO_CORE_H
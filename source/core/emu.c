@@ -9,23 +9,26 @@ static void emulator_pass_finish(Emulator *self) {
 
 /// Runs an emulator pass
 static void emulator_pass(Emulator *self) {
-    // Parse user input
-    TokenList *tokens = tokenize(self->text.data, self->text.fill);
-    StatementResult const result = statement_compile(&self->arena, tokens->begin, tokens->end);
-    token_list_free(tokens);
+    // Parse user input, only lines that are inserted into the program keep their memory
+    tokenize(&self->tokens, self->text.data, self->text.fill);
+    arena_begin_temporary(&self->arena);
+    StatementResult const result = statement_compile(&self->arena, &self->program, &self->tokens);
 
     F32Vector2 position = { 30.0f, 30.0f };
     if (result.type == RESULT_ERROR) {
         // show user the error
         static F32Vector3 err = { 1.0f, 0.0f, 0.0f };
         renderer_draw_text(self->renderer, &position, &err, 0.5f, "%s", result.error);
+        arena_end_temporary(&self->arena);
     } else {
         switch (result.statement->type) {
             case STATEMENT_RUN:
+                arena_end_temporary(&self->arena);
                 program_execute(&self->program);
                 break;
             default:
-                program_tree_insert(&self->program.lines, result.statement);
+                arena_keep_temporary(&self->arena);
+                program_lines_insert(&self->program.lines, result.statement);
                 emulator_pass_finish(self);
                 return;
         }
@@ -81,40 +84,55 @@ static f64 sgn(f64 const x) {
 }
 
 /// Adds all builtin symbols to the emulator symbol table
-static void emulator_add_builtin_symbols(Emulator const *self) {
-    // available math functions
-    static FunctionDefinition builtin[] = { { .name = "ABS",
-                                              .type = FUNCTION_DEFINITION_BUILTIN,
-                                              .builtin = { .parameter_count = PARAMETER_COUNT_1, .func1 = fabs } },
-                                            { "ATN", .type = FUNCTION_DEFINITION_BUILTIN,
-                                              .builtin = { .parameter_count = PARAMETER_COUNT_1, .func1 = atan } },
-                                            { .name = "COS",
-                                              .type = FUNCTION_DEFINITION_BUILTIN,
-                                              .builtin = { .parameter_count = PARAMETER_COUNT_1, .func1 = cos } },
-                                            { "EXP", .type = FUNCTION_DEFINITION_BUILTIN,
-                                              .builtin = { .parameter_count = PARAMETER_COUNT_1, .func1 = exp } },
-                                            { .name = "INT",
-                                              .type = FUNCTION_DEFINITION_BUILTIN,
-                                              .builtin = { .parameter_count = PARAMETER_COUNT_1, .func1 = floor } },
-                                            { "LOG", .type = FUNCTION_DEFINITION_BUILTIN,
-                                              .builtin = { .parameter_count = PARAMETER_COUNT_1, .func1 = log } },
-                                            { .name = "RND",
-                                              .type = FUNCTION_DEFINITION_BUILTIN,
-                                              .builtin = { .parameter_count = PARAMETER_COUNT_1, .func1 = rnd } },
-                                            { "SGN", .type = FUNCTION_DEFINITION_BUILTIN,
-                                              .builtin = { .parameter_count = PARAMETER_COUNT_1, .func1 = sgn } },
-                                            { .name = "SIN",
-                                              .type = FUNCTION_DEFINITION_BUILTIN,
-                                              .builtin = { .parameter_count = PARAMETER_COUNT_1, .func1 = sin } },
-                                            { "SQR", .type = FUNCTION_DEFINITION_BUILTIN,
-                                              .builtin = { .parameter_count = PARAMETER_COUNT_1, .func1 = sqrt } },
-                                            { .name = "TAN",
-                                              .type = FUNCTION_DEFINITION_BUILTIN,
-                                              .builtin = { .parameter_count = PARAMETER_COUNT_1, .func1 = tan } } };
+static void emulator_add_builtin_symbols(Emulator *self) {
+    // available math functions, calls to pure functions with constant arguments are folded at compile time
+    static struct {
+        char const *name;
+        FunctionDefinition definition;
+    } const builtin[] = {
+        { .name = "ABS",
+          .definition = { .type = FUNCTION_DEFINITION_BUILTIN,
+                          .builtin = { .parameter_count = PARAMETER_COUNT_1, .pure = true, .func1 = fabs } } },
+        { .name = "ATN",
+          .definition = { .type = FUNCTION_DEFINITION_BUILTIN,
+                          .builtin = { .parameter_count = PARAMETER_COUNT_1, .pure = true, .func1 = atan } } },
+        { .name = "COS",
+          .definition = { .type = FUNCTION_DEFINITION_BUILTIN,
+                          .builtin = { .parameter_count = PARAMETER_COUNT_1, .pure = true, .func1 = cos } } },
+        { .name = "EXP",
+          .definition = { .type = FUNCTION_DEFINITION_BUILTIN,
+                          .builtin = { .parameter_count = PARAMETER_COUNT_1, .pure = true, .func1 = exp } } },
+        { .name = "INT",
+          .definition = { .type = FUNCTION_DEFINITION_BUILTIN,
+                          .builtin = { .parameter_count = PARAMETER_COUNT_1, .pure = true, .func1 = floor } } },
+        { .name = "LOG",
+          .definition = { .type = FUNCTION_DEFINITION_BUILTIN,
+                          .builtin = { .parameter_count = PARAMETER_COUNT_1, .pure = true, .func1 = log } } },
+        { .name = "RND",
+          .definition = { .type = FUNCTION_DEFINITION_BUILTIN,
+                          .builtin = { .parameter_count = PARAMETER_COUNT_1, .pure = false, .func1 = rnd } } },
+        { .name = "SGN",
+          .definition = { .type = FUNCTION_DEFINITION_BUILTIN,
+                          .builtin = { .parameter_count = PARAMETER_COUNT_1, .pure = true, .func1 = sgn } } },
+        { .name = "SIN",
+          .definition = { .type = FUNCTION_DEFINITION_BUILTIN,
+                          .builtin = { .parameter_count = PARAMETER_COUNT_1, .pure = true, .func1 = sin } } },
+        { .name = "SQR",
+          .definition = { .type = FUNCTION_DEFINITION_BUILTIN,
+                          .builtin = { .parameter_count = PARAMETER_COUNT_1, .pure = true, .func1 = sqrt } } },
+        { .name = "TAN",
+          .definition = { .type = FUNCTION_DEFINITION_BUILTIN,
+                          .builtin = { .parameter_count = PARAMETER_COUNT_1, .pure = true, .func1 = tan } } }
+    };
 
+    // The definitions are copied, so that they carry the name that was interned in this program
+    Program *program = &self->program;
     for (usize index = 0; index < STACK_ARRAY_SIZE(builtin); ++index) {
-        FunctionDefinition *function = builtin + index;
-        hash_map_insert(self->program.symbols, function->name, function);
+        FunctionDefinition *function = arena_alloc(&program->objects, sizeof(FunctionDefinition));
+        *function = builtin[index].definition;
+        char const *name = builtin[index].name;
+        function->name = expression_pool_intern(&program->expressions, name, strlen(name));
+        program_define_function(program, function);
     }
 }
 
@@ -127,7 +145,8 @@ static void emulator_create(Emulator *self, Renderer *renderer) {
     emulator_add_builtin_symbols(self);
 
     text_cursor_create(&self->text, 128);
-    self->history = text_queue_new();
+    self->history = text_queue_new(EMULATOR_HISTORY_CAPACITY);
+    token_list_create(&self->tokens, TOKEN_LIST_CAPACITY);
     self->arena = arena_identity(ALIGNMENT8);
     self->enable_crt = true;
 }
@@ -137,6 +156,7 @@ static void emulator_destroy(Emulator *self) {
     program_destroy(&self->program);
     text_cursor_destroy(&self->text);
     text_queue_free(self->history);
+    token_list_destroy(&self->tokens);
     arena_destroy(&self->arena);
 }
 
@@ -147,6 +167,97 @@ static void emulator_run(Emulator *self) {
     thread_create(emulator_pass_platform, self);
 }
 
+/// Compiles and executes a single line of a program file, failed is set if a command stops the program
+/// with an error, which does not prevent the remaining lines from being loaded
+static b32 emulator_run_line(Emulator *self,
+                             char const *data,
+                             usize const length,
+                             usize const number,
+                             b32 *ran,
+                             b32 *failed) {
+    // Blank lines are skipped, whereas any other line must be a valid statement or command
+    usize first = 0;
+    while (first < length && isspace(data[first])) {
+        ++first;
+    }
+    if (first == length) {
+        return true;
+    }
+
+    // Commands such as RUN are executed right away, their memory is reclaimed just like the memory of
+    // lines that do not compile
+    tokenize(&self->tokens, data, length);
+    arena_begin_temporary(&self->arena);
+    StatementResult const result = statement_compile(&self->arena, &self->program, &self->tokens);
+    if (result.type == RESULT_ERROR) {
+        arena_end_temporary(&self->arena);
+        fprintf(stderr, "error in line %zu: %s\n", number, result.error);
+        return false;
+    }
+    if (result.statement->type == STATEMENT_RUN) {
+        arena_end_temporary(&self->arena);
+        *ran = true;
+        if (!program_execute(&self->program)) {
+            *failed = true;
+        }
+        return true;
+    }
+    arena_keep_temporary(&self->arena);
+    program_lines_insert(&self->program.lines, result.statement);
+    return true;
+}
+
+/// Loads the program from the specified file and executes it without a window
+static b32 emulator_run_file(Emulator *self, char const *path) {
+    BinaryBuffer buffer = { 0 };
+    if (!file_read(&buffer, path) || buffer.data == NULL) {
+        fprintf(stderr, "could not read %s\n", path);
+        return false;
+    }
+
+    b32 ran = false;
+    b32 failed = false;
+    b32 success = true;
+    usize number = 1;
+    for (char const *line = buffer.data, *end = buffer.data + buffer.size; success && line < end; ++number) {
+        char const *newline = memchr(line, '\n', (usize) (end - line));
+        char const *line_end = newline != NULL ? newline : end;
+        success = emulator_run_line(self, line, (usize) (line_end - line), number, &ran, &failed);
+        line = line_end + 1;
+    }
+    if (success && !ran) {
+        failed = !program_execute(&self->program);
+    }
+
+    free(buffer.data);
+    return success && !failed;
+}
+
+/// Latches the keys that do not produce a character, so that programs can read them from the
+/// keyboard soft switch, characters are latched by the char callback
+static void emulator_latch_key(Emulator *self, s32 const key) {
+    switch (key) {
+        case GLFW_KEY_ENTER:
+            address_space_key(&self->program.memory, 0x0D);
+            break;
+        case GLFW_KEY_ESCAPE:
+            address_space_key(&self->program.memory, 0x1B);
+            break;
+        case GLFW_KEY_LEFT:
+        case GLFW_KEY_BACKSPACE:
+            address_space_key(&self->program.memory, 0x08);
+            break;
+        case GLFW_KEY_RIGHT:
+            address_space_key(&self->program.memory, 0x15);
+            break;
+        case GLFW_KEY_TAB:
+            address_space_key(&self->program.memory, 0x09);
+            break;
+        default:
+            break;
+    }
+}
+
 /// Key callback handler for handling GLFW key input
 static void emulator_key_callback(GLFWwindow *handle,
                                   s32 const key,
@@ -159,6 +270,7 @@ static void emulator_key_callback(GLFWwindow *handle,
     Emulator *self = glfwGetWindowUserPointer(handle);
     if (self) {
         self->program.last_key = key;
+        emulator_latch_key(self, key);
         if (self->state == EMULATOR_STATE_INPUT) {
             TextCursor *text = &self->text;
             switch (key) {
@@ -181,6 +293,15 @@ static void emulator_key_callback(GLFWwindow *handle,
                 case GLFW_KEY_F2:
                     self->enable_crt = !self->enable_crt;
                     break;
+                case GLFW_KEY_F3:
+                    // toggle between the virtual machine and the reference interpreter
+                    self->program.mode = self->program.mode == PROGRAM_MODE_BYTECODE ? PROGRAM_MODE_REFERENCE
+                                                                                      : PROGRAM_MODE_BYTECODE;
+                    break;
+                case GLFW_KEY_F4:
+                    // toggle the native code of hot chunks
+                    jit_enable(&self->program.jit, !self->program.jit.enabled);
+                    break;
                 default:
                     break;
             }
@@ -193,5 +314,8 @@ static void emulator_char_callback(GLFWwindow *handle, u32 const unicode) {
     Emulator *self = glfwGetWindowUserPointer(handle);
     if (self) {
         text_cursor_emplace(&self->text, (char) toupper((char) unicode));
+        if (unicode < 0x80) {
+            address_space_key(&self->program.memory, (u8) toupper((char) unicode));
+        }
     }
 }
@@ -8,6 +8,11 @@ typedef enum EmulatorState {
     EMULATOR_STATE_EXECUTION = 1
 } EmulatorState;
 
+enum {
+    /// The amount of entered lines that are kept and shown above the input line
+    EMULATOR_HISTORY_CAPACITY = 64
+};
+
 typedef enum EmulatorMode {
     EMULATOR_MODE_TEXT = 0,
     EMULATOR_MODE_GRAPHICS = 1
@@ -20,6 +25,7 @@ typedef struct Emulator {
     Program program;
     TextCursor text;
     TextQueue *history;
+    TokenList tokens;
     MemoryArena arena;
     b32 enable_crt;
 } Emulator;
@@ -37,6 +43,14 @@ static void emulator_destroy(Emulator *self);
 /// @param self The emulator instance
 static void emulator_run(Emulator *self);
 
+/// Loads the program from the specified file and executes it without a window. Commands in the
+/// file (such as RUN) are executed when they are encountered, the program is run once at the end
+/// if the file does not run it by itself.
+/// @param self The emulator instance, which must have been created without a renderer
+/// @param path The path to the program file
+/// @return A boolean value that indicates whether the program could be loaded and ran without an error
+static b32 emulator_run_file(Emulator *self, char const *path);
+
 /// Key callback handler for handling GLFW key input
 /// @param handle The glfw window handle
 /// @param key The key that is currently pressed
@@ -1,38 +1,50 @@
 // Copyright (c) 2025 Elias Engelbert Plank
 
 /// Creates a new unary expression instance
-static Expression *unary_expression_new(MemoryArena *arena, Operator const operator, Expression * expression) {
-    Expression *self = arena_alloc(arena, sizeof(Expression));
-    self->type = EXPRESSION_UNARY;
+static ExpressionIndex unary_expression_new(ExpressionPool *pool,
+                                            Operator const operator,
+                                            ExpressionIndex const expression) {
+    ExpressionIndex const index = expression_pool_push(pool, EXPRESSION_UNARY);
+    Expression *self = expression_pool_get(pool, index);
     self->unary.operator= operator;
     self->unary.expression = expression;
-    return self;
+    return index;
 }
 
 /// Evaluates the unary expression
-static f64 unary_expression_evaluate(Expression const *self, HashMap const *symbol_table) {
-    f64 const value = expression_evaluate(self->unary.expression, symbol_table);
-    return self->unary.operator== OPERATOR_ADD ? value : - 1.0 * value;
+static f64 unary_expression_evaluate(Expression const *self, Program *program) {
+    f64 const value = expression_evaluate(self->unary.expression, program);
+    switch (self->unary.operator) {
+        case OPERATOR_ADD:
+            return value;
+        case OPERATOR_NOT:
+            return value == 0.0 ? 1.0 : 0.0;
+        default:
+            return - 1.0 * value;
+    }
 }
 
 /// Creates a new binary expression instance
-static Expression *binary_expression_new(MemoryArena *arena,
-                                         Expression *left,
-                                         Expression *right,
-                                         Operator const operator) {
-    Expression *self = arena_alloc(arena, sizeof(Expression));
-    self->type = EXPRESSION_BINARY;
+static ExpressionIndex binary_expression_new(ExpressionPool *pool,
+                                             ExpressionIndex const left,
+                                             ExpressionIndex const right,
+                                             Operator const operator) {
+    ExpressionIndex const index = expression_pool_push(pool, EXPRESSION_BINARY);
+    Expression *self = expression_pool_get(pool, index);
     self->binary.left = left;
     self->binary.right = right;
     self->binary.operator= operator;
-    return self;
+    return index;
 }
 
-/// Evaluates the binary expression
-static f64 binary_expression_evaluate(Expression const *self, HashMap const *symbol_table) {
-    f64 const left = expression_evaluate(self->binary.left, symbol_table);
-    f64 const right = expression_evaluate(self->binary.right, symbol_table);
-    switch (self->binary.operator) {
+/// Checks if the operator compares its operands
+static b32 operator_is_relational(Operator const operator) {
+    return operator>= OPERATOR_EQUAL && operator<= OPERATOR_GREATER_EQUAL;
+}
+
+/// Applies the binary operator to the specified operands
+static f64 operator_apply(Operator const operator, f64 const left, f64 const right) {
+    switch (operator) {
         case OPERATOR_ADD:
             return left + right;
         case OPERATOR_SUB:
@@ -41,130 +53,188 @@ static f64 binary_expression_evaluate(Expression const *self, HashMap const *sym
             return left * right;
         case OPERATOR_DIV:
             return left / right;
+        case OPERATOR_EQUAL:
+            return left == right ? 1.0 : 0.0;
+        case OPERATOR_NOT_EQUAL:
+            return left != right ? 1.0 : 0.0;
+        case OPERATOR_LESS:
+            return left < right ? 1.0 : 0.0;
+        case OPERATOR_LESS_EQUAL:
+            return left <= right ? 1.0 : 0.0;
+        case OPERATOR_GREATER:
+            return left > right ? 1.0 : 0.0;
+        case OPERATOR_GREATER_EQUAL:
+            return left >= right ? 1.0 : 0.0;
+        case OPERATOR_AND:
+            return left != 0.0 && right != 0.0 ? 1.0 : 0.0;
+        case OPERATOR_OR:
+            return left != 0.0 || right != 0.0 ? 1.0 : 0.0;
+        default:
+            break;
     }
     return 0.0;
 }
 
+/// Evaluates a binary expression with a relational or boolean operator
+static f64 binary_expression_evaluate_condition(Expression const *self, Program *program) {
+    Operator const operator= self->binary.operator;
+    if (operator_is_relational(operator) && expression_is_string(&program->expressions, self->binary.left)) {
+        // Strings are compared by their order, which is then compared against zero
+        String const left = expression_evaluate_string(self->binary.left, program);
+        String const right = expression_evaluate_string(self->binary.right, program);
+        return operator_apply(operator, (f64) string_compare(left, right), 0.0);
+    }
+
+    f64 const left = expression_evaluate(self->binary.left, program);
+    if ((operator== OPERATOR_AND && left == 0.0) || (operator== OPERATOR_OR && left != 0.0)) {
+        return operator== OPERATOR_OR ? 1.0 : 0.0;
+    }
+    f64 const right = expression_evaluate(self->binary.right, program);
+    return operator_apply(operator, left, right);
+}
+
+/// Evaluates the binary expression
+static f64 binary_expression_evaluate(Expression const *self, Program *program) {
+    // Conditions are kept out of the way of arithmetic, which is by far the most common case
+    if (self->binary.operator>= OPERATOR_EQUAL) {
+        return binary_expression_evaluate_condition(self, program);
+    }
+    f64 const left = expression_evaluate(self->binary.left, program);
+    f64 const right = expression_evaluate(self->binary.right, program);
+    return operator_apply(self->binary.operator, left, right);
+}
+
 /// Creates a new variable expression instance
-static Expression *variable_expression_new(MemoryArena *arena, char const *name, usize const length) {
-    Expression *self = arena_alloc(arena, sizeof(Expression));
-    self->type = EXPRESSION_VARIABLE;
-    memset(self->variable.name, 0, sizeof self->variable.name);
-    memcpy(self->variable.name, name, length);
-    return self;
+static ExpressionIndex variable_expression_new(ExpressionPool *pool, char const *name, usize const length) {
+    ExpressionName const interned = expression_pool_intern(pool, name, length);
+    ExpressionIndex const index = expression_pool_push(pool, EXPRESSION_VARIABLE);
+    Expression *self = expression_pool_get(pool, index);
+    self->variable.name = interned;
+    self->variable.type = program_variable_type(name, length);
+    self->variable.slot = 0;
+    return index;
 }
 
 /// Evaluates the variable expression
-static f64 variable_expression_evaluate(Expression const *self, HashMap const *symbol_table) {
-    Expression *initializer = hash_map_find(symbol_table, self->variable.name);
-    if (initializer) {
-        return expression_evaluate(initializer, symbol_table);
+static f64 variable_expression_evaluate(Expression const *self, Program *program) {
+    if (self->variable.type == VARIABLE_TYPE_INTEGER) {
+        return (f64) program->integers[self->variable.slot];
     }
-    return 0;
+    return program->variables[self->variable.slot];
 }
 
-/// Creates a new function parameter instance
-FunctionParameter *function_parameter_new(MemoryArena *arena, Expression *expression) {
-    FunctionParameter *self = arena_alloc(arena, sizeof(FunctionParameter));
-    self->expression = expression;
-    self->prev = NULL;
-    self->next = NULL;
-    return self;
+/// Evaluates the parameter expression, which reads the argument of the innermost function call
+static f64 parameter_expression_evaluate(Expression const *self, Program *program) {
+    return program->parameters[program->parameter_frame + self->parameter.slot];
 }
 
 /// Creates a new function expression instance
-static Expression *function_expression_new(MemoryArena *arena, char const *name, usize const length) {
-    Expression *self = arena_alloc(arena, sizeof(Expression));
-    self->type = EXPRESSION_FUNCTION;
-
-    memset(self->function.name, 0, sizeof self->function.name);
-    memcpy(self->function.name, name, length);
+static ExpressionIndex function_expression_new(ExpressionPool *pool,
+                                               char const *name,
+                                               usize const length,
+                                               ExpressionIndex const *arguments,
+                                               u32 const argument_count) {
+    ExpressionName const interned = expression_pool_intern(pool, name, length);
+    while (pool->argument_count + argument_count > pool->argument_capacity) {
+        pool->argument_capacity *= 2;
+        pool->arguments = realloc(pool->arguments, pool->argument_capacity * sizeof(ExpressionIndex));
+    }
+    u32 const first = pool->argument_count;
+    if (argument_count > 0) {
+        memcpy(pool->arguments + first, arguments, argument_count * sizeof(ExpressionIndex));
+    }
+    pool->argument_count += argument_count;
 
-    self->function.first_parameter = NULL;
-    self->function.last_parameter = NULL;
-    self->function.parameter_count = 0;
+    ExpressionIndex const index = expression_pool_push(pool, EXPRESSION_FUNCTION);
+    Expression *self = expression_pool_get(pool, index);
+    self->function.name = interned;
+    self->function.slot = 0;
+    self->function.arguments = first;
+    self->function.argument_count = argument_count;
+    return index;
+}
 
-    return self;
+/// Retrieves the arguments of the function or element expression
+static ExpressionIndex *function_expression_arguments(ExpressionPool const *pool, Expression const *self) {
+    return pool->arguments + self->function.arguments;
 }
 
-/// Pushes a parameter to the specified function expression
-static void function_expression_push(MemoryArena *arena, Expression *self, Expression *parameter) {
-    FunctionParameter *entry = function_parameter_new(arena, parameter);
-    FunctionExpression *function = &self->function;
-    if (function->first_parameter == NULL) {
-        function->first_parameter = entry;
-        entry->prev = NULL;
-        function->parameter_count++;
-        return;
-    }
+/// Creates a new element expression instance
+static ExpressionIndex element_expression_new(ExpressionPool *pool,
+                                              char const *name,
+                                              usize const length,
+                                              ExpressionIndex const *indices,
+                                              u32 const index_count) {
+    ExpressionIndex const index = function_expression_new(pool, name, length, indices, index_count);
+    expression_pool_get(pool, index)->type = EXPRESSION_ELEMENT;
+    return index;
+}
 
-    FunctionParameter *tmp = function->first_parameter;
-    while (tmp->next != NULL) {
-        tmp = tmp->next;
+/// Evaluates the indices of the element expression and looks up the element
+static b32 element_expression_locate(Expression const *self, Program *program, u32 *element) {
+    f64 indices[PROGRAM_ARRAY_DIMENSION_MAX];
+    ExpressionIndex const *arguments = function_expression_arguments(&program->expressions, self);
+    for (u32 index = 0; index < self->element.argument_count; ++index) {
+        indices[index] = expression_evaluate(arguments[index], program);
     }
-
-    tmp->next = entry;
-    entry->prev = tmp;
-    function->last_parameter = entry;
-    function->parameter_count++;
+    return program_array_element(program, self->element.slot, indices, self->element.argument_count, element);
 }
 
-/// Retrieves the parameter at the specified index
-static FunctionParameter *function_expression_get_parameter(Expression const *self, usize const index) {
-    FunctionExpression const *function = &self->function;
-    if (function->first_parameter == NULL || index >= function->parameter_count) {
-        return NULL;
+/// Evaluates the specified element expression
+static f64 element_expression_evaluate(Expression const *self, Program *program) {
+    u32 element;
+    if (!element_expression_locate(self, program, &element)) {
+        return 0.0;
     }
+    if (program->arrays[self->element.slot].type == VARIABLE_TYPE_INTEGER) {
+        return (f64) program->integer_elements[element];
+    }
+    return program->real_elements[element];
+}
 
-    usize iterator;
-    usize iterator_limit;
-    FunctionParameter *temp;
-    if (index < (function->parameter_count - index)) {
-        temp = function->first_parameter;
-        iterator_limit = index;
-        for (iterator = 0; temp != NULL && iterator < iterator_limit; ++iterator) {
-            temp = temp->next;
-        }
-    } else {
-        temp = function->last_parameter;
-        iterator_limit = function->parameter_count - index - 1;
-        for (iterator = 0; temp != NULL && iterator < iterator_limit; ++iterator) {
-            temp = temp->prev;
-        }
+/// Evaluates the specified peek expression
+static f64 peek_expression_evaluate(Expression const *self, Program *program) {
+    f64 const address = expression_evaluate(function_expression_arguments(&program->expressions, self)[0], program);
+    f64 result;
+    if (!program_peek(program, address, &result)) {
+        return 0.0;
     }
-    return temp != NULL && iterator == iterator_limit ? temp : NULL;
+    return result;
 }
 
 #define EXPR_PARAM(index) \
-    (expression_evaluate(function_expression_get_parameter(self, index)->expression, symbol_table))
+    (expression_evaluate(function_expression_arguments(&program->expressions, self)[index], program))
 
 /// Evaluates the specified function expression
-static f64 function_expression_evaluate(Expression const *self, HashMap const *symbol_table) {
+static f64 function_expression_evaluate(Expression const *self, Program *program) {
     FunctionExpression const *function = &self->function;
-    FunctionDefinition const *definition = hash_map_find(symbol_table, function->name);
+    FunctionDefinition const *definition = program->functions[function->slot];
     if (definition == NULL) {
+        // The DEF FN statement of the function has not been executed yet
+        program_error(program, "UNDEF'D FUNCTION");
         return 0.0;
     }
 
     switch (definition->type) {
         case FUNCTION_DEFINITION_DYNAMIC: {
-            // NOTE(elias): This is EXTREMELY bad as the arena allocates a 4 Kb block per default, which means
-            // that for every invocation of a user defined function, we have to allocate 4 Kb. Maybe this is an
-            // indicator to transition away from arenas...
-
-            MemoryArena temporary = arena_identity(ALIGNMENT8);
-            Expression *number = number_expression_new(&temporary, EXPR_PARAM(0));
-
-            // TODO(elias): Use dynamic identifier prefix to avoid overwriting variables
-            hash_map_insert(symbol_table, definition->variable.variable->variable.name, number);
-            f64 result = expression_evaluate(definition->variable.body, symbol_table);
-            hash_map_remove(symbol_table, definition->variable.variable->variable.name);
-            arena_destroy(&temporary);
+            // The argument is pushed onto the parameter stack, the stack frame of the call starts
+            // at the argument. Just like in the virtual machine, exhausting the stack stops the program.
+            if (program->parameter_top == PROGRAM_PARAMETER_STACK_SIZE) {
+                program_error(program, "OUT OF MEMORY");
+                return 0.0;
+            }
+            f64 const argument = function->argument_count > 0 ? EXPR_PARAM(0) : 0.0;
+            u32 const frame = program->parameter_frame;
+            program->parameter_frame = program->parameter_top;
+            program->parameters[program->parameter_top++] = argument;
+            f64 const result = expression_evaluate(definition->variable.body, program);
+            program->parameter_top = program->parameter_frame;
+            program->parameter_frame = frame;
             return result;
         }
         case FUNCTION_DEFINITION_BUILTIN: {
-            if (function->parameter_count == definition->builtin.parameter_count) {
-                switch (function->parameter_count) {
+            if (function->argument_count == definition->builtin.parameter_count) {
+                switch (function->argument_count) {
                     case 0:
                         return definition->builtin.func0();
                     case 1:
@@ -186,11 +256,10 @@ static f64 function_expression_evaluate(Expression const *self, HashMap const *s
 #undef EXPR_PARAM
 
 /// Creates a new number expression instance
-static Expression *number_expression_new(MemoryArena *arena, f64 const number) {
-    Expression *self = arena_alloc(arena, sizeof(Expression));
-    self->type = EXPRESSION_NUMBER;
-    self->number = number;
-    return self;
+static ExpressionIndex number_expression_new(ExpressionPool *pool, f64 const number) {
+    ExpressionIndex const index = expression_pool_push(pool, EXPRESSION_NUMBER);
+    expression_pool_get(pool, index)->number = number;
+    return index;
 }
 
 /// Evaluates the specified number expression
@@ -199,117 +268,370 @@ static f64 number_expression_evaluate(Expression const *self) {
 }
 
 /// Creates a new exponential expression instance
-static Expression *exponential_expression_new(MemoryArena *arena, Expression *base, Expression *exponent) {
-    Expression *self = arena_alloc(arena, sizeof(Expression));
-    self->type = EXPRESSION_EXPONENTIAL;
+static ExpressionIndex exponential_expression_new(ExpressionPool *pool,
+                                                  ExpressionIndex const base,
+                                                  ExpressionIndex const exponent) {
+    ExpressionIndex const index = expression_pool_push(pool, EXPRESSION_EXPONENTIAL);
+    Expression *self = expression_pool_get(pool, index);
     self->exponential.base = base;
     self->exponential.exponent = exponent;
-    return self;
+    return index;
 }
 
 /// Evaluates the specified exponential expression
-static f64 exponential_expression_evaluate(Expression const *self, HashMap const *symbol_table) {
-    return pow(expression_evaluate(self->exponential.base, symbol_table),
-               expression_evaluate(self->exponential.exponent, symbol_table));
-}
-
-/// Creates a new string expression by storing the string in the provided arena
-static Expression *string_expression_new(MemoryArena *arena, char const *data, usize const length) {
-    Expression *self = arena_alloc(arena, sizeof(Expression));
-    self->type = EXPRESSION_STRING;
-    self->string.data = arena_alloc(arena, length);
-    self->string.length = length;
-    memcpy(self->string.data, data, length);
-    return self;
+static f64 exponential_expression_evaluate(Expression const *self, Program *program) {
+    return pow(expression_evaluate(self->exponential.base, program),
+               expression_evaluate(self->exponential.exponent, program));
 }
 
-/// Parses an addition or subtraction expression
-static Expression *expression_add_or_sub(MemoryArena *arena, TokenIterator *state);
+/// Creates a new string expression by storing the string in the text of the expression pool
+static ExpressionIndex string_expression_new(ExpressionPool *pool, char const *data, usize const length) {
+    char *text = arena_alloc(&pool->text, length);
+    memcpy(text, data, length);
+    ExpressionIndex const index = expression_pool_push(pool, EXPRESSION_STRING);
+    Expression *self = expression_pool_get(pool, index);
+    self->string.data = text;
+    self->string.length = (u32) length;
+    return index;
+}
+
+/// Evaluates the specified string expression
+static String string_expression_evaluate(Expression const *self) {
+    String result;
+    result.data = self->string.data;
+    result.length = self->string.length;
+    return result;
+}
+
+enum {
+    STRING_FUNCTION_PARAMETER_MAX = 3
+};
+
+/// The signature of a string function, only the first parameter may be a string
+typedef struct StringFunctionSignature {
+    char const *name;
+    u32 minimum;
+    u32 maximum;
+    b32 string_parameter;
+} StringFunctionSignature;
+
+static StringFunctionSignature const string_functions[STRING_FUNCTION_COUNT] = {
+    [STRING_FUNCTION_LEN] = { .name = "LEN", .minimum = 1, .maximum = 1, .string_parameter = true },
+    [STRING_FUNCTION_LEFT] = { .name = "LEFT$", .minimum = 2, .maximum = 2, .string_parameter = true },
+    [STRING_FUNCTION_RIGHT] = { .name = "RIGHT$", .minimum = 2, .maximum = 2, .string_parameter = true },
+    [STRING_FUNCTION_MID] = { .name = "MID$", .minimum = 2, .maximum = 3, .string_parameter = true },
+    [STRING_FUNCTION_STR] = { .name = "STR$", .minimum = 1, .maximum = 1, .string_parameter = false },
+    [STRING_FUNCTION_CHR] = { .name = "CHR$", .minimum = 1, .maximum = 1, .string_parameter = false },
+    [STRING_FUNCTION_ASC] = { .name = "ASC", .minimum = 1, .maximum = 1, .string_parameter = true },
+    [STRING_FUNCTION_VAL] = { .name = "VAL", .minimum = 1, .maximum = 1, .string_parameter = true }
+};
+
+/// Looks up the string function with the specified name
+static StringFunction string_function_find(char const *name) {
+    for (u32 function = 0; function < STRING_FUNCTION_COUNT; ++function) {
+        if (strcmp(string_functions[function].name, name) == 0) {
+            return (StringFunction) function;
+        }
+    }
+    return STRING_FUNCTION_COUNT;
+}
+
+/// Checks if the string function returns a string
+static b32 string_function_returns_string(StringFunction const function) {
+    char const *name = string_functions[function].name;
+    return name[strlen(name) - 1] == '$';
+}
+
+/// Converts the argument to an integer in the specified range, the program is stopped if it is out of range
+static b32 string_function_quantity(Program *program,
+                                    f64 const value,
+                                    u32 const minimum,
+                                    u32 const maximum,
+                                    u32 *result) {
+    f64 const truncated = trunc(value);
+    if (!(truncated >= minimum && truncated <= maximum)) {
+        program_error(program, "ILLEGAL QUANTITY");
+        return false;
+    }
+    *result = (u32) truncated;
+    return true;
+}
+
+/// Applies a string function that returns a string
+static String string_function_string(Program *program,
+                                     StringFunction const function,
+                                     String const *strings,
+                                     f64 const *numbers,
+                                     u32 const count) {
+    // Substrings refer to the characters of their argument, only strings that are built from numbers are allocated
+    String result = { "", 0 };
+    u32 length;
+    switch (function) {
+        case STRING_FUNCTION_LEFT:
+            if (string_function_quantity(program, numbers[1], 1, STRING_LENGTH_MAX, &length)) {
+                result.data = strings[0].data;
+                result.length = length < strings[0].length ? length : strings[0].length;
+            }
+            break;
+        case STRING_FUNCTION_RIGHT:
+            if (string_function_quantity(program, numbers[1], 1, STRING_LENGTH_MAX, &length)) {
+                result.length = length < strings[0].length ? length : strings[0].length;
+                result.data = strings[0].data + strings[0].length - result.length;
+            }
+            break;
+        case STRING_FUNCTION_MID: {
+            u32 start;
+            length = STRING_LENGTH_MAX;
+            if (!string_function_quantity(program, numbers[1], 1, STRING_LENGTH_MAX, &start) ||
+                (count > 2 && !string_function_quantity(program, numbers[2], 0, STRING_LENGTH_MAX, &length))) {
+                break;
+            }
+            if (start <= strings[0].length) {
+                u32 const remaining = strings[0].length - (start - 1);
+                result.data = strings[0].data + (start - 1);
+                result.length = length < remaining ? length : remaining;
+            }
+            break;
+        }
+        case STRING_FUNCTION_STR: {
+            char buffer[32];
+            s32 const written = snprintf(buffer, sizeof buffer, "%.9g", numbers[0]);
+            char *data = program_temporary_string(program, (u32) written);
+            if (data != NULL) {
+                memcpy(data, buffer, (usize) written);
+                result.data = data;
+                result.length = (u32) written;
+            }
+            break;
+        }
+        case STRING_FUNCTION_CHR: {
+            u32 code;
+            char *data;
+            if (string_function_quantity(program, numbers[0], 0, 255, &code) &&
+                (data = program_temporary_string(program, 1)) != NULL) {
+                data[0] = (char) code;
+                result.data = data;
+                result.length = 1;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+    return result;
+}
+
+/// Applies a string function that returns a number
+static f64 string_function_number(Program *program,
+                                  StringFunction const function,
+                                  String const *strings,
+                                  f64 const *numbers,
+                                  u32 const count) {
+    (void) numbers;
+    (void) count;
+    switch (function) {
+        case STRING_FUNCTION_LEN:
+            return (f64) strings[0].length;
+        case STRING_FUNCTION_ASC:
+            if (strings[0].length == 0) {
+                program_error(program, "ILLEGAL QUANTITY");
+                return 0.0;
+            }
+            return (f64) (u8) strings[0].data[0];
+        case STRING_FUNCTION_VAL: {
+            // The string is not terminated, so it is copied into a terminated buffer first
+            char buffer[TOKEN_NUMBER_LENGTH];
+            usize const length = strings[0].length < sizeof buffer - 1 ? strings[0].length : sizeof buffer - 1;
+            if (length > 0) {
+                memcpy(buffer, strings[0].data, length);
+            }
+            buffer[length] = '\0';
+            return strtod(buffer, NULL);
+        }
+        default:
+            return 0.0;
+    }
+}
+
+/// Compares two strings character by character
+static s32 string_compare(String const left, String const right) {
+    u32 const length = left.length < right.length ? left.length : right.length;
+    s32 const order = length > 0 ? memcmp(left.data, right.data, length) : 0;
+    if (order != 0) {
+        return order;
+    }
+    return left.length == right.length ? 0 : (left.length < right.length ? -1 : 1);
+}
+
+/// Concatenates two strings into a temporary string
+static String string_concatenate(Program *program, String const left, String const right) {
+    if (left.length + right.length > STRING_LENGTH_MAX) {
+        program_error(program, "STRING TOO LONG");
+        return left;
+    }
+    if (left.length == 0 || right.length == 0) {
+        return left.length == 0 ? right : left;
+    }
+    char *data = program_temporary_string(program, left.length + right.length);
+    if (data == NULL) {
+        return left;
+    }
+    memcpy(data, left.data, left.length);
+    memcpy(data + left.length, right.data, right.length);
+    String result;
+    result.data = data;
+    result.length = left.length + right.length;
+    return result;
+}
+
+/// Evaluates the arguments of a string function call into the argument arrays
+static u32 string_function_expression_arguments(Expression const *self,
+                                                Program *program,
+                                                String *strings,
+                                                f64 *numbers) {
+    ExpressionIndex const *arguments = function_expression_arguments(&program->expressions, self);
+    for (u32 index = 0; index < self->function.argument_count; ++index) {
+        if (expression_is_string(&program->expressions, arguments[index])) {
+            strings[index] = expression_evaluate_string(arguments[index], program);
+        } else {
+            numbers[index] = expression_evaluate(arguments[index], program);
+        }
+    }
+    return self->function.argument_count;
+}
+
+/// Evaluates a call of a string function that returns a number
+static f64 string_function_expression_evaluate(Expression const *self, Program *program) {
+    String strings[STRING_FUNCTION_PARAMETER_MAX];
+    f64 numbers[STRING_FUNCTION_PARAMETER_MAX];
+    u32 const count = string_function_expression_arguments(self, program, strings, numbers);
+    return string_function_number(program, (StringFunction) self->function.slot, strings, numbers, count);
+}
+
+/// Parses a disjunction, which is the expression of the lowest precedence
+static ExpressionIndex expression_or(ExpressionPool *pool, TokenIterator *state);
 
 /// Parses a unary-plus-or-minus expression
-static Expression *expression_unary_plus_or_minus(MemoryArena *arena, TokenIterator *state);
+static ExpressionIndex expression_unary_plus_or_minus(ExpressionPool *pool, TokenIterator *state);
 
 /// Parses an exponential expression
-static Expression *expression_exponential(MemoryArena *arena, TokenIterator *state, Expression *base) {
+static ExpressionIndex expression_exponential(ExpressionPool *pool, TokenIterator *state, ExpressionIndex base) {
     if (token_iterator_current(state)->type == TOKEN_CIRCUMFLEX) {
         token_iterator_advance(state);
-        return exponential_expression_new(arena, base, expression_unary_plus_or_minus(arena, state));
+        return exponential_expression_new(pool, base, expression_unary_plus_or_minus(pool, state));
     }
     return base;
 }
 
+/// Parses the parenthesized arguments of a function or the indices of an element. Nested calls are
+/// parsed before the arguments are copied into the pool, so that the arguments of a call stay contiguous.
+static b32 expression_arguments(ExpressionPool *pool, TokenIterator *state, ExpressionIndex *arguments, u32 *count) {
+    token_iterator_advance(state);
+    *count = 0;
+    if (token_iterator_current(state)->type != TOKEN_RIGHT_PARENTHESIS) {
+        for (;;) {
+            ExpressionIndex parameter = expression_or(pool, state);
+            if (!parameter || *count == EXPRESSION_ARGUMENT_MAX) {
+                return false;
+            }
+            arguments[(*count)++] = parameter;
+            if (token_iterator_current(state)->type != TOKEN_COMMA) {
+                break;
+            }
+            token_iterator_advance(state);
+        }
+    }
+    if (token_iterator_current(state)->type != TOKEN_RIGHT_PARENTHESIS) {
+        return false;
+    }
+    token_iterator_advance(state);
+    return true;
+}
+
 /// Parses a primary expression, that includes numbers, variables and functions
-static Expression *expression_primary(MemoryArena *arena, TokenIterator *state) {
+static ExpressionIndex expression_primary(ExpressionPool *pool, TokenIterator *state) {
     if (token_iterator_current(state)->type == TOKEN_NUMBER ||
         token_iterator_current(state)->type == TOKEN_NUMBER_FLOAT) {
         Token const *number_token = token_iterator_current(state);
         token_iterator_advance(state);
 
-        char *number_begin = number_token->lexeme;
-        char *number_end = number_begin + number_token->length;
-        f64 const value = strtod(number_begin, &number_end);
-        Expression *number = number_expression_new(arena, value);
-        return expression_exponential(arena, state, number);
+        f64 const value = token_iterator_number(state, number_token);
+        ExpressionIndex number = number_expression_new(pool, value);
+        return expression_exponential(pool, state, number);
+    }
+    if (token_iterator_current(state)->type == TOKEN_STRING) {
+        Token const *string_token = token_iterator_current(state);
+        if (string_token->length > STRING_LENGTH_MAX) {
+            return EXPRESSION_NONE;
+        }
+        token_iterator_advance(state);
+
+        char const *lexeme = token_iterator_lexeme(state, string_token);
+        ExpressionIndex string = string_expression_new(pool, lexeme, string_token->length);
+        return expression_exponential(pool, state, string);
     }
     if (token_iterator_current(state)->type == TOKEN_IDENTIFIER) {
         Token const *text_token = token_iterator_current(state);
+        char const *text = token_iterator_lexeme(state, text_token);
         token_iterator_advance(state);
 
-        // function expression
+        // function expression, which may also turn out to be an array element once it is resolved
         if (token_iterator_current(state) && token_iterator_current(state)->type == TOKEN_LEFT_PARENTHESIS) {
-            Expression *function = function_expression_new(arena, text_token->lexeme, text_token->length);
-            token_iterator_advance(state);
-            function_expression_push(arena, function, expression_add_or_sub(arena, state));
-            while (token_iterator_current(state)->type == TOKEN_COMMA) {
-                function_expression_push(arena, function, expression_add_or_sub(arena, state));
+            ExpressionIndex arguments[EXPRESSION_ARGUMENT_MAX];
+            u32 count;
+            if (!expression_arguments(pool, state, arguments, &count)) {
+                return EXPRESSION_NONE;
             }
-            return expression_exponential(arena, state, function);
+            ExpressionIndex function = function_expression_new(pool, text, text_token->length, arguments, count);
+            return expression_exponential(pool, state, function);
         }
 
         // variable expression
-        Expression *variable = variable_expression_new(arena, text_token->lexeme, text_token->length);
-        return expression_exponential(arena, state, variable);
+        ExpressionIndex variable = variable_expression_new(pool, text, text_token->length);
+        return expression_exponential(pool, state, variable);
     }
     if (token_iterator_current(state)->type == TOKEN_LEFT_PARENTHESIS) {
         token_iterator_advance(state);
 
-        Expression *inner = expression_add_or_sub(arena, state);
-        if (token_iterator_current(state)->type != TOKEN_RIGHT_PARENTHESIS) {
+        ExpressionIndex inner = expression_or(pool, state);
+        if (inner == EXPRESSION_NONE || token_iterator_current(state)->type != TOKEN_RIGHT_PARENTHESIS) {
             // we need some sort of error callback here
-            return NULL;
+            return EXPRESSION_NONE;
         }
         token_iterator_advance(state);
-        return expression_exponential(arena, state, inner);
+        return expression_exponential(pool, state, inner);
     }
 
     // end of input
-    return NULL;
+    return EXPRESSION_NONE;
 }
 
-/// Parses a unary-plus-or-minus expression
-static Expression *expression_unary_plus_or_minus(MemoryArena *arena, TokenIterator *state) {
-    if (token_iterator_current(state)->type == TOKEN_PLUS || token_iterator_current(state)->type == TOKEN_MINUS) {
-        Operator const operator= token_iterator_current(state)->type == TOKEN_PLUS ? OPERATOR_ADD : OPERATOR_SUB;
+/// Parses a unary-plus-or-minus expression, NOT has the same precedence as the signs
+static ExpressionIndex expression_unary_plus_or_minus(ExpressionPool *pool, TokenIterator *state) {
+    TokenType const type = token_iterator_current(state)->type;
+    if (type == TOKEN_PLUS || type == TOKEN_MINUS || type == TOKEN_NOT) {
+        Operator const operator= type == TOKEN_PLUS ? OPERATOR_ADD
+                                                    : (type == TOKEN_MINUS ? OPERATOR_SUB : OPERATOR_NOT);
         token_iterator_advance(state);
 
-        Expression *inner = expression_unary_plus_or_minus(arena, state);
+        ExpressionIndex inner = expression_unary_plus_or_minus(pool, state);
         if (!inner) {
-            return NULL;
+            return EXPRESSION_NONE;
         }
 
-        return unary_expression_new(arena, operator, inner);
+        return unary_expression_new(pool, operator, inner);
     }
-    return expression_primary(arena, state);
+    return expression_primary(pool, state);
 }
 
 /// Parses a multiplication or division expression
-static Expression *expression_mul_or_div(MemoryArena *arena, TokenIterator *state) {
+static ExpressionIndex expression_mul_or_div(ExpressionPool *pool, TokenIterator *state) {
     // The first term in the multiplication or division can be an
     // expression of higher precedence, which are all contained by
     // unary plus or minus expressions
-    Expression *left = expression_unary_plus_or_minus(arena, state);
+    ExpressionIndex left = expression_unary_plus_or_minus(pool, state);
     if (!left) {
-        return NULL;
+        return EXPRESSION_NONE;
     }
 
     // In the next step, we try to consume either a plus or minus sign
@@ -320,26 +642,26 @@ static Expression *expression_mul_or_div(MemoryArena *arena, TokenIterator *stat
 
         // On the right side of the expression, we again try to parse an expression
         // of higher precedence
-        Expression *right = expression_unary_plus_or_minus(arena, state);
+        ExpressionIndex right = expression_unary_plus_or_minus(pool, state);
         if (!right) {
-            return NULL;
+            return EXPRESSION_NONE;
         }
 
         // Reassign the subexpression to the previous subexpression, as it then contains all previous subexpressions
-        left = binary_expression_new(arena, left, right, operator);
+        left = binary_expression_new(pool, left, right, operator);
     }
     return left;
 }
 
 /// Parses an addition or subtraction expression
-static Expression *expression_add_or_sub(MemoryArena *arena, TokenIterator *state) {
+static ExpressionIndex expression_add_or_sub(ExpressionPool *pool, TokenIterator *state) {
     // The first term in the addition or subtraction can be an
     // expression of higher precedence, they are all handled by
     // multiplication or division as it is next in the
     // precedence hierarchy
-    Expression *left = expression_mul_or_div(arena, state);
+    ExpressionIndex left = expression_mul_or_div(pool, state);
     if (!left) {
-        return NULL;
+        return EXPRESSION_NONE;
     }
 
     // In the next step, we try to consume either a plus or minus sign
@@ -348,62 +670,582 @@ static Expression *expression_add_or_sub(MemoryArena *arena, TokenIterator *stat
         token_iterator_advance(state);
 
         // On the right side of the plus or minus sign, we again try to parse an expression of higher precedence
-        Expression *right = expression_mul_or_div(arena, state);
+        ExpressionIndex right = expression_mul_or_div(pool, state);
         if (!right) {
-            return NULL;
+            return EXPRESSION_NONE;
         }
 
         // Reassign the subexpression to the previous subexpression, as it then contains all previous subexpressions
-        left = binary_expression_new(arena, left, right, operator);
+        left = binary_expression_new(pool, left, right, operator);
+    }
+    return left;
+}
+
+/// Maps the relational operator at the current token to its operator, the operator may consist of two
+/// tokens, e.g. <= or <>
+static b32 expression_relational_operator(TokenIterator *state, Operator *operator) {
+    TokenType const first = token_iterator_current(state)->type;
+    if (first != TOKEN_LESS_THAN && first != TOKEN_GREATER_THAN && first != TOKEN_EQUAL_SIGN) {
+        return false;
+    }
+    token_iterator_advance(state);
+
+    TokenType const second = token_iterator_current(state)->type;
+    b32 const less = first == TOKEN_LESS_THAN || second == TOKEN_LESS_THAN;
+    b32 const greater = first == TOKEN_GREATER_THAN || second == TOKEN_GREATER_THAN;
+    b32 const equal = first == TOKEN_EQUAL_SIGN || second == TOKEN_EQUAL_SIGN;
+    if (second != first && (second == TOKEN_LESS_THAN || second == TOKEN_GREATER_THAN || second == TOKEN_EQUAL_SIGN)) {
+        token_iterator_advance(state);
+    }
+
+    if (less && greater) {
+        *operator= OPERATOR_NOT_EQUAL;
+    } else if (less) {
+        *operator= equal ? OPERATOR_LESS_EQUAL : OPERATOR_LESS;
+    } else if (greater) {
+        *operator= equal ? OPERATOR_GREATER_EQUAL : OPERATOR_GREATER;
+    } else {
+        *operator= OPERATOR_EQUAL;
+    }
+    return true;
+}
+
+/// Parses a comparison, comparisons are left associative like arithmetic operators
+static ExpressionIndex expression_relational(ExpressionPool *pool, TokenIterator *state) {
+    ExpressionIndex left = expression_add_or_sub(pool, state);
+    if (!left) {
+        return EXPRESSION_NONE;
+    }
+
+    Operator operator;
+    while (expression_relational_operator(state, &operator)) {
+        ExpressionIndex right = expression_add_or_sub(pool, state);
+        if (!right) {
+            return EXPRESSION_NONE;
+        }
+        left = binary_expression_new(pool, left, right, operator);
+    }
+    return left;
+}
+
+/// Parses a conjunction
+static ExpressionIndex expression_and(ExpressionPool *pool, TokenIterator *state) {
+    ExpressionIndex left = expression_relational(pool, state);
+    if (!left) {
+        return EXPRESSION_NONE;
+    }
+    while (token_iterator_current(state)->type == TOKEN_AND) {
+        token_iterator_advance(state);
+        ExpressionIndex right = expression_relational(pool, state);
+        if (!right) {
+            return EXPRESSION_NONE;
+        }
+        left = binary_expression_new(pool, left, right, OPERATOR_AND);
     }
     return left;
 }
 
-static Expression *expression_arithmetic_or_final(MemoryArena *arena, TokenIterator *state) {
-    Token const *current = token_iterator_current(state);
-    if (current->type == TOKEN_STRING) {
-        return string_expression_new(arena, current->lexeme, current->length);
+/// Parses a disjunction, which is the expression of the lowest precedence
+static ExpressionIndex expression_or(ExpressionPool *pool, TokenIterator *state) {
+    ExpressionIndex left = expression_and(pool, state);
+    if (!left) {
+        return EXPRESSION_NONE;
     }
-    return expression_add_or_sub(arena, state);
+    while (token_iterator_current(state)->type == TOKEN_OR) {
+        token_iterator_advance(state);
+        ExpressionIndex right = expression_and(pool, state);
+        if (!right) {
+            return EXPRESSION_NONE;
+        }
+        left = binary_expression_new(pool, left, right, OPERATOR_OR);
+    }
+    return left;
 }
 
 /// Compiles an expression from a list of tokens
-static Expression *expression_compile(MemoryArena *arena, Token *begin, Token *end) {
-    TokenIterator state = { 0 };
-    state.current = begin;
-    state.end = end;
-    return expression_arithmetic_or_final(arena, &state);
+static ExpressionIndex expression_compile(ExpressionPool *pool, TokenIterator *tokens) {
+    return expression_or(pool, tokens);
+}
+
+/// Compiles an array element of the form <identifier>(<index>, ...)
+static ExpressionIndex expression_compile_element(ExpressionPool *pool, TokenIterator *tokens) {
+    Token const *name_token = token_iterator_current(tokens);
+    if (name_token->type != TOKEN_IDENTIFIER || token_iterator_next(tokens)->type != TOKEN_LEFT_PARENTHESIS) {
+        return EXPRESSION_NONE;
+    }
+    token_iterator_advance(tokens);
+
+    ExpressionIndex indices[EXPRESSION_ARGUMENT_MAX];
+    u32 count;
+    if (!expression_arguments(pool, tokens, indices, &count)) {
+        return EXPRESSION_NONE;
+    }
+    char const *name = token_iterator_lexeme(tokens, name_token);
+    return element_expression_new(pool, name, name_token->length, indices, count);
 }
 
 /// Evaluates the specified expression
-static f64 expression_evaluate(Expression const *self, HashMap const *symbol_table) {
-    assert(expression_is_arithmetic(self) && "expression must be arithmetic for evaluation!");
+static f64 expression_evaluate(ExpressionIndex const index, Program *program) {
+    assert(expression_is_arithmetic(&program->expressions, index) && "expression must be arithmetic for evaluation!");
 
+    Expression const *self = expression_pool_get(&program->expressions, index);
     switch (self->type) {
         case EXPRESSION_BINARY:
-            return binary_expression_evaluate(self, symbol_table);
+            return binary_expression_evaluate(self, program);
         case EXPRESSION_NUMBER:
             return number_expression_evaluate(self);
         case EXPRESSION_VARIABLE:
-            return variable_expression_evaluate(self, symbol_table);
+            return variable_expression_evaluate(self, program);
         case EXPRESSION_FUNCTION:
-            return function_expression_evaluate(self, symbol_table);
+            return function_expression_evaluate(self, program);
         case EXPRESSION_UNARY:
-            return unary_expression_evaluate(self, symbol_table);
+            return unary_expression_evaluate(self, program);
         case EXPRESSION_EXPONENTIAL:
-            return exponential_expression_evaluate(self, symbol_table);
+            return exponential_expression_evaluate(self, program);
+        case EXPRESSION_PARAMETER:
+            return parameter_expression_evaluate(self, program);
+        case EXPRESSION_STRING_FUNCTION:
+            return string_function_expression_evaluate(self, program);
+        case EXPRESSION_ELEMENT:
+            return element_expression_evaluate(self, program);
+        case EXPRESSION_PEEK:
+            return peek_expression_evaluate(self, program);
         default:
             break;
     }
     return 0.0;
 }
 
+/// Evaluates the specified expression, which must be a string expression
+static String expression_evaluate_string(ExpressionIndex const index, Program *program) {
+    assert(expression_is_string(&program->expressions, index) && "expression must be a string for evaluation!");
+
+    Expression const *self = expression_pool_get(&program->expressions, index);
+    switch (self->type) {
+        case EXPRESSION_STRING:
+            return string_expression_evaluate(self);
+        case EXPRESSION_VARIABLE:
+            return program->strings[self->variable.slot];
+        case EXPRESSION_BINARY:
+            return string_concatenate(program, expression_evaluate_string(self->binary.left, program),
+                                      expression_evaluate_string(self->binary.right, program));
+        case EXPRESSION_STRING_FUNCTION: {
+            String strings[STRING_FUNCTION_PARAMETER_MAX];
+            f64 numbers[STRING_FUNCTION_PARAMETER_MAX];
+            u32 const count = string_function_expression_arguments(self, program, strings, numbers);
+            return string_function_string(program, (StringFunction) self->function.slot, strings, numbers, count);
+        }
+        case EXPRESSION_ELEMENT: {
+            u32 element;
+            if (!element_expression_locate(self, program, &element)) {
+                String const empty = { "", 0 };
+                return empty;
+            }
+            return program->string_elements[element];
+        }
+        default: {
+            String const empty = { "", 0 };
+            return empty;
+        }
+    }
+}
+
 /// Checks if an expression is arithmetic
-static b32 expression_is_arithmetic(Expression const *self) {
+static b32 expression_is_arithmetic(ExpressionPool const *pool, ExpressionIndex const index) {
+    return !expression_is_string(pool, index);
+}
+
+/// Checks if an expression yields a string
+static b32 expression_is_string(ExpressionPool const *pool, ExpressionIndex const index) {
+    Expression const *self = expression_pool_get(pool, index);
     switch (self->type) {
         case EXPRESSION_STRING:
+            return true;
+        case EXPRESSION_VARIABLE:
+            return self->variable.type == VARIABLE_TYPE_STRING;
+        case EXPRESSION_BINARY:
+            // Both operands have the same type in valid expressions, strings are only concatenated or compared
+            return self->binary.operator== OPERATOR_ADD && expression_is_string(pool, self->binary.left);
+        case EXPRESSION_FUNCTION:
+        case EXPRESSION_STRING_FUNCTION:
+        case EXPRESSION_ELEMENT: {
+            char const *name = expression_pool_name(pool, self->function.name);
+            usize const length = strlen(name);
+            return length > 0 && name[length - 1] == '$';
+        }
+        default:
+            return false;
+    }
+}
+
+/// Resolves the slots of the arguments of a function or the indices of an element
+static b32 expression_resolve_arguments(Expression const *self, Program *program, ExpressionName const parameter) {
+    ExpressionIndex const *arguments = function_expression_arguments(&program->expressions, self);
+    b32 changed = false;
+    for (u32 index = 0; index < self->function.argument_count; ++index) {
+        changed |= expression_resolve(arguments[index], program, parameter);
+    }
+    return changed;
+}
+
+/// Resolves the slots of all variables and functions that are referenced by the expression
+static b32 expression_resolve(ExpressionIndex const index, Program *program, ExpressionName const parameter) {
+    Expression *self = expression_pool_get(&program->expressions, index);
+    switch (self->type) {
+        case EXPRESSION_BINARY:
+            return expression_resolve(self->binary.left, program, parameter) |
+                   expression_resolve(self->binary.right, program, parameter);
+        case EXPRESSION_VARIABLE:
+            if (parameter != EXPRESSION_NAME_NONE && self->variable.name == parameter) {
+                // Functions only have a single parameter, which is the first one in the frame
+                self->type = EXPRESSION_PARAMETER;
+                self->parameter.slot = 0;
+            } else {
+                self->variable.slot = program_variable_slot(program, self->variable.name);
+            }
             return false;
+        case EXPRESSION_FUNCTION:
+        case EXPRESSION_ELEMENT: {
+            // PEEK and the string functions are bound at compile time, the slot then names the string function.
+            // Calls and elements share their syntax, only builtins and functions that are defined by DEF FN are
+            // called, any other name refers to an array. Lines are resolved again once the whole program is known.
+            char const *name = expression_pool_name(&program->expressions, self->function.name);
+            StringFunction const function = string_function_find(name);
+            ExpressionType const type = self->type;
+            if (strcmp(name, "PEEK") == 0) {
+                self->type = EXPRESSION_PEEK;
+            } else if (function != STRING_FUNCTION_COUNT) {
+                self->type = EXPRESSION_STRING_FUNCTION;
+                self->function.slot = (u32) function;
+            } else if (program_variable_type(name, strlen(name)) == VARIABLE_TYPE_REAL &&
+                       program_function_exists(program, self->function.name)) {
+                self->type = EXPRESSION_FUNCTION;
+                self->function.slot = program_function_slot(program, self->function.name);
+            } else {
+                self->type = EXPRESSION_ELEMENT;
+                self->element.slot = program_array_slot(program, self->element.name);
+            }
+            return expression_resolve_arguments(self, program, parameter) | (self->type != type);
+        }
+        case EXPRESSION_STRING_FUNCTION:
+        case EXPRESSION_PEEK:
+            return expression_resolve_arguments(self, program, parameter);
+        case EXPRESSION_UNARY:
+            return expression_resolve(self->unary.expression, program, parameter);
+        case EXPRESSION_EXPONENTIAL:
+            return expression_resolve(self->exponential.base, program, parameter) |
+                   expression_resolve(self->exponential.exponent, program, parameter);
+        default:
+            return false;
+    }
+}
+
+/// Resolves the slots of the target of an assignment or a DIM statement, an element target always
+/// refers to an array, even if a function with the same name exists
+static b32 expression_resolve_target(ExpressionIndex const index, Program *program) {
+    Expression *self = expression_pool_get(&program->expressions, index);
+    if (self->type != EXPRESSION_ELEMENT) {
+        return expression_resolve(index, program, EXPRESSION_NAME_NONE);
+    }
+    self->element.slot = program_array_slot(program, self->element.name);
+    return expression_resolve_arguments(self, program, EXPRESSION_NAME_NONE);
+}
+
+/// Checks that the arguments of a function or the indices of an element have the correct type, only
+/// the first argument is a string if string is set
+static char const *expression_check_arguments(ExpressionPool const *pool, Expression const *self, b32 const string) {
+    ExpressionIndex const *arguments = function_expression_arguments(pool, self);
+    for (u32 index = 0; index < self->function.argument_count; ++index) {
+        char const *error = expression_check(pool, arguments[index]);
+        if (error != NULL) {
+            return error;
+        }
+        if (expression_is_string(pool, arguments[index]) != (index == 0 && string)) {
+            return "Expression has operands of mismatching types";
+        }
+    }
+    return NULL;
+}
+
+/// Checks that the operands of all operators and the arguments of all functions have the correct type
+static char const *expression_check(ExpressionPool const *pool, ExpressionIndex const index) {
+    static char const *mismatch = "Expression has operands of mismatching types";
+    Expression const *self = expression_pool_get(pool, index);
+    char const *error = NULL;
+    switch (self->type) {
+        case EXPRESSION_UNARY:
+            if ((error = expression_check(pool, self->unary.expression)) == NULL &&
+                expression_is_string(pool, self->unary.expression)) {
+                error = mismatch;
+            }
+            break;
+        case EXPRESSION_BINARY: {
+            if ((error = expression_check(pool, self->binary.left)) != NULL ||
+                (error = expression_check(pool, self->binary.right)) != NULL) {
+                break;
+            }
+            // Strings can only be concatenated and compared
+            Operator const operator= self->binary.operator;
+            b32 const string = expression_is_string(pool, self->binary.left);
+            if (string != expression_is_string(pool, self->binary.right) ||
+                (string && operator!= OPERATOR_ADD && !operator_is_relational(operator))) {
+                error = mismatch;
+            }
+            break;
+        }
+        case EXPRESSION_EXPONENTIAL:
+            if ((error = expression_check(pool, self->exponential.base)) != NULL ||
+                (error = expression_check(pool, self->exponential.exponent)) != NULL) {
+                break;
+            }
+            if (expression_is_string(pool, self->exponential.base) ||
+                expression_is_string(pool, self->exponential.exponent)) {
+                error = mismatch;
+            }
+            break;
+        case EXPRESSION_FUNCTION:
+            if (expression_is_string(pool, index)) {
+                return "Expression calls an unknown string function";
+            }
+            error = expression_check_arguments(pool, self, false);
+            break;
+        case EXPRESSION_STRING_FUNCTION: {
+            StringFunctionSignature const *signature = string_functions + self->function.slot;
+            if (self->function.argument_count < signature->minimum ||
+                self->function.argument_count > signature->maximum) {
+                return "String function is called with a wrong number of arguments";
+            }
+            error = expression_check_arguments(pool, self, signature->string_parameter);
+            break;
+        }
+        case EXPRESSION_PEEK:
+            if (self->function.argument_count != 1) {
+                return "PEEK is called with a wrong number of arguments";
+            }
+            error = expression_check_arguments(pool, self, false);
+            break;
+        case EXPRESSION_ELEMENT:
+            if (self->element.argument_count == 0 || self->element.argument_count > PROGRAM_ARRAY_DIMENSION_MAX) {
+                return "Array element has a wrong number of indices";
+            }
+            error = expression_check_arguments(pool, self, false);
+            break;
         default:
+            break;
+    }
+    return error;
+}
+
+/// Checks if the expression can be evaluated any number of times without changing the result or the program state
+static b32 expression_is_pure(ExpressionIndex const index, Program const *program) {
+    Expression const *self = expression_pool_get(&program->expressions, index);
+    switch (self->type) {
+        case EXPRESSION_NUMBER:
+        case EXPRESSION_VARIABLE:
+        case EXPRESSION_PARAMETER:
             return true;
+        case EXPRESSION_UNARY:
+            return expression_is_pure(self->unary.expression, program);
+        case EXPRESSION_BINARY:
+            return expression_is_pure(self->binary.left, program) && expression_is_pure(self->binary.right, program);
+        case EXPRESSION_EXPONENTIAL:
+            return expression_is_pure(self->exponential.base, program) &&
+                   expression_is_pure(self->exponential.exponent, program);
+        case EXPRESSION_FUNCTION:
+        case EXPRESSION_ELEMENT: {
+            // Reading an element has no side effects, except for dimensioning the array the first time
+            if (self->type == EXPRESSION_FUNCTION) {
+                FunctionDefinition const *definition = program->functions[self->function.slot];
+                if (definition == NULL || definition->type != FUNCTION_DEFINITION_BUILTIN ||
+                    !definition->builtin.pure) {
+                    return false;
+                }
+            }
+            ExpressionIndex const *arguments = function_expression_arguments(&program->expressions, self);
+            for (u32 argument = 0; argument < self->function.argument_count; ++argument) {
+                if (!expression_is_pure(arguments[argument], program)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+/// Checks if the expression is a number, whose value is then stored in number
+static b32 expression_is_number(ExpressionPool const *pool, ExpressionIndex const index, f64 *number) {
+    Expression const *self = expression_pool_get(pool, index);
+    if (self->type != EXPRESSION_NUMBER) {
+        return false;
+    }
+    *number = self->number;
+    return true;
+}
+
+/// Builds a multiplication chain for the power by repeated squaring, the squares use the same node
+/// as both operands, so that the virtual machine only evaluates them once
+static ExpressionIndex expression_fold_power(ExpressionPool *pool, ExpressionIndex const base, u32 exponent) {
+    ExpressionIndex result = EXPRESSION_NONE;
+    ExpressionIndex square = base;
+    for (;;) {
+        if (exponent & 1) {
+            result = result == EXPRESSION_NONE ? square : binary_expression_new(pool, result, square, OPERATOR_MUL);
+        }
+        exponent >>= 1;
+        if (exponent == 0) {
+            return result;
+        }
+        square = binary_expression_new(pool, square, square, OPERATOR_MUL);
+    }
+}
+
+/// Folds a unary expression. Folding creates nodes, which moves the nodes of the pool, so nodes are
+/// looked up again after every subexpression has been folded.
+static ExpressionIndex expression_fold_unary(ExpressionIndex const self, Program *program) {
+    ExpressionPool *pool = &program->expressions;
+    ExpressionIndex const inner = expression_fold(expression_pool_get(pool, self)->unary.expression, program);
+    Operator const operator= expression_pool_get(pool, self)->unary.operator;
+    if (operator== OPERATOR_ADD) {
+        return inner;
+    }
+    f64 value;
+    if (expression_is_number(pool, inner, &value)) {
+        return number_expression_new(pool, operator== OPERATOR_NOT ? (value == 0.0 ? 1.0 : 0.0) : -value);
+    }
+    Expression const *folded = expression_pool_get(pool, inner);
+    if (operator== OPERATOR_SUB && folded->type == EXPRESSION_UNARY && folded->unary.operator== OPERATOR_SUB) {
+        // Unary plus is always dropped, so only double negations remain
+        return folded->unary.expression;
+    }
+    expression_pool_get(pool, self)->unary.expression = inner;
+    return self;
+}
+
+/// Folds a binary expression
+static ExpressionIndex expression_fold_binary(ExpressionIndex const self, Program *program) {
+    ExpressionPool *pool = &program->expressions;
+    ExpressionIndex const left = expression_fold(expression_pool_get(pool, self)->binary.left, program);
+    ExpressionIndex const right = expression_fold(expression_pool_get(pool, self)->binary.right, program);
+    Operator const operator= expression_pool_get(pool, self)->binary.operator;
+    f64 left_number = 0.0;
+    f64 right_number = 0.0;
+    b32 const left_constant = expression_is_number(pool, left, &left_number);
+    b32 const right_constant = expression_is_number(pool, right, &right_number);
+    if (left_constant && right_constant) {
+        return number_expression_new(pool, operator_apply(operator, left_number, right_number));
+    }
+
+    // A constant left operand that decides a conjunction or disjunction drops the right one, just like
+    // evaluating it short-circuits
+    if (left_constant && ((operator== OPERATOR_AND && left_number == 0.0) ||
+                          (operator== OPERATOR_OR && left_number != 0.0))) {
+        return number_expression_new(pool, operator== OPERATOR_OR ? 1.0 : 0.0);
+    }
+
+    // Only identities that hold for every floating point value are applied, x + 0 for example is not
+    // one of them, as it turns negative zero into positive zero
+    if (right_constant) {
+        if ((operator== OPERATOR_MUL || operator== OPERATOR_DIV) && right_number == 1.0) {
+            return left;
+        }
+        if (operator== OPERATOR_SUB && right_number == 0.0 && !signbit(right_number)) {
+            return left;
+        }
+    }
+    if (left_constant && operator== OPERATOR_MUL && left_number == 1.0) {
+        return right;
+    }
+    Expression *node = expression_pool_get(pool, self);
+    node->binary.left = left;
+    node->binary.right = right;
+    return self;
+}
+
+/// Folds an exponential expression
+static ExpressionIndex expression_fold_exponential(ExpressionIndex const self, Program *program) {
+    ExpressionPool *pool = &program->expressions;
+    ExpressionIndex const base = expression_fold(expression_pool_get(pool, self)->exponential.base, program);
+    ExpressionIndex const exponent = expression_fold(expression_pool_get(pool, self)->exponential.exponent, program);
+    f64 base_number;
+    f64 power_number;
+    b32 const constant_exponent = expression_is_number(pool, exponent, &power_number);
+    if (constant_exponent && expression_is_number(pool, base, &base_number)) {
+        return number_expression_new(pool, pow(base_number, power_number));
+    }
+
+    if (constant_exponent && power_number >= 1.0 && power_number <= EXPRESSION_POWER_LIMIT &&
+        power_number == floor(power_number)) {
+        u32 const power = (u32) power_number;
+        if (power == 1) {
+            return base;
+        }
+
+        // Variables and parameters are cheap to load repeatedly. Any other base must be pure and the power
+        // must be a power of two, then the chain consists of squares only and the base is evaluated once
+        ExpressionType const type = expression_pool_get(pool, base)->type;
+        b32 const squares = (power & (power - 1)) == 0;
+        b32 const load = type == EXPRESSION_VARIABLE || type == EXPRESSION_PARAMETER;
+        if (load || (squares && expression_is_pure(base, program))) {
+            return expression_fold_power(pool, base, power);
+        }
+    }
+    Expression *node = expression_pool_get(pool, self);
+    node->exponential.base = base;
+    node->exponential.exponent = exponent;
+    return self;
+}
+
+/// Folds the arguments of a function or the indices of an element in place, as folding never creates
+/// arguments
+static b32 expression_fold_arguments(ExpressionIndex const self, Program *program) {
+    ExpressionPool *pool = &program->expressions;
+    u32 const first = expression_pool_get(pool, self)->function.arguments;
+    u32 const count = expression_pool_get(pool, self)->function.argument_count;
+    b32 constant = true;
+    for (u32 index = first; index < first + count; ++index) {
+        ExpressionIndex const argument = expression_fold(pool->arguments[index], program);
+        pool->arguments[index] = argument;
+        constant = constant && expression_pool_get(pool, argument)->type == EXPRESSION_NUMBER;
+    }
+    return constant;
+}
+
+/// Folds a function expression
+static ExpressionIndex expression_fold_function(ExpressionIndex const self, Program *program) {
+    b32 const constant = expression_fold_arguments(self, program);
+    Expression const *node = expression_pool_get(&program->expressions, self);
+    FunctionExpression const *function = &node->function;
+    FunctionDefinition const *definition = program->functions[function->slot];
+    if (!constant || definition == NULL || definition->type != FUNCTION_DEFINITION_BUILTIN ||
+        !definition->builtin.pure || function->argument_count != definition->builtin.parameter_count) {
+        return self;
+    }
+
+    // The arguments are numbers, so the reference interpreter evaluates the call without touching the program
+    f64 const value = function_expression_evaluate(node, program);
+    return number_expression_new(&program->expressions, value);
+}
+
+/// Folds constant subexpressions and calls to pure builtins with constant arguments, drops unary plus
+/// and rewrites small integer powers into multiplication chains
+static ExpressionIndex expression_fold(ExpressionIndex const self, Program *program) {
+    switch (expression_pool_get(&program->expressions, self)->type) {
+        case EXPRESSION_UNARY:
+            return expression_fold_unary(self, program);
+        case EXPRESSION_BINARY:
+            return expression_fold_binary(self, program);
+        case EXPRESSION_EXPONENTIAL:
+            return expression_fold_exponential(self, program);
+        case EXPRESSION_FUNCTION:
+            return expression_fold_function(self, program);
+        case EXPRESSION_STRING_FUNCTION:
+        case EXPRESSION_ELEMENT:
+        case EXPRESSION_PEEK:
+            expression_fold_arguments(self, program);
+            return self;
+        default:
+            return self;
     }
 }
@@ -4,7 +4,11 @@
 #define RETRO_EXPR_H
 
 enum {
-    EXPRESSION_IDENTIFIER_LENGTH = 64
+    /// Integer powers up to this exponent are rewritten into multiplication chains
+    EXPRESSION_POWER_LIMIT = 16,
+
+    /// The maximum amount of arguments of a function call or indices of an element
+    EXPRESSION_ARGUMENT_MAX = 16
 };
 
 typedef enum ExpressionType {
@@ -14,91 +18,129 @@ typedef enum ExpressionType {
     EXPRESSION_FUNCTION,
     EXPRESSION_UNARY,
     EXPRESSION_EXPONENTIAL,
+    EXPRESSION_PARAMETER,
+    EXPRESSION_STRING_FUNCTION,
+    EXPRESSION_ELEMENT,
+    EXPRESSION_PEEK,
     EXPRESSION_STRING
 } ExpressionType;
 
-/// Forward declare expression
+/// Forward declares
 typedef struct Expression Expression;
+typedef struct Chunk Chunk;
 
 typedef enum Operator {
     OPERATOR_ADD,
     OPERATOR_SUB,
     OPERATOR_MUL,
-    OPERATOR_DIV
+    OPERATOR_DIV,
+
+    // Relational and boolean operators, which yield 1 if they hold and 0 otherwise
+    OPERATOR_EQUAL,
+    OPERATOR_NOT_EQUAL,
+    OPERATOR_LESS,
+    OPERATOR_LESS_EQUAL,
+    OPERATOR_GREATER,
+    OPERATOR_GREATER_EQUAL,
+    OPERATOR_AND,
+    OPERATOR_OR,
+    OPERATOR_NOT
 } Operator;
 
+/// Checks if the operator compares its operands, which may then also be strings
+/// @param operator The operator
+/// @return A boolean value that indicates whether the operator is relational
+static b32 operator_is_relational(Operator operator);
+
 typedef struct UnaryExpression {
     Operator operator;
-    Expression *expression;
+    ExpressionIndex expression;
 } UnaryExpression;
 
 /// Creates a new unary expression instance
-/// @param arena The arena for the allocation
+/// @param pool The expression pool
 /// @param operator The operator
 /// @param expression The expression
-/// @return A new expression instance
-static Expression *unary_expression_new(MemoryArena *arena, Operator operator, Expression * expression);
+/// @return The index of the new expression
+static ExpressionIndex unary_expression_new(ExpressionPool *pool, Operator operator, ExpressionIndex expression);
 
 /// Evaluates the unary expression
 /// @param self The expression instance
-/// @param symbol_table The symbol table
+/// @param program The program state
 /// @return The resulting value
-static f64 unary_expression_evaluate(Expression const *self, HashMap const *symbol_table);
+static f64 unary_expression_evaluate(Expression const *self, Program *program);
 
 typedef struct BinaryExpression {
-    Expression *left;
-    Expression *right;
+    ExpressionIndex left;
+    ExpressionIndex right;
     Operator operator;
 } BinaryExpression;
 
 /// Creates a new binary expression instance
-/// @param arena The arena for allocations
+/// @param pool The expression pool
 /// @param left left expression
 /// @param right right expression
 /// @param operator binary operator
-/// @return A new expression instance
-static Expression *binary_expression_new(MemoryArena *arena, Expression *left, Expression *right, Operator operator);
+/// @return The index of the new expression
+static ExpressionIndex binary_expression_new(ExpressionPool *pool,
+                                             ExpressionIndex left,
+                                             ExpressionIndex right,
+                                             Operator operator);
+
+/// Applies the binary operator to the specified operands
+/// @param operator The operator
+/// @param left The left operand
+/// @param right The right operand
+/// @return The resulting value
+static f64 operator_apply(Operator operator, f64 left, f64 right);
 
-/// Evaluates the binary expression
+/// Evaluates the binary expression, the right operand of AND and OR is only evaluated
+/// if the left one does not already decide the result
 /// @param self The expression instance
-/// @param symbol_table The symbol table
+/// @param program The program state
 /// @return The resulting value
-static f64 binary_expression_evaluate(Expression const *self, HashMap const *symbol_table);
+static f64 binary_expression_evaluate(Expression const *self, Program *program);
 
 typedef struct VariableExpression {
-    char name[EXPRESSION_IDENTIFIER_LENGTH];
+    ExpressionName name;
+
+    /// The type of the variable, which selects the storage the slot refers to
+    VariableType type;
+
+    /// The variable slot, which is resolved at compile time. For parameters of user
+    /// defined functions, this is the index of the parameter instead.
+    u32 slot;
 } VariableExpression;
 
 /// Creates a new variable expression instance
-/// @param arena The arena for allocations
+/// @param pool The expression pool
 /// @param name The name of the variable
 /// @param length The length of the variable name
-/// @return A new expression instance
-static Expression *variable_expression_new(MemoryArena *arena, char const *name, usize length);
+/// @return The index of the new expression
+static ExpressionIndex variable_expression_new(ExpressionPool *pool, char const *name, usize length);
 
 /// Evaluates the variable expression
 /// @param self The expression instance
-/// @param symbol_table The symbol table
+/// @param program The program state
 /// @return The resulting value
-static f64 variable_expression_evaluate(Expression const *self, HashMap const *symbol_table);
+static f64 variable_expression_evaluate(Expression const *self, Program *program);
 
-typedef struct FunctionParameter {
-    Expression *expression;
-    struct FunctionParameter *prev;
-    struct FunctionParameter *next;
-} FunctionParameter;
-
-/// Creates a new function parameter instance
-/// @param arena The arena for allocations
-/// @param expression The expression
-/// @return A new function parameter instance
-static FunctionParameter *function_parameter_new(MemoryArena *arena, Expression *expression);
+/// Evaluates the parameter expression, which reads the argument of the innermost function call
+/// @param self The expression instance
+/// @param program The program state
+/// @return The resulting value
+static f64 parameter_expression_evaluate(Expression const *self, Program *program);
 
 typedef struct FunctionExpression {
-    char name[EXPRESSION_IDENTIFIER_LENGTH];
-    FunctionParameter *first_parameter;
-    FunctionParameter *last_parameter;
-    usize parameter_count;
+    ExpressionName name;
+
+    /// The function slot, which is resolved at compile time
+    u32 slot;
+
+    /// The index of the first argument in the arguments of the expression pool, the
+    /// arguments of a call are stored next to each other
+    u32 arguments;
+    u32 argument_count;
 } FunctionExpression;
 
 typedef struct FunctionDefinitionBuiltin {
@@ -108,6 +150,9 @@ typedef struct FunctionDefinitionBuiltin {
         PARAMETER_COUNT_2 = 2
     } parameter_count;
 
+    /// Pure functions always yield the same result for the same arguments and have no side effects
+    b32 pure;
+
     union {
         f64 (*func0)(void);
         f64 (*func1)(f64);
@@ -116,8 +161,11 @@ typedef struct FunctionDefinitionBuiltin {
 } FunctionDefinitionBuiltin;
 
 typedef struct FunctionDefinitionDynamic {
-    Expression *variable;
-    Expression *body;
+    ExpressionIndex variable;
+    ExpressionIndex body;
+
+    /// The compiled body, which is evaluated by the virtual machine
+    Chunk const *code;
 } FunctionDefinitionDynamic;
 
 typedef enum FunctionDefinitionType {
@@ -126,7 +174,7 @@ typedef enum FunctionDefinitionType {
 } FunctionDefinitionType;
 
 typedef struct FunctionDefinition {
-    const char *name;
+    ExpressionName name;
     FunctionDefinitionType type;
     union {
         FunctionDefinitionBuiltin builtin;
@@ -135,34 +183,69 @@ typedef struct FunctionDefinition {
 } FunctionDefinition;
 
 /// Creates a new function expression instance
-/// @param arena The arena for allocations
+/// @param pool The expression pool
 /// @param name The name of the function
 /// @param length The length of the function name
-/// @return A new expression instance
-static Expression *function_expression_new(MemoryArena *arena, char const *name, usize length);
-
-/// Pushes a parameter to the specified function expression
-/// @param arena The arena for allocations
-/// @param self The expression instance
-/// @param parameter The parameter
-static void function_expression_push(MemoryArena *arena, Expression *self, Expression *parameter);
-
-/// Retrieves the parameter at the specified index
+/// @param arguments The arguments of the call, which are copied into the pool
+/// @param argument_count The amount of arguments
+/// @return The index of the new expression
+static ExpressionIndex function_expression_new(ExpressionPool *pool,
+                                               char const *name,
+                                               usize length,
+                                               ExpressionIndex const *arguments,
+                                               u32 argument_count);
+
+/// Retrieves the arguments of the function or element expression
+/// @param pool The expression pool
 /// @param self The expression instance
-/// @param index The parameter index
-static FunctionParameter *function_expression_get_parameter(Expression const *self, usize index);
+/// @return The arguments, which are stored next to each other
+static ExpressionIndex *function_expression_arguments(ExpressionPool const *pool, Expression const *self);
 
 /// Evaluates the specified function expression
 /// @param self The function expression instance
-/// @param symbol_table The symbol table
+/// @param program The program state
 /// @return The resulting value
-static f64 function_expression_evaluate(Expression const *self, HashMap const *symbol_table);
+static f64 function_expression_evaluate(Expression const *self, Program *program);
+
+/// Creates a new element expression instance, which refers to an element of an array. Element
+/// expressions share the layout of function expressions, the arguments are the indices.
+/// @param pool The expression pool
+/// @param name The name of the array
+/// @param length The length of the array name
+/// @param indices The indices of the element, which are copied into the pool
+/// @param index_count The amount of indices
+/// @return The index of the new expression
+static ExpressionIndex element_expression_new(ExpressionPool *pool,
+                                              char const *name,
+                                              usize length,
+                                              ExpressionIndex const *indices,
+                                              u32 index_count);
+
+/// Evaluates the indices of the element expression and looks up the element
+/// @param self The expression instance
+/// @param program The program state
+/// @param element Receives the index of the element in the element storage of the array
+/// @return A boolean value that indicates whether the element exists, otherwise the program is stopped
+static b32 element_expression_locate(Expression const *self, Program *program, u32 *element);
+
+/// Evaluates the specified element expression, which must not be a string element
+/// @param self The expression instance
+/// @param program The program state
+/// @return The value of the element
+static f64 element_expression_evaluate(Expression const *self, Program *program);
+
+/// Evaluates the specified peek expression, which reads a byte of the memory. Peek expressions
+/// share the layout of function expressions, the only argument is the address.
+/// @param self The expression instance
+/// @param program The program state
+/// @return The byte at the address
+static f64 peek_expression_evaluate(Expression const *self, Program *program);
 
 /// Creates a new number expression instance
-/// @param arena The arena for allocations
+/// @param pool The expression pool
 /// @param number The number
-/// @return A new expression instance
-static Expression *number_expression_new(MemoryArena *arena, f64 number);
+/// @return The index of the new expression
+static ExpressionIndex number_expression_new(ExpressionPool *pool, f64 number);
 
 /// Evaluates the specified number expression
 /// @param self The expression instance
@@ -170,35 +253,106 @@ static Expression *number_expression_new(MemoryArena *arena, f64 number);
 static f64 number_expression_evaluate(Expression const *self);
 
 typedef struct ExponentialExpression {
-    Expression *base;
-    Expression *exponent;
+    ExpressionIndex base;
+    ExpressionIndex exponent;
 } ExponentialExpression;
 
 /// Creates a new exponential expression instance
-/// @param arena The arena for allocations
+/// @param pool The expression pool
 /// @param base The base of the exponential expression
 /// @param exponent The exponent of the exponential expression
-/// @return A new expression instance
-static Expression *exponential_expression_new(MemoryArena *arena, Expression *base, Expression *exponent);
+/// @return The index of the new expression
+static ExpressionIndex exponential_expression_new(ExpressionPool *pool, ExpressionIndex base, ExpressionIndex exponent);
 
 /// Evaluates the specified exponential expression
 /// @param self The expression instance
-/// @param symbol_table The symbol table
+/// @param program The program state
 /// @return The resulting value
-static f64 exponential_expression_evaluate(Expression const *self, HashMap const *symbol_table);
+static f64 exponential_expression_evaluate(Expression const *self, Program *program);
 
 typedef struct StringExpression {
-    char *data;
-    usize length;
+    char const *data;
+    u32 length;
 } StringExpression;
 
-/// Creates a new string expression by storing the string in the provided arena
-/// @param arena The arena for allocations
+/// Creates a new string expression by storing the string in the text of the expression pool
+/// @param pool The expression pool
 /// @param data A pointer to the string
 /// @param length The length of the string
-static Expression *string_expression_new(MemoryArena *arena, char const *data, usize length);
+/// @return The index of the new expression
+static ExpressionIndex string_expression_new(ExpressionPool *pool, char const *data, usize length);
 
-/// What the fuck is this... we probably want to use shunting yard here at some point
+/// Evaluates the specified string expression
+/// @param self The expression instance
+/// @return The resulting string, which refers to the literal
+static String string_expression_evaluate(Expression const *self);
+
+/// The builtin functions that take or return strings. Calls to them are bound at compile time,
+/// as they cannot be redefined. Functions whose name ends with $ return a string.
+typedef enum StringFunction {
+    STRING_FUNCTION_LEN,
+    STRING_FUNCTION_LEFT,
+    STRING_FUNCTION_RIGHT,
+    STRING_FUNCTION_MID,
+    STRING_FUNCTION_STR,
+    STRING_FUNCTION_CHR,
+    STRING_FUNCTION_ASC,
+    STRING_FUNCTION_VAL,
+    STRING_FUNCTION_COUNT
+} StringFunction;
+
+/// Looks up the string function with the specified name
+/// @param name The name of the function
+/// @return The string function or STRING_FUNCTION_COUNT if there is none
+static StringFunction string_function_find(char const *name);
+
+/// Checks if the string function returns a string
+/// @param function The string function
+/// @return A boolean value that indicates whether the result is a string
+static b32 string_function_returns_string(StringFunction function);
+
+/// Applies a string function that returns a string. Argument i is either strings[i] or numbers[i],
+/// depending on whether the function expects a string or a number at that position.
+/// @param program The program state
+/// @param function The string function
+/// @param strings The string arguments
+/// @param numbers The number arguments
+/// @param count The amount of arguments
+/// @return The resulting string, which is a temporary or refers to an argument
+static String string_function_string(Program *program,
+                                     StringFunction function,
+                                     String const *strings,
+                                     f64 const *numbers,
+                                     u32 count);
+
+/// Applies a string function that returns a number, arguments are passed like for string_function_string
+/// @param program The program state
+/// @param function The string function
+/// @param strings The string arguments
+/// @param numbers The number arguments
+/// @param count The amount of arguments
+/// @return The resulting number
+static f64 string_function_number(Program *program,
+                                  StringFunction function,
+                                  String const *strings,
+                                  f64 const *numbers,
+                                  u32 count);
+
+/// Compares two strings character by character, a string that is a prefix of the other is less
+/// @param left The left string
+/// @param right The right string
+/// @return A negative value, zero or a positive value if left is less, equal or greater than right
+static s32 string_compare(String left, String right);
+
+/// Concatenates two strings into a temporary string
+/// @param program The program state
+/// @param left The left string
+/// @param right The right string
+/// @return The resulting string
+static String string_concatenate(Program *program, String left, String right);
+
+/// A node of the syntax tree of an expression, which takes 24 bytes. Children, arguments and
+/// names are referred to by their index in the expression pool.
 typedef struct Expression {
     ExpressionType type;
     union {
@@ -206,7 +360,9 @@ typedef struct Expression {
         UnaryExpression unary;
         BinaryExpression binary;
         VariableExpression variable;
+        VariableExpression parameter;
         FunctionExpression function;
+        FunctionExpression element;
         ExponentialExpression exponential;
         f64 number;
 
@@ -215,23 +371,73 @@ typedef struct Expression {
     };
 } Expression;
 
-/// Compiles an expression from a list of tokens
-/// @param arena The arena for allocations
-/// @param begin The first token
-/// @param end The last token
-/// @return The resulting expression
-static Expression *expression_compile(MemoryArena *arena, Token *begin, Token *end);
+/// Compiles an expression from the remaining tokens of the iterator
+/// @param pool The expression pool
+/// @param tokens The token iterator, which points to the first token of the expression
+///               and is advanced past the expression
+/// @return The index of the resulting expression or EXPRESSION_NONE
+static ExpressionIndex expression_compile(ExpressionPool *pool, TokenIterator *tokens);
+
+/// Compiles an array element of the form <identifier>(<index>, ...), which may be the
+/// target of an assignment or the declaration of an array
+/// @param pool The expression pool
+/// @param tokens The token iterator, which points to the identifier and is advanced past the element
+/// @return The resulting element expression or EXPRESSION_NONE if the tokens do not form an element
+static ExpressionIndex expression_compile_element(ExpressionPool *pool, TokenIterator *tokens);
 
 /// Evaluates the specified expression
-/// @param self The expression instance
-/// @param symbol_table The symbol table
+/// @param self The expression index
+/// @param program The program state
 /// @return The resulting value
-static f64 expression_evaluate(Expression const *self, HashMap const *symbol_table);
+static f64 expression_evaluate(ExpressionIndex self, Program *program);
+
+/// Evaluates the specified expression, which must be a string expression
+/// @param self The expression index
+/// @param program The program state
+/// @return The resulting string
+static String expression_evaluate_string(ExpressionIndex self, Program *program);
+
+/// Resolves the slots of all variables and functions that are referenced by the expression.
+/// Variables that are named like the parameter become parameter expressions, so that they
+/// refer to the argument of the call rather than to the global variable.
+/// @param self The expression index
+/// @param program The program state
+/// @param parameter The name of the parameter of the enclosing function or EXPRESSION_NAME_NONE
+/// @return A boolean value that indicates whether a reference of the form NAME(...) has turned
+///         from a function call into an array element or vice versa
+static b32 expression_resolve(ExpressionIndex self, Program *program, ExpressionName parameter);
+
+/// Resolves the slots of the target of an assignment or a DIM statement, element targets always
+/// refer to an array
+/// @param self The expression index
+/// @param program The program state
+/// @return A boolean value that indicates whether a reference within the indices has changed
+static b32 expression_resolve_target(ExpressionIndex self, Program *program);
+
+/// Checks that the operands of all operators and the arguments of all functions have the
+/// correct type. Slots must already be resolved.
+/// @param pool The expression pool
+/// @param self The expression index
+/// @return An error message or NULL if the expression is valid
+static char const *expression_check(ExpressionPool const *pool, ExpressionIndex self);
+
+/// Folds constant subexpressions and calls to pure builtins with constant arguments, drops unary plus
+/// and rewrites small integer powers into multiplication chains. Slots must already be resolved.
+/// @param self The expression index
+/// @param program The program state, whose expression pool receives the new nodes
+/// @return The optimized expression, which may share nodes with the original expression
+static ExpressionIndex expression_fold(ExpressionIndex self, Program *program);
 
 /// Checks if an expression is arithmetic
-/// @param self The expression instance
-/// @param A b32ean value that indicates whether the expression
-///        is arithmetic or not
-static b32 expression_is_arithmetic(Expression const *self);
+/// @param pool The expression pool
+/// @param self The expression index
+/// @return A boolean value that indicates whether the expression is arithmetic
+static b32 expression_is_arithmetic(ExpressionPool const *pool, ExpressionIndex self);
+
+/// Checks if an expression yields a string
+/// @param pool The expression pool
+/// @param self The expression index
+/// @return A boolean value that indicates whether the expression is a string
+static b32 expression_is_string(ExpressionPool const *pool, ExpressionIndex self);
 
 #endif// RETRO_EXPR_H
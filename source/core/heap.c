@@ -0,0 +1,200 @@
+// Copyright (c) 2025 Elias Engelbert Plank
+
+/// Creates an empty string heap
+static void string_heap_create(StringHeap *self) {
+    self->used = 0;
+    self->capacity = STRING_HEAP_CAPACITY;
+    self->data = malloc(self->capacity);
+    self->temporary_used = 0;
+    self->temporaries = malloc(STRING_HEAP_TEMPORARY_CAPACITY);
+    self->garbage = 0;
+    self->collecting = false;
+    self->compacted = 0;
+    self->scan = 0;
+    self->collections = 0;
+}
+
+/// Destroys the string heap and all of its strings
+static void string_heap_destroy(StringHeap *self) {
+    free(self->data);
+    free(self->temporaries);
+    self->data = NULL;
+    self->temporaries = NULL;
+    self->used = 0;
+    self->capacity = 0;
+    self->temporary_used = 0;
+}
+
+/// Removes all strings from the heap, the memory of the heap is kept
+static void string_heap_clear(StringHeap *self) {
+    self->used = 0;
+    self->temporary_used = 0;
+    self->garbage = 0;
+    self->collecting = false;
+}
+
+/// Allocates a temporary string, which lives until the temporaries are reset
+static char *string_heap_temporary(StringHeap *self, u32 const length) {
+    if (STRING_HEAP_TEMPORARY_CAPACITY - self->temporary_used < length) {
+        return NULL;
+    }
+    char *result = self->temporaries + self->temporary_used;
+    self->temporary_used += length;
+    return result;
+}
+
+/// Releases all temporaries at once
+static void string_heap_reset_temporaries(StringHeap *self) {
+    self->temporary_used = 0;
+}
+
+/// Retrieves the amount of bytes a string with the specified length occupies in the heap
+static u32 string_heap_block_size(u32 const length) {
+    return (u32) sizeof(StringHeader) + ((length + 3u) & ~3u);
+}
+
+/// Checks if the characters belong to a string of the heap
+static b32 string_heap_contains(StringHeap const *self, char const *data) {
+    return data != NULL && (u8 const *) data >= self->data && (u8 const *) data < self->data + self->used;
+}
+
+/// Retrieves the root of the specified owner, or NULL if the owner does not exist (anymore)
+static String *string_heap_root(StringRoots const *roots, u32 const owner) {
+    if (owner & STRING_HEAP_OWNER_ELEMENT) {
+        u32 const element = owner & ~STRING_HEAP_OWNER_ELEMENT;
+        return element < roots->element_count ? roots->elements + element : NULL;
+    }
+    return owner < roots->variable_count ? roots->variables + owner : NULL;
+}
+
+/// Visits at most the specified amount of blocks of the running collection. A string is live if
+/// its owner still refers to it, strings are moved in address order, so that they never overlap
+/// a string that has not been visited yet. Strings that are stored while collecting are appended
+/// behind the visited blocks, therefore the collection finishes once it reaches the used bytes.
+static void string_heap_compact(StringHeap *self, StringRoots const *roots, u32 blocks) {
+    u32 write = self->compacted;
+    u32 read = self->scan;
+    for (; read < self->used && blocks > 0; --blocks) {
+        StringHeader const *header = (StringHeader const *) (self->data + read);
+        u32 const size = (u32) sizeof(StringHeader) + header->size;
+        char const *data = (char const *) (header + 1);
+        String *root = string_heap_root(roots, header->owner);
+        if (root != NULL && root->data == data) {
+            if (write != read) {
+                memmove(self->data + write, self->data + read, size);
+                root->data = (char const *) (self->data + write + sizeof(StringHeader));
+            }
+            write += size;
+        }
+        read += size;
+    }
+    self->compacted = write;
+    self->scan = read;
+    if (read == self->used) {
+        self->used = write;
+        self->collecting = false;
+        self->collections++;
+    }
+}
+
+/// Starts a collection, the garbage that accumulates from now on is left for the next one
+static void string_heap_collect_begin(StringHeap *self) {
+    self->collecting = true;
+    self->compacted = 0;
+    self->scan = 0;
+    self->garbage = 0;
+}
+
+/// Advances the collection by a bounded amount of blocks
+static void string_heap_step(StringHeap *self, StringRoots const *roots) {
+    if (!self->collecting) {
+        if (self->garbage < self->capacity >> STRING_HEAP_COLLECT_GARBAGE_SHIFT) {
+            return;
+        }
+        string_heap_collect_begin(self);
+    }
+    string_heap_compact(self, roots, STRING_HEAP_COLLECT_STEP);
+}
+
+/// Compacts the live strings of the heap towards its start
+static void string_heap_collect(StringHeap *self, StringRoots const *roots) {
+    if (!self->collecting) {
+        string_heap_collect_begin(self);
+    }
+    string_heap_compact(self, roots, UINT32_MAX);
+}
+
+/// Rebases the strings of the roots that refer to the heap onto the new heap data
+static void string_heap_rebase(StringHeap const *self, String *roots, u32 const count, u8 const *data) {
+    for (u32 index = 0; index < count; ++index) {
+        if (roots[index].data != NULL) {
+            roots[index].data = (char const *) (data + ((u8 const *) roots[index].data - self->data));
+        }
+    }
+}
+
+/// Moves the heap into a larger buffer, so that at least the specified amount of bytes is free
+static void string_heap_grow(StringHeap *self, StringRoots const *roots, u32 const required) {
+    u32 capacity = self->capacity * 2;
+    while (capacity - self->used < required) {
+        capacity *= 2;
+    }
+    u8 *data = malloc(capacity);
+    memcpy(data, self->data, self->used);
+    string_heap_rebase(self, roots->variables, roots->variable_count, data);
+    string_heap_rebase(self, roots->elements, roots->element_count, data);
+    free(self->data);
+    self->data = data;
+    self->capacity = capacity;
+}
+
+/// Copies the value into the string of the specified root
+static void string_heap_store(StringHeap *self, StringRoots const *roots, u32 const owner, String value) {
+    assert(value.length <= STRING_LENGTH_MAX && "strings must not exceed the maximum length");
+    String *root = string_heap_root(roots, owner);
+    if (value.length == 0) {
+        if (root->data != NULL) {
+            self->garbage += string_heap_block_size(0) + ((StringHeader const *) root->data - 1)->size;
+        }
+        root->data = NULL;
+        root->length = 0;
+        return;
+    }
+
+    // Variables only ever refer to strings of the heap, so the previous string can be reused in place,
+    // which is the common case for loops that assign strings of similar length
+    if (root->data != NULL && ((StringHeader const *) root->data - 1)->size >= value.length) {
+        memmove((char *) root->data, value.data, value.length);
+        root->length = value.length;
+        return;
+    }
+    if (root->data != NULL) {
+        self->garbage += string_heap_block_size(0) + ((StringHeader const *) root->data - 1)->size;
+    }
+
+    u32 const size = string_heap_block_size(value.length);
+    if (self->capacity - self->used < size) {
+        // The value may refer to a string of the heap, which moves while collecting
+        char buffer[STRING_LENGTH_MAX];
+        if (string_heap_contains(self, value.data)) {
+            memcpy(buffer, value.data, value.length);
+            value.data = buffer;
+        }
+        root->data = NULL;
+        root->length = 0;
+        string_heap_collect(self, roots);
+        if (self->capacity - self->used < size) {
+            string_heap_grow(self, roots, size);
+        }
+    }
+
+    StringHeader *header = (StringHeader *) (self->data + self->used);
+    header->owner = owner;
+    header->size = size - (u32) sizeof(StringHeader);
+    self->used += size;
+
+    char *data = (char *) (header + 1);
+    memcpy(data, value.data, value.length);
+    root->data = data;
+    root->length = value.length;
+}
@@ -0,0 +1,120 @@
+// Copyright (c) 2025 Elias Engelbert Plank
+
+#ifndef RETRO_HEAP_H
+#define RETRO_HEAP_H
+
+enum {
+    /// The maximum length of a string, as in Applesoft BASIC
+    STRING_LENGTH_MAX = 255,
+
+    STRING_HEAP_CAPACITY = 4 * 1024,
+    STRING_HEAP_TEMPORARY_CAPACITY = 16 * 1024,
+
+    /// The amount of blocks a collection visits before every line
+    STRING_HEAP_COLLECT_STEP = 16,
+
+    /// A collection starts once the garbage exceeds this fraction of the capacity
+    STRING_HEAP_COLLECT_GARBAGE_SHIFT = 2
+};
+
+/// A string refers to characters that are not terminated. The characters either belong
+/// to a literal of the program, to a temporary of the current statement or to a variable.
+typedef struct String {
+    char const *data;
+    u32 length;
+} String;
+
+/// The strings that may own strings of the heap, which are the string variables and the
+/// elements of string arrays. Both are indexed by the owner of a string, owners of elements
+/// are marked with STRING_HEAP_OWNER_ELEMENT.
+typedef struct StringRoots {
+    String *variables;
+    u32 variable_count;
+    String *elements;
+    u32 element_count;
+} StringRoots;
+
+enum {
+    STRING_HEAP_OWNER_ELEMENT = 0x80000000u
+};
+
+/// Every string that is owned by a variable is preceded by a header in the heap
+typedef struct StringHeader {
+    /// The owner of the string, which refers to one of the roots
+    u32 owner;
+
+    /// The amount of bytes that are reserved for the string, which excludes the header
+    u32 size;
+} StringHeader;
+
+/// The string heap has two generations. Strings that are produced while a statement is
+/// executed are temporaries, which are bump allocated and all die at once when the next
+/// statement starts. Only strings that are assigned to variables are copied into the
+/// persistent generation, where every string has exactly one owner. Once enough garbage
+/// has accumulated, live strings are compacted towards its start incrementally, a few
+/// blocks before every line, so that a program never stalls for a whole collection. If
+/// the persistent generation is exhausted, the running collection is finished at once,
+/// the heap only grows if the live strings do not leave enough room.
+typedef struct StringHeap {
+    u8 *data;
+    u32 used;
+    u32 capacity;
+
+    char *temporaries;
+    u32 temporary_used;
+
+    /// The amount of bytes of the blocks that are no longer owned by their root
+    u32 garbage;
+
+    /// The state of the running collection. The blocks before the compacted offset are live
+    /// and compacted, the blocks from the scan offset up to the used bytes are not visited yet.
+    b32 collecting;
+    u32 compacted;
+    u32 scan;
+
+    /// The amount of collections, which is useful for debugging and benchmarking
+    u32 collections;
+} StringHeap;
+
+/// Creates an empty string heap
+/// @param self The string heap
+static void string_heap_create(StringHeap *self);
+
+/// Destroys the string heap and all of its strings
+/// @param self The string heap
+static void string_heap_destroy(StringHeap *self);
+
+/// Removes all strings from the heap, the memory of the heap is kept
+/// @param self The string heap
+static void string_heap_clear(StringHeap *self);
+
+/// Allocates a temporary string, which lives until the temporaries are reset
+/// @param self The string heap
+/// @param length The length of the string
+/// @return The characters of the string or NULL if the temporaries are exhausted
+static char *string_heap_temporary(StringHeap *self, u32 length);
+
+/// Releases all temporaries at once
+/// @param self The string heap
+static void string_heap_reset_temporaries(StringHeap *self);
+
+/// Copies the value into the string of the specified root. The previous string of the root
+/// is reused if it is large enough, otherwise it becomes garbage.
+/// @param self The string heap
+/// @param roots The strings of all variables and elements, which are updated when strings are moved
+/// @param owner The owner the value is assigned to
+/// @param value The value, which may refer to any string including the ones in the heap
+static void string_heap_store(StringHeap *self, StringRoots const *roots, u32 owner, String value);
+
+/// Advances the collection by a bounded amount of blocks, a collection is started once enough
+/// garbage has accumulated
+/// @param self The string heap
+/// @param roots The strings of all variables and elements, which are updated when strings are moved
+static void string_heap_step(StringHeap *self, StringRoots const *roots);
+
+/// Compacts the live strings of the heap towards its start, a running collection is finished
+/// @param self The string heap
+/// @param roots The strings of all variables and elements, which are updated when strings are moved
+static void string_heap_collect(StringHeap *self, StringRoots const *roots);
+
+#endif// RETRO_HEAP_H
@@ -0,0 +1,823 @@
+// Copyright (c) 2025 Elias Engelbert Plank
+
+/// The general purpose registers of x86-64, the SSE registers use the same numbering
+typedef enum JitRegister {
+    JIT_RAX = 0,
+    JIT_RCX = 1,
+    JIT_RDX = 2,
+    JIT_RBX = 3,
+    JIT_RSP = 4,
+    JIT_RBP = 5,
+    JIT_RSI = 6,
+    JIT_RDI = 7,
+    JIT_R8 = 8,
+    JIT_R12 = 12,
+    JIT_R13 = 13,
+    JIT_R14 = 14,
+    JIT_R15 = 15,
+
+    // The callee saved registers hold the state of the virtual machine while native code runs
+    JIT_REGISTERS = JIT_RBX,
+    JIT_PROGRAM = JIT_R12,
+    JIT_PARAMETERS = JIT_R13,
+    JIT_INTEGERS = JIT_R14,
+    JIT_VARIABLES = JIT_R15
+} JitRegister;
+
+typedef enum JitCondition {
+    JIT_CONDITION_BELOW = 0x2,
+    JIT_CONDITION_ABOVE_EQUAL = 0x3,
+    JIT_CONDITION_EQUAL = 0x4,
+    JIT_CONDITION_NOT_EQUAL = 0x5,
+    JIT_CONDITION_PARITY = 0xA,
+    JIT_CONDITION_LESS = 0xC,
+    JIT_CONDITION_GREATER_EQUAL = 0xD,
+    JIT_CONDITION_LESS_EQUAL = 0xE,
+    JIT_CONDITION_GREATER = 0xF
+} JitCondition;
+
+/// The predicates of cmpsd, which yield false for NaN except for JIT_PREDICATE_NOT_EQUAL just like C does
+typedef enum JitPredicate {
+    JIT_PREDICATE_EQUAL = 0,
+    JIT_PREDICATE_LESS = 1,
+    JIT_PREDICATE_LESS_EQUAL = 2,
+    JIT_PREDICATE_NOT_EQUAL = 4
+} JitPredicate;
+
+enum {
+    /// The stack space below the saved registers, which holds the element index of array
+    /// instructions at offset zero and the frame at offset eight
+    JIT_STACK_SIZE = 16
+};
+
+/// Emits machine code into the executable memory, bytes beyond the capacity are counted but
+/// not written, so that running out of memory only has to be checked once
+typedef struct JitAssembler {
+    u8 *memory;
+    usize size;
+    usize capacity;
+} JitAssembler;
+
+/// A jump to an instruction whose native code has not been emitted yet
+typedef struct JitFixup {
+    u32 displacement;
+    u32 target;
+} JitFixup;
+
+typedef struct JitCompiler {
+    JitAssembler assembler;
+    Jit const *jit;
+    Program const *program;
+    Chunk const *chunk;
+    u32 *offsets;
+    JitFixup fixups[2 * CHUNK_CODE_CAPACITY];
+    u32 fixup_count;
+} JitCompiler;
+
+/// Emits a single byte
+static void jit_emit_byte(JitAssembler *self, u8 const byte) {
+    if (self->size < self->capacity) {
+        self->memory[self->size] = byte;
+    }
+    ++self->size;
+}
+
+/// Emits a little endian 32 bit value
+static void jit_emit_u32(JitAssembler *self, u32 const value) {
+    for (u32 shift = 0; shift < 32; shift += 8) {
+        jit_emit_byte(self, (u8) (value >> shift));
+    }
+}
+
+/// Emits a little endian 64 bit value
+static void jit_emit_u64(JitAssembler *self, u64 const value) {
+    jit_emit_u32(self, (u32) value);
+    jit_emit_u32(self, (u32) (value >> 32));
+}
+
+/// Emits the mandatory prefix, the REX prefix if it is required and the opcode, which is either a
+/// single byte or 0x0F followed by a byte
+static void jit_emit_opcode(JitAssembler *self, u8 const prefix, b32 const wide, u32 const opcode, u8 const reg,
+                            u8 const rm) {
+    if (prefix != 0) {
+        jit_emit_byte(self, prefix);
+    }
+    u8 const rex = (u8) (0x40 | (wide ? 0x8 : 0) | (reg & 0x8 ? 0x4 : 0) | (rm & 0x8 ? 0x1 : 0));
+    if (rex != 0x40) {
+        jit_emit_byte(self, rex);
+    }
+    if (opcode > 0xFF) {
+        jit_emit_byte(self, (u8) (opcode >> 8));
+    }
+    jit_emit_byte(self, (u8) opcode);
+}
+
+/// Emits an instruction whose operands are a register and the memory at base + displacement
+static void jit_emit_memory(JitAssembler *self, u8 const prefix, b32 const wide, u32 const opcode, u8 const reg,
+                            u8 const base, s32 const displacement) {
+    jit_emit_opcode(self, prefix, wide, opcode, reg, base);
+    jit_emit_byte(self, (u8) (0x80 | (reg & 0x7) << 3 | (base & 0x7)));
+    if ((base & 0x7) == JIT_RSP) {
+        // rsp and r12 can only be used as a base through a SIB byte
+        jit_emit_byte(self, 0x24);
+    }
+    jit_emit_u32(self, (u32) displacement);
+}
+
+/// Emits an instruction whose operands are two registers
+static void jit_emit_register(JitAssembler *self, u8 const prefix, b32 const wide, u32 const opcode, u8 const reg,
+                              u8 const rm) {
+    jit_emit_opcode(self, prefix, wide, opcode, reg, rm);
+    jit_emit_byte(self, (u8) (0xC0 | (reg & 0x7) << 3 | (rm & 0x7)));
+}
+
+/// Emits mov reg, value, values that fit into 32 bits are zero extended
+static void jit_emit_immediate(JitAssembler *self, u8 const reg, u64 const value) {
+    b32 const wide = value > 0xFFFFFFFF;
+    if (wide || reg & 0x8) {
+        jit_emit_byte(self, (u8) (0x40 | (wide ? 0x8 : 0) | (reg & 0x8 ? 0x1 : 0)));
+    }
+    jit_emit_byte(self, (u8) (0xB8 + (reg & 0x7)));
+    if (wide) {
+        jit_emit_u64(self, value);
+    } else {
+        jit_emit_u32(self, (u32) value);
+    }
+}
+
+/// Emits a call to a C function, arguments must already be in place
+static void jit_emit_call(JitAssembler *self, usize const function) {
+    jit_emit_immediate(self, JIT_RAX, function);
+    jit_emit_register(self, 0, false, 0xFF, 2, JIT_RAX);
+}
+
+/// Emits a jump, or a conditional jump if a condition is specified, to the offset in the executable memory
+/// @return The offset of the displacement, so that it can be patched later on
+static usize jit_emit_jump(JitAssembler *self, u8 const condition, usize const target) {
+    if (condition != 0) {
+        jit_emit_byte(self, 0x0F);
+        jit_emit_byte(self, (u8) (0x80 | condition));
+    } else {
+        jit_emit_byte(self, 0xE9);
+    }
+    usize const displacement = self->size;
+    jit_emit_u32(self, (u32) (target - (displacement + 4)));
+    return displacement;
+}
+
+/// Points a jump that was emitted earlier to the offset in the executable memory
+static void jit_patch(JitAssembler *self, usize const displacement, usize const target) {
+    u32 const value = (u32) (target - (displacement + 4));
+    if (displacement + 4 <= self->capacity) {
+        memcpy(self->memory + displacement, &value, sizeof value);
+    }
+}
+
+/// Emits push reg
+static void jit_emit_push(JitAssembler *self, u8 const reg) {
+    if (reg & 0x8) {
+        jit_emit_byte(self, 0x41);
+    }
+    jit_emit_byte(self, (u8) (0x50 + (reg & 0x7)));
+}
+
+/// Emits pop reg
+static void jit_emit_pop(JitAssembler *self, u8 const reg) {
+    if (reg & 0x8) {
+        jit_emit_byte(self, 0x41);
+    }
+    jit_emit_byte(self, (u8) (0x58 + (reg & 0x7)));
+}
+
+/// Emits movsd xmm, [base + displacement]
+static void jit_emit_load(JitAssembler *self, u8 const xmm, u8 const base, s32 const displacement) {
+    jit_emit_memory(self, 0xF2, false, 0x0F10, xmm, base, displacement);
+}
+
+/// Emits movsd [base + displacement], xmm
+static void jit_emit_store(JitAssembler *self, u8 const base, s32 const displacement, u8 const xmm) {
+    jit_emit_memory(self, 0xF2, false, 0x0F11, xmm, base, displacement);
+}
+
+/// Emits the code that loads a number into an SSE register, rax is clobbered
+static void jit_emit_number(JitAssembler *self, u8 const xmm, f64 const number) {
+    u64 bits;
+    memcpy(&bits, &number, sizeof bits);
+    jit_emit_immediate(self, JIT_RAX, bits);
+    jit_emit_register(self, 0x66, true, 0x0F6E, xmm, JIT_RAX);
+}
+
+/// Emits the code that sets an SSE register to zero
+static void jit_emit_zero(JitAssembler *self, u8 const xmm) {
+    jit_emit_register(self, 0x66, false, 0x0F57, xmm, xmm);
+}
+
+/// Retrieves the displacement of a register of the virtual machine
+static s32 jit_real(u32 const index) {
+    return (s32) (index * sizeof(f64));
+}
+
+/// Retrieves the displacement of the integer part of a register of the virtual machine
+static s32 jit_integer(u32 const index) {
+    return (s32) (index * sizeof(s32));
+}
+
+/// Emits the code that marks the program as not waiting for input, just like every store does
+static void jit_emit_no_wait(JitAssembler *self) {
+    jit_emit_memory(self, 0, false, 0xC7, 0, JIT_PROGRAM, (s32) offsetof(Program, no_wait));
+    jit_emit_u32(self, true);
+}
+
+/// Emits the code that leaves native code with JIT_EXIT if the C function that was called returned false
+static void jit_emit_check(JitCompiler *self) {
+    jit_emit_register(&self->assembler, 0, false, 0x85, JIT_RAX, JIT_RAX);
+    jit_emit_jump(&self->assembler, JIT_CONDITION_EQUAL, self->jit->exit);
+}
+
+/// Emits the code that leaves native code, so that the virtual machine continues at the instruction
+static void jit_emit_side_exit(JitCompiler *self, u32 const index) {
+    jit_emit_immediate(&self->assembler, JIT_RAX, index);
+    jit_emit_jump(&self->assembler, 0, self->jit->epilogue);
+}
+
+/// Emits a branch to the instruction at the index, which is patched once all instructions are emitted
+static void jit_emit_branch(JitCompiler *self, u8 const condition, u32 const target) {
+    JitFixup *fixup = self->fixups + self->fixup_count++;
+    fixup->displacement = (u32) jit_emit_jump(&self->assembler, condition, 0);
+    fixup->target = target;
+}
+
+/// Emits the code that looks up an array element, the element index is then stored in eax
+static void jit_emit_element(JitCompiler *self, u32 const indices, u32 const count, u32 const slot) {
+    JitAssembler *assembler = &self->assembler;
+    usize fallbacks[3];
+    usize done = 0;
+    if (count == 1) {
+        // An index into a dimensioned one-dimensional array is looked up inline, just like vm_element does
+        s32 const array = (s32) (slot * sizeof(Array));
+        jit_emit_memory(assembler, 0, true, 0x8B, JIT_RAX, JIT_PROGRAM, (s32) offsetof(Program, arrays));
+        jit_emit_memory(assembler, 0, false, 0x83, 7, JIT_RAX, array + (s32) offsetof(Array, dimension_count));
+        jit_emit_byte(assembler, 1);
+        fallbacks[0] = jit_emit_jump(assembler, JIT_CONDITION_NOT_EQUAL, 0);
+        jit_emit_load(assembler, 0, JIT_REGISTERS, jit_real(indices));
+        jit_emit_zero(assembler, 1);
+        jit_emit_register(assembler, 0x66, false, 0x0F2E, 0, 1);
+        fallbacks[1] = jit_emit_jump(assembler, JIT_CONDITION_BELOW, 0);
+        jit_emit_memory(assembler, 0, false, 0x8B, JIT_RCX, JIT_RAX, array + (s32) offsetof(Array, extents));
+        jit_emit_register(assembler, 0xF2, true, 0x0F2A, 1, JIT_RCX);
+        jit_emit_register(assembler, 0x66, false, 0x0F2E, 0, 1);
+        fallbacks[2] = jit_emit_jump(assembler, JIT_CONDITION_ABOVE_EQUAL, 0);
+        jit_emit_register(assembler, 0xF2, true, 0x0F2C, JIT_RCX, 0);
+        jit_emit_memory(assembler, 0, false, 0x03, JIT_RCX, JIT_RAX, array + (s32) offsetof(Array, offset));
+        jit_emit_register(assembler, 0, false, 0x89, JIT_RCX, JIT_RAX);
+        done = jit_emit_jump(assembler, 0, 0);
+        for (u32 fallback = 0; fallback < STACK_ARRAY_SIZE(fallbacks); ++fallback) {
+            jit_patch(assembler, fallbacks[fallback], assembler->size);
+        }
+    }
+
+    // Anything else including errors is left to vm_element, which stores the element index on the stack
+    jit_emit_register(assembler, 0, true, 0x89, JIT_PROGRAM, JIT_RDI);
+    jit_emit_immediate(assembler, JIT_RSI, slot);
+    jit_emit_memory(assembler, 0, true, 0x8D, JIT_RDX, JIT_REGISTERS, jit_real(indices));
+    jit_emit_immediate(assembler, JIT_RCX, count);
+    jit_emit_memory(assembler, 0, true, 0x8D, JIT_R8, JIT_RSP, 0);
+    jit_emit_call(assembler, (usize) vm_element);
+    jit_emit_check(self);
+    jit_emit_memory(assembler, 0, false, 0x8B, JIT_RAX, JIT_RSP, 0);
+    if (count == 1) {
+        jit_patch(assembler, done, assembler->size);
+    }
+}
+
+/// Emits the code that turns the element index in rax into the address of the element, whose size is 1 << shift
+static void jit_emit_element_address(JitAssembler *self, s32 const elements, u8 const shift) {
+    jit_emit_memory(self, 0, true, 0x8B, JIT_RCX, JIT_PROGRAM, elements);
+    jit_emit_register(self, 0, true, 0xC1, 4, JIT_RAX);
+    jit_emit_byte(self, shift);
+    jit_emit_register(self, 0, true, 0x01, JIT_RCX, JIT_RAX);
+}
+
+/// Emits the code for registers[a] = registers[b] <op> registers[c]
+static void jit_emit_arithmetic(JitAssembler *self, Instruction const instruction, u32 const opcode) {
+    jit_emit_load(self, 0, JIT_REGISTERS, jit_real(instruction.b));
+    jit_emit_memory(self, 0xF2, false, opcode, 0, JIT_REGISTERS, jit_real(instruction.c));
+    jit_emit_store(self, JIT_REGISTERS, jit_real(instruction.a), 0);
+}
+
+/// Emits the code for registers[a] = left <predicate> right ? 1.0 : 0.0
+static void jit_emit_compare(JitAssembler *self, u32 const target, u32 const left, u32 const right,
+                             JitPredicate const predicate) {
+    jit_emit_load(self, 0, JIT_REGISTERS, jit_real(left));
+    jit_emit_memory(self, 0xF2, false, 0x0FC2, 0, JIT_REGISTERS, jit_real(right));
+    jit_emit_byte(self, (u8) predicate);
+    jit_emit_number(self, 1, 1.0);
+    jit_emit_register(self, 0x66, false, 0x0F54, 0, 1);
+    jit_emit_store(self, JIT_REGISTERS, jit_real(target), 0);
+}
+
+/// Emits the code for registers[a] = registers[b] <predicate> 0.0 ? 1.0 : 0.0
+static void jit_emit_compare_zero(JitAssembler *self, Instruction const instruction, JitPredicate const predicate) {
+    jit_emit_load(self, 0, JIT_REGISTERS, jit_real(instruction.b));
+    jit_emit_zero(self, 1);
+    jit_emit_register(self, 0xF2, false, 0x0FC2, 0, 1);
+    jit_emit_byte(self, (u8) predicate);
+    jit_emit_number(self, 1, 1.0);
+    jit_emit_register(self, 0x66, false, 0x0F54, 0, 1);
+    jit_emit_store(self, JIT_REGISTERS, jit_real(instruction.a), 0);
+}
+
+/// Emits the code for integers[a] = integers[b] <op> integers[c]
+static void jit_emit_integer_arithmetic(JitAssembler *self, Instruction const instruction, u32 const opcode) {
+    jit_emit_memory(self, 0, false, 0x8B, JIT_RAX, JIT_INTEGERS, jit_integer(instruction.b));
+    jit_emit_memory(self, 0, false, opcode, JIT_RAX, JIT_INTEGERS, jit_integer(instruction.c));
+    jit_emit_memory(self, 0, false, 0x89, JIT_RAX, JIT_INTEGERS, jit_integer(instruction.a));
+}
+
+/// Emits the code for integers[a] = integers[b] <condition> integers[c]
+static void jit_emit_integer_compare(JitAssembler *self, Instruction const instruction, JitCondition const condition) {
+    jit_emit_memory(self, 0, false, 0x8B, JIT_RAX, JIT_INTEGERS, jit_integer(instruction.b));
+    jit_emit_memory(self, 0, false, 0x3B, JIT_RAX, JIT_INTEGERS, jit_integer(instruction.c));
+    jit_emit_register(self, 0, false, 0x0F90 | condition, 0, JIT_RAX);
+    jit_emit_register(self, 0, false, 0x0FB6, JIT_RAX, JIT_RAX);
+    jit_emit_memory(self, 0, false, 0x89, JIT_RAX, JIT_INTEGERS, jit_integer(instruction.a));
+}
+
+/// Calls a function that is defined by the program on behalf of native code, the result is stored in the
+/// target register. Returns false if the function stopped the program.
+static b32 jit_call(JitFrame const *frame, u32 const target, u32 const slot, u32 const count) {
+    Program *program = frame->program;
+    frame->registers[target] = vm_call(program, program->functions[slot], frame->registers + target,
+                                       frame->integers + target, frame->strings + target, count, frame->limit);
+    return program->error == NULL;
+}
+
+/// Emits the code for a function call, builtin functions are called directly since they cannot be redefined
+static void jit_emit_function_call(JitCompiler *self, Instruction const instruction) {
+    JitAssembler *assembler = &self->assembler;
+    FunctionDefinition const *definition = self->program->functions[instruction.c];
+    if (definition != NULL && definition->type == FUNCTION_DEFINITION_BUILTIN) {
+        usize function = 0;
+        if (instruction.b == definition->builtin.parameter_count) {
+            switch (instruction.b) {
+                case 0:
+                    function = (usize) definition->builtin.func0;
+                    break;
+                case 1:
+                    function = (usize) definition->builtin.func1;
+                    break;
+                case 2:
+                    function = (usize) definition->builtin.func2;
+                    break;
+                default:
+                    break;
+            }
+        }
+        if (function == 0) {
+            jit_emit_zero(assembler, 0);
+        } else {
+            for (u32 argument = 0; argument < instruction.b; ++argument) {
+                jit_emit_load(assembler, (u8) argument, JIT_REGISTERS, jit_real(instruction.a + argument));
+            }
+            jit_emit_call(assembler, function);
+        }
+        jit_emit_store(assembler, JIT_REGISTERS, jit_real(instruction.a), 0);
+    } else {
+        // Functions that are defined by the program may change while it runs
+        jit_emit_memory(assembler, 0, true, 0x8B, JIT_RDI, JIT_RSP, 8);
+        jit_emit_immediate(assembler, JIT_RSI, instruction.a);
+        jit_emit_immediate(assembler, JIT_RDX, instruction.c);
+        jit_emit_immediate(assembler, JIT_RCX, instruction.b);
+        jit_emit_call(assembler, (usize) jit_call);
+        jit_emit_check(self);
+    }
+}
+
+/// Checks whether an instruction is implemented natively, the others are left to the virtual machine
+static b32 jit_native(Opcode const opcode) {
+    switch (opcode) {
+        case OPCODE_LOAD_STRING:
+        case OPCODE_LOAD_STRING_VARIABLE:
+        case OPCODE_LOAD_STRING_ELEMENT:
+        case OPCODE_STORE_STRING:
+        case OPCODE_STORE_STRING_ELEMENT:
+        case OPCODE_CONCATENATE:
+        case OPCODE_CALL_STRING:
+        case OPCODE_CALL_STRING_NUMBER:
+        case OPCODE_COMPARE_STRING:
+        case OPCODE_JUMP:
+        case OPCODE_JUMP_ON:
+        case OPCODE_RETURN_SUBROUTINE:
+        case OPCODE_CLEAR:
+        case OPCODE_DIMENSION:
+        case OPCODE_DEFINE_FUNCTION:
+        case OPCODE_PRINT_NUMBER:
+        case OPCODE_PRINT_STRING:
+        case OPCODE_RETURN:
+            return false;
+        default:
+            return true;
+    }
+}
+
+/// Emits the native code of a single instruction, instructions that are not implemented natively
+/// leave native code so that the virtual machine executes them
+static void jit_emit_instruction(JitCompiler *self, Instruction const instruction, u32 const index) {
+    JitAssembler *assembler = &self->assembler;
+    if (!jit_native((Opcode) instruction.opcode)) {
+        // Strings, printing and the instructions that end the chunk are left to the virtual machine
+        jit_emit_side_exit(self, index);
+        return;
+    }
+    switch ((Opcode) instruction.opcode) {
+        case OPCODE_LOAD_CONSTANT: {
+            u64 bits;
+            memcpy(&bits, self->chunk->numbers + instruction.c, sizeof bits);
+            jit_emit_immediate(assembler, JIT_RAX, bits);
+            jit_emit_memory(assembler, 0, true, 0x89, JIT_RAX, JIT_REGISTERS, jit_real(instruction.a));
+            break;
+        }
+        case OPCODE_LOAD_VARIABLE:
+            jit_emit_load(assembler, 0, JIT_VARIABLES, jit_real(instruction.c));
+            jit_emit_store(assembler, JIT_REGISTERS, jit_real(instruction.a), 0);
+            break;
+        case OPCODE_LOAD_INTEGER:
+            jit_emit_memory(assembler, 0, true, 0x8B, JIT_RAX, JIT_PROGRAM, (s32) offsetof(Program, integers));
+            jit_emit_memory(assembler, 0, false, 0x0FBF, JIT_RAX, JIT_RAX, (s32) (instruction.c * sizeof(s16)));
+            jit_emit_memory(assembler, 0, false, 0x89, JIT_RAX, JIT_INTEGERS, jit_integer(instruction.a));
+            break;
+        case OPCODE_LOAD_PARAMETER:
+            jit_emit_load(assembler, 0, JIT_PARAMETERS, jit_real(instruction.c));
+            jit_emit_store(assembler, JIT_REGISTERS, jit_real(instruction.a), 0);
+            break;
+        case OPCODE_LOAD_ELEMENT:
+            jit_emit_element(self, instruction.a, instruction.b, instruction.c);
+            jit_emit_element_address(assembler, (s32) offsetof(Program, real_elements), 3);
+            jit_emit_load(assembler, 0, JIT_RAX, 0);
+            jit_emit_store(assembler, JIT_REGISTERS, jit_real(instruction.a), 0);
+            break;
+        case OPCODE_LOAD_INTEGER_ELEMENT:
+            jit_emit_element(self, instruction.a, instruction.b, instruction.c);
+            jit_emit_element_address(assembler, (s32) offsetof(Program, integer_elements), 1);
+            jit_emit_memory(assembler, 0, false, 0x0FBF, JIT_RAX, JIT_RAX, 0);
+            jit_emit_memory(assembler, 0, false, 0x89, JIT_RAX, JIT_INTEGERS, jit_integer(instruction.a));
+            break;
+        case OPCODE_STORE_VARIABLE:
+            jit_emit_load(assembler, 0, JIT_REGISTERS, jit_real(instruction.a));
+            jit_emit_store(assembler, JIT_VARIABLES, jit_real(instruction.c), 0);
+            jit_emit_no_wait(assembler);
+            break;
+        case OPCODE_STORE_INTEGER:
+            jit_emit_register(assembler, 0, true, 0x89, JIT_PROGRAM, JIT_RDI);
+            jit_emit_immediate(assembler, JIT_RSI, instruction.c);
+            jit_emit_load(assembler, 0, JIT_REGISTERS, jit_real(instruction.a));
+            jit_emit_call(assembler, (usize) program_store_integer);
+            jit_emit_check(self);
+            jit_emit_no_wait(assembler);
+            break;
+        case OPCODE_STORE_ELEMENT:
+            jit_emit_element(self, instruction.a + 1, instruction.b, instruction.c);
+            jit_emit_element_address(assembler, (s32) offsetof(Program, real_elements), 3);
+            jit_emit_load(assembler, 0, JIT_REGISTERS, jit_real(instruction.a));
+            jit_emit_store(assembler, JIT_RAX, 0, 0);
+            jit_emit_no_wait(assembler);
+            break;
+        case OPCODE_STORE_INTEGER_ELEMENT:
+            jit_emit_element(self, instruction.a + 1, instruction.b, instruction.c);
+            jit_emit_register(assembler, 0, true, 0x89, JIT_PROGRAM, JIT_RDI);
+            jit_emit_register(assembler, 0, false, 0x89, JIT_RAX, JIT_RSI);
+            jit_emit_load(assembler, 0, JIT_REGISTERS, jit_real(instruction.a));
+            jit_emit_call(assembler, (usize) program_store_integer_element);
+            jit_emit_check(self);
+            jit_emit_no_wait(assembler);
+            break;
+        case OPCODE_PEEK:
+            jit_emit_register(assembler, 0, true, 0x89, JIT_PROGRAM, JIT_RDI);
+            jit_emit_load(assembler, 0, JIT_REGISTERS, jit_real(instruction.b));
+            jit_emit_memory(assembler, 0, true, 0x8D, JIT_RSI, JIT_REGISTERS, jit_real(instruction.a));
+            jit_emit_call(assembler, (usize) program_peek);
+            jit_emit_check(self);
+            break;
+        case OPCODE_POKE:
+            jit_emit_register(assembler, 0, true, 0x89, JIT_PROGRAM, JIT_RDI);
+            jit_emit_load(assembler, 0, JIT_REGISTERS, jit_real(instruction.a));
+            jit_emit_load(assembler, 1, JIT_REGISTERS, jit_real(instruction.b));
+            jit_emit_call(assembler, (usize) program_poke);
+            jit_emit_check(self);
+            jit_emit_no_wait(assembler);
+            break;
+        case OPCODE_NEGATE:
+            jit_emit_load(assembler, 0, JIT_REGISTERS, jit_real(instruction.b));
+            jit_emit_number(assembler, 1, -0.0);
+            jit_emit_register(assembler, 0x66, false, 0x0F57, 0, 1);
+            jit_emit_store(assembler, JIT_REGISTERS, jit_real(instruction.a), 0);
+            break;
+        case OPCODE_ADD:
+            jit_emit_arithmetic(assembler, instruction, 0x0F58);
+            break;
+        case OPCODE_SUB:
+            jit_emit_arithmetic(assembler, instruction, 0x0F5C);
+            break;
+        case OPCODE_MUL:
+            jit_emit_arithmetic(assembler, instruction, 0x0F59);
+            break;
+        case OPCODE_DIV:
+            jit_emit_arithmetic(assembler, instruction, 0x0F5E);
+            break;
+        case OPCODE_POWER:
+            jit_emit_load(assembler, 0, JIT_REGISTERS, jit_real(instruction.b));
+            jit_emit_load(assembler, 1, JIT_REGISTERS, jit_real(instruction.c));
+            jit_emit_call(assembler, (usize) pow);
+            jit_emit_store(assembler, JIT_REGISTERS, jit_real(instruction.a), 0);
+            break;
+        case OPCODE_CALL:
+            jit_emit_function_call(self, instruction);
+            break;
+        case OPCODE_EQUAL:
+            jit_emit_compare(assembler, instruction.a, instruction.b, instruction.c, JIT_PREDICATE_EQUAL);
+            break;
+        case OPCODE_NOT_EQUAL:
+            jit_emit_compare(assembler, instruction.a, instruction.b, instruction.c, JIT_PREDICATE_NOT_EQUAL);
+            break;
+        case OPCODE_LESS:
+            jit_emit_compare(assembler, instruction.a, instruction.b, instruction.c, JIT_PREDICATE_LESS);
+            break;
+        case OPCODE_LESS_EQUAL:
+            jit_emit_compare(assembler, instruction.a, instruction.b, instruction.c, JIT_PREDICATE_LESS_EQUAL);
+            break;
+        case OPCODE_GREATER:
+            // a > b is evaluated as b < a, which is false for NaN as well
+            jit_emit_compare(assembler, instruction.a, instruction.c, instruction.b, JIT_PREDICATE_LESS);
+            break;
+        case OPCODE_GREATER_EQUAL:
+            jit_emit_compare(assembler, instruction.a, instruction.c, instruction.b, JIT_PREDICATE_LESS_EQUAL);
+            break;
+        case OPCODE_NOT:
+            jit_emit_compare_zero(assembler, instruction, JIT_PREDICATE_EQUAL);
+            break;
+        case OPCODE_BOOLEAN:
+            jit_emit_compare_zero(assembler, instruction, JIT_PREDICATE_NOT_EQUAL);
+            break;
+        case OPCODE_INTEGER_CONSTANT:
+            jit_emit_memory(assembler, 0, false, 0xC7, 0, JIT_INTEGERS, jit_integer(instruction.a));
+            jit_emit_u32(assembler, instruction.c);
+            break;
+        case OPCODE_INTEGER_ADD:
+            jit_emit_integer_arithmetic(assembler, instruction, 0x03);
+            break;
+        case OPCODE_INTEGER_SUB:
+            jit_emit_integer_arithmetic(assembler, instruction, 0x2B);
+            break;
+        case OPCODE_INTEGER_MUL:
+            jit_emit_integer_arithmetic(assembler, instruction, 0x0FAF);
+            break;
+        case OPCODE_INTEGER_EQUAL:
+            jit_emit_integer_compare(assembler, instruction, JIT_CONDITION_EQUAL);
+            break;
+        case OPCODE_INTEGER_NOT_EQUAL:
+            jit_emit_integer_compare(assembler, instruction, JIT_CONDITION_NOT_EQUAL);
+            break;
+        case OPCODE_INTEGER_LESS:
+            jit_emit_integer_compare(assembler, instruction, JIT_CONDITION_LESS);
+            break;
+        case OPCODE_INTEGER_LESS_EQUAL:
+            jit_emit_integer_compare(assembler, instruction, JIT_CONDITION_LESS_EQUAL);
+            break;
+        case OPCODE_INTEGER_GREATER:
+            jit_emit_integer_compare(assembler, instruction, JIT_CONDITION_GREATER);
+            break;
+        case OPCODE_INTEGER_GREATER_EQUAL:
+            jit_emit_integer_compare(assembler, instruction, JIT_CONDITION_GREATER_EQUAL);
+            break;
+        case OPCODE_INTEGER_STORE:
+            jit_emit_register(assembler, 0, true, 0x89, JIT_PROGRAM, JIT_RDI);
+            jit_emit_immediate(assembler, JIT_RSI, instruction.c);
+            jit_emit_memory(assembler, 0, false, 0x8B, JIT_RDX, JIT_INTEGERS, jit_integer(instruction.a));
+            jit_emit_call(assembler, (usize) program_store_integer_exact);
+            jit_emit_check(self);
+            jit_emit_no_wait(assembler);
+            break;
+        case OPCODE_INTEGER_STORE_ELEMENT:
+            jit_emit_element(self, instruction.a + 1, instruction.b, instruction.c);
+            jit_emit_register(assembler, 0, true, 0x89, JIT_PROGRAM, JIT_RDI);
+            jit_emit_register(assembler, 0, false, 0x89, JIT_RAX, JIT_RSI);
+            jit_emit_memory(assembler, 0, false, 0x8B, JIT_RDX, JIT_INTEGERS, jit_integer(instruction.a));
+            jit_emit_call(assembler, (usize) program_store_integer_element_exact);
+            jit_emit_check(self);
+            jit_emit_no_wait(assembler);
+            break;
+        case OPCODE_INTEGER_TO_REAL:
+            jit_emit_memory(assembler, 0xF2, false, 0x0F2A, 0, JIT_INTEGERS, jit_integer(instruction.b));
+            jit_emit_store(assembler, JIT_REGISTERS, jit_real(instruction.a), 0);
+            break;
+        case OPCODE_BRANCH_FALSE:
+            // Unordered compares set the parity flag, NaN is not equal to zero
+            jit_emit_load(assembler, 0, JIT_REGISTERS, jit_real(instruction.a));
+            jit_emit_zero(assembler, 1);
+            jit_emit_register(assembler, 0x66, false, 0x0F2E, 0, 1);
+            jit_emit_byte(assembler, 0x7A);
+            jit_emit_byte(assembler, 6);
+            jit_emit_branch(self, JIT_CONDITION_EQUAL, instruction.c);
+            break;
+        case OPCODE_BRANCH_TRUE:
+            jit_emit_load(assembler, 0, JIT_REGISTERS, jit_real(instruction.a));
+            jit_emit_zero(assembler, 1);
+            jit_emit_register(assembler, 0x66, false, 0x0F2E, 0, 1);
+            jit_emit_branch(self, JIT_CONDITION_PARITY, instruction.c);
+            jit_emit_branch(self, JIT_CONDITION_NOT_EQUAL, instruction.c);
+            break;
+        case OPCODE_FOR:
+            jit_emit_load(assembler, 0, JIT_REGISTERS, 0);
+            jit_emit_store(assembler, JIT_VARIABLES, jit_real(instruction.c), 0);
+            jit_emit_register(assembler, 0, true, 0x89, JIT_PROGRAM, JIT_RDI);
+            jit_emit_immediate(assembler, JIT_RSI, instruction.c);
+            jit_emit_load(assembler, 0, JIT_REGISTERS, jit_real(1));
+            jit_emit_load(assembler, 1, JIT_REGISTERS, jit_real(2));
+            jit_emit_immediate(assembler, JIT_RDX, instruction.b);
+            jit_emit_call(assembler, (usize) program_for);
+            jit_emit_no_wait(assembler);
+            break;
+        case OPCODE_NEXT:
+            jit_emit_register(assembler, 0, true, 0x89, JIT_PROGRAM, JIT_RDI);
+            jit_emit_immediate(assembler, JIT_RSI, instruction.c);
+            jit_emit_call(assembler, (usize) program_next);
+            jit_emit_check(self);
+            break;
+        default:
+            break;
+    }
+}
+
+/// Emits the code that enters native code, which saves the callee saved registers, loads the state of
+/// the virtual machine and jumps to the entry, and the code that leaves it
+static void jit_emit_trampoline(Jit *self, JitAssembler *assembler) {
+    jit_emit_push(assembler, JIT_RBX);
+    jit_emit_push(assembler, JIT_R12);
+    jit_emit_push(assembler, JIT_R13);
+    jit_emit_push(assembler, JIT_R14);
+    jit_emit_push(assembler, JIT_R15);
+
+    // Five pushes and the return address keep the stack aligned to 16 bytes for calls
+    jit_emit_register(assembler, 0, true, 0x83, 5, JIT_RSP);
+    jit_emit_byte(assembler, JIT_STACK_SIZE);
+    jit_emit_memory(assembler, 0, true, 0x89, JIT_RDI, JIT_RSP, 8);
+    jit_emit_memory(assembler, 0, true, 0x8B, JIT_PROGRAM, JIT_RDI, (s32) offsetof(JitFrame, program));
+    jit_emit_memory(assembler, 0, true, 0x8B, JIT_PARAMETERS, JIT_RDI, (s32) offsetof(JitFrame, parameters));
+    jit_emit_memory(assembler, 0, true, 0x8B, JIT_REGISTERS, JIT_RDI, (s32) offsetof(JitFrame, registers));
+    jit_emit_memory(assembler, 0, true, 0x8B, JIT_INTEGERS, JIT_RDI, (s32) offsetof(JitFrame, integers));
+    jit_emit_memory(assembler, 0, true, 0x8B, JIT_VARIABLES, JIT_PROGRAM, (s32) offsetof(Program, variables));
+    jit_emit_register(assembler, 0, false, 0xFF, 4, JIT_RSI);
+
+    self->exit = (u32) assembler->size;
+    jit_emit_immediate(assembler, JIT_RAX, JIT_EXIT);
+
+    self->epilogue = (u32) assembler->size;
+    jit_emit_register(assembler, 0, true, 0x83, 0, JIT_RSP);
+    jit_emit_byte(assembler, JIT_STACK_SIZE);
+    jit_emit_pop(assembler, JIT_R15);
+    jit_emit_pop(assembler, JIT_R14);
+    jit_emit_pop(assembler, JIT_R13);
+    jit_emit_pop(assembler, JIT_R12);
+    jit_emit_pop(assembler, JIT_RBX);
+    jit_emit_byte(assembler, 0xC3);
+}
+
+/// Maps the executable memory and emits the code that enters and leaves native code
+static void jit_create(Jit *self) {
+    self->enabled = false;
+    self->full = true;
+    self->memory = NULL;
+    self->size = 0;
+    self->capacity = 0;
+    self->base = 0;
+    self->generation = 1;
+    self->exit = 0;
+    self->epilogue = 0;
+#if JIT_SUPPORTED
+    self->memory = memory_map(JIT_CAPACITY);
+#endif
+    if (self->memory == NULL) {
+        return;
+    }
+    self->capacity = JIT_CAPACITY;
+
+    JitAssembler assembler = { self->memory, 0, self->capacity };
+    jit_emit_trampoline(self, &assembler);
+    self->size = assembler.size;
+    self->base = assembler.size;
+    if (memory_protect(self->memory, memory_page_size(), MEMORY_PROTECTION_READ_EXECUTE)) {
+        self->enabled = true;
+        self->full = false;
+    }
+}
+
+/// Unmaps the executable memory
+static void jit_destroy(Jit *self) {
+#if JIT_SUPPORTED
+    if (self->memory != NULL) {
+        memory_unmap(self->memory, self->capacity);
+    }
+#endif
+    self->memory = NULL;
+    self->enabled = false;
+}
+
+/// Discards the native code of all chunks
+static void jit_reset(Jit *self) {
+    if (self->memory == NULL || self->size == self->base) {
+        return;
+    }
+
+    // The pages behind the one the trampoline ends in are made writable again, so that compiling only ever
+    // has to make the page writable that the previous chunk ends in
+    usize const page_size = memory_page_size();
+    usize const first = (self->base / page_size + 1) * page_size;
+    usize const end = (self->size + page_size - 1) / page_size * page_size;
+    if (end > first && !memory_protect(self->memory + first, end - first, MEMORY_PROTECTION_READ_WRITE)) {
+        return;
+    }
+    self->size = self->base;
+    self->full = false;
+    self->generation++;
+}
+
+/// Enables or disables native code, it stays disabled if there is no executable memory
+static void jit_enable(Jit *self, b32 const enabled) {
+    self->enabled = enabled && self->memory != NULL;
+}
+
+/// Compiles the chunk into the executable memory
+static b32 jit_compile(Jit *self, MemoryArena *arena, Program const *program, Chunk const *chunk) {
+    // The page that the previous chunk ends in is the only one that is executable and must be written,
+    // all pages behind it have never been executable
+    usize const page_size = memory_page_size();
+    u8 *page = self->memory + self->size / page_size * page_size;
+    if (!memory_protect(page, page_size, MEMORY_PROTECTION_READ_WRITE)) {
+        self->full = true;
+        return false;
+    }
+
+    JitCompiler compiler;
+    compiler.assembler = (JitAssembler) { self->memory, self->size, self->capacity };
+    compiler.jit = self;
+    compiler.program = program;
+    compiler.chunk = chunk;
+    // The offsets of a chunk whose native code has been discarded are reused
+    compiler.offsets = chunk->native->offsets;
+    if (compiler.offsets == NULL) {
+        compiler.offsets = arena_alloc(arena, chunk->length * sizeof(u32));
+    }
+    compiler.fixup_count = 0;
+    for (u32 index = 0; index < chunk->length; ++index) {
+        compiler.offsets[index] = (u32) compiler.assembler.size;
+        jit_emit_instruction(&compiler, chunk->code[index], index);
+    }
+    for (u32 fixup = 0; fixup < compiler.fixup_count; ++fixup) {
+        JitFixup const *it = compiler.fixups + fixup;
+        jit_patch(&compiler.assembler, it->displacement, compiler.offsets[it->target]);
+    }
+
+    b32 const fits = compiler.assembler.size <= self->capacity;
+    if (fits) {
+        self->size = compiler.assembler.size;
+        chunk->native->offsets = compiler.offsets;
+        chunk->native->generation = self->generation;
+    } else {
+        self->full = true;
+    }
+    usize const end = (self->size + page_size - 1) / page_size * page_size;
+    if (!memory_protect(page, (usize) (self->memory + end - page), MEMORY_PROTECTION_READ_EXECUTE)) {
+        // Native code that cannot be made executable must not be run
+        self->enabled = false;
+        self->full = true;
+        return false;
+    }
+    return fits;
+}
+
+/// Counts an execution of the chunk and compiles it once it is hot
+static b32 jit_ready(Program *program, Chunk const *chunk) {
+    JitCode *code = chunk->native;
+    if (code->generation == program->jit.generation) {
+        return true;
+    }
+    if (code->interpreted || program->jit.full || ++code->executions < JIT_THRESHOLD) {
+        return false;
+    }
+
+    u32 native = 0;
+    for (u32 index = 0; index < chunk->length; ++index) {
+        native += jit_native((Opcode) chunk->code[index].opcode);
+    }
+    if (native < JIT_MINIMUM) {
+        code->interpreted = true;
+        return false;
+    }
+    return jit_compile(&program->jit, &program->objects, program, chunk);
+}
+
+/// Runs the native code of a compiled chunk
+static u32 jit_run(Jit const *self, Chunk const *chunk, u32 const entry, JitFrame const *frame) {
+    JitFunction const function = (JitFunction) (void *) self->memory;
+    return function(frame, self->memory + chunk->native->offsets[entry]);
+}
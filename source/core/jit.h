@@ -0,0 +1,123 @@
+// Copyright (c) 2025 Elias Engelbert Plank
+
+#ifndef RETRO_JIT_H
+#define RETRO_JIT_H
+
+/// Forward declares
+typedef struct Chunk Chunk;
+typedef struct Program Program;
+
+/// Native code is only generated for the System V calling convention on x86-64
+#if defined(__x86_64__) && !defined(LIBRETRO_PLATFORM_WIN32)
+#define JIT_SUPPORTED 1
+#else
+#define JIT_SUPPORTED 0
+#endif
+
+enum {
+    /// The amount of times a chunk is run by the virtual machine before it is compiled to native code
+    JIT_THRESHOLD = 32,
+
+    /// The amount of instructions a chunk must implement natively, entering and leaving native code
+    /// costs more than running a few instructions in the virtual machine
+    JIT_MINIMUM = 4,
+
+    /// The size of the executable memory that the native code of all chunks shares
+    JIT_CAPACITY = 4 * 1024 * 1024
+};
+
+/// The instruction index that native code returns if the chunk returns without a value,
+/// e.g. because the program jumped or an error occurred
+#define JIT_EXIT UINT32_MAX
+
+/// The state of the virtual machine that native code runs on, which mirrors the arguments of vm_run
+typedef struct JitFrame {
+    Program *program;
+    f64 const *parameters;
+    f64 *registers;
+    s32 *integers;
+    String *strings;
+    f64 const *limit;
+} JitFrame;
+
+/// Enters native code at the specified address and returns the index of the instruction at which
+/// the virtual machine continues, or JIT_EXIT
+typedef u32 (*JitFunction)(JitFrame const *frame, u8 const *entry);
+
+/// The profile of a chunk, which is replaced by the native code once the chunk is hot
+typedef struct JitCode {
+    /// The amount of times the chunk was run by the virtual machine
+    u32 executions;
+
+    /// Whether the chunk is always run by the virtual machine, since native code would not be faster
+    b32 interpreted;
+
+    /// The offset of the native code of every instruction in the executable memory, or NULL
+    /// if the chunk has not been compiled yet
+    u32 *offsets;
+
+    /// The generation of the executable memory the chunk was compiled into, the offsets are
+    /// stale if the executable memory has been reset since
+    u32 generation;
+} JitCode;
+
+/// The executable memory all native code is emitted into. Memory is never writable and executable
+/// at the same time, pages are only made writable while a chunk is being compiled.
+typedef struct Jit {
+    /// Whether hot chunks are compiled and run natively, which can be toggled at runtime
+    b32 enabled;
+
+    /// Whether the executable memory is exhausted, in which case no further chunks are compiled
+    /// until the executable memory is reset
+    b32 full;
+    u8 *memory;
+    usize size;
+    usize capacity;
+
+    /// The size of the code that enters and leaves native code, the native code of the chunks
+    /// is emitted behind it
+    usize base;
+
+    /// Increases whenever the executable memory is reset, which discards the native code of all chunks
+    u32 generation;
+
+    /// The offsets of the code that leaves native code with JIT_EXIT and of the code that leaves
+    /// it with the instruction index in eax
+    u32 exit;
+    u32 epilogue;
+} Jit;
+
+/// Maps the executable memory and emits the code that enters and leaves native code
+/// @param self The jit handle
+static void jit_create(Jit *self);
+
+/// Unmaps the executable memory
+/// @param self The jit handle
+static void jit_destroy(Jit *self);
+
+/// Discards the native code of all chunks, so that the executable memory is reused. Chunks are
+/// compiled again the next time they are run.
+/// @param self The jit handle
+static void jit_reset(Jit *self);
+
+/// Enables or disables native code, it stays disabled if there is no executable memory
+/// @param self The jit handle
+/// @param enabled Whether native code is enabled
+static void jit_enable(Jit *self, b32 enabled);
+
+/// Counts an execution of the chunk and compiles it once it is hot
+/// @param program The program state, whose jit and object arena are used
+/// @param chunk The chunk that is about to be run
+/// @return A boolean value that indicates whether the chunk can be run natively
+static b32 jit_ready(Program *program, Chunk const *chunk);
+
+/// Runs the native code of a compiled chunk until it returns or reaches an instruction that is
+/// left to the virtual machine
+/// @param self The jit handle
+/// @param chunk The compiled chunk
+/// @param entry The index of the first instruction that is executed
+/// @param frame The state of the virtual machine
+/// @return The index of the instruction at which the virtual machine continues, or JIT_EXIT
+static u32 jit_run(Jit const *self, Chunk const *chunk, u32 entry, JitFrame const *frame);
+
+#endif// RETRO_JIT_H
@@ -1,90 +1,48 @@
 // Copyright (c) 2025 Elias Engelbert Plank
 
-/// Creates a new token instance
-static Token *token_new(TokenType const type, char const *lexeme, usize const length) {
-    // TODO(elias): use arena allocation
-    Token *self = malloc(sizeof(Token));
-    self->prev = NULL;
-    self->next = NULL;
-    self->type = type;
-    self->lexeme = (char *) malloc(length);
-    self->length = length;
-    memcpy(self->lexeme, lexeme, length);
-    return self;
-}
-
-/// Frees the specified token instance
-static void token_free(Token *self) {
-    self->prev = NULL;
-    self->next = NULL;
-    free(self->lexeme);
-    self->length = 0;
-    free(self);
+/// Creates a new token list
+static void token_list_create(TokenList *self, u32 const capacity) {
+    self->source = NULL;
+    self->count = 0;
+    self->capacity = capacity > 0 ? capacity : TOKEN_LIST_CAPACITY;
+    self->data = malloc(self->capacity * sizeof(Token));
 }
 
-/// Creates a new token list instance
-static TokenList *token_list_new(void) {
-    TokenList *self = malloc(sizeof(TokenList));
-    self->begin = NULL;
-    self->end = NULL;
-    self->tokens = 0;
-    return self;
+/// Destroys the specified token list
+static void token_list_destroy(TokenList *self) {
+    free(self->data);
+    self->source = NULL;
+    self->data = NULL;
+    self->count = 0;
+    self->capacity = 0;
 }
 
-/// Clears the specified token list (i.e. deletes all tokens)
+/// Removes all tokens from the specified token list
 static void token_list_clear(TokenList *self) {
-    Token *it = self->begin;
-
-    while (it != NULL) {
-        Token *tmp = it;
-        it = it->next;
-        token_free(tmp);
-    }
-    self->begin = NULL;
-    self->end = NULL;
-    self->tokens = 0;
-}
-
-/// Frees the specified token list (i.e. deletes tokens and free list)
-static void token_list_free(TokenList *self) {
-    token_list_clear(self);
-    free(self);
+    self->source = NULL;
+    self->count = 0;
 }
 
 /// Pushes a token to the specified token list
-static void token_list_push(TokenList *self, TokenType const type, char const *lexeme, usize const length) {
-    if (self == NULL) {
-        return;
-    }
-
-    Token *token = token_new(type, lexeme, length);
-    if (self->begin == NULL) {
-        self->begin = token;
-        self->end = token;
-        token->prev = NULL;
-        self->tokens++;
-        return;
+static void token_list_push(TokenList *self, TokenType const type, usize const offset, usize const length) {
+    if (self->count == self->capacity) {
+        self->capacity *= 2;
+        self->data = realloc(self->data, self->capacity * sizeof(Token));
     }
-
-    Token *tmp = self->begin;
-    while (tmp->next != NULL) {
-        tmp = tmp->next;
-    }
-
-    tmp->next = token;
-    token->prev = tmp;
-    self->end = token;
-    self->tokens++;
+    Token *token = self->data + self->count++;
+    token->type = type;
+    token->offset = (u32) offset;
+    token->length = (u32) length;
 }
 
 typedef struct StringIterator {
-    char *base;
+    char const *base;
     usize length;
     usize index;
 } StringIterator;
 
 /// Creates a string iterator
-static void string_iterator_create(StringIterator *self, char *base, usize const length) {
+static void string_iterator_create(StringIterator *self, char const *base, usize const length) {
     self->base = base;
     self->length = length;
     self->index = 0;
@@ -92,24 +50,24 @@ static void string_iterator_create(StringIterator *self, char *base, usize const
 
 /// Advances the string iterator by one
 static void string_iterator_advance(StringIterator *self) {
-    if (self->index < self->length - 1) {
+    if (self->index < self->length) {
         self->index++;
     }
 }
 
-/// Retrieves the current char of the iterator
+/// Retrieves the current char of the iterator, which is zero at the end
 static char string_iterator_current(StringIterator const *self) {
-    return self->base[self->index];
+    return self->index < self->length ? self->base[self->index] : '\0';
 }
 
-/// Retrieves the next char of the iterator
+/// Retrieves the next char of the iterator, which is zero at the end
 static char string_iterator_next(StringIterator const *self) {
-    return self->base[self->index + 1];
+    return self->index + 1 < self->length ? self->base[self->index + 1] : '\0';
 }
 
 /// Checks if the iterator is at the end
 static b32 string_iterator_end(StringIterator const *self) {
-    return self->index == self->length - 1;
+    return self->index >= self->length;
 }
 
 /// Checks if the specified char is a trivial token
@@ -171,17 +129,88 @@ static TokenType tokenize_trivial_to_type(char const current) {
     }
 }
 
-/// Checks if two string views are equal
-static b32 string_view_equal(const char *first, usize const first_size, const char *second, usize const second_size) {
-    if (first_size != second_size) {
-        return false;
+/// Checks if the string view starts with the specified keyword
+static b32 tokenize_has_prefix(const char *data, usize const length, const char *keyword, usize const keyword_length) {
+    return length >= keyword_length && memcmp(data, keyword, keyword_length) == 0;
+}
+
+/// Matches the keyword against the string view and returns from the enclosing function on success
+#define TOKENIZE_KEYWORD(keyword, type)                                    \
+    if (tokenize_has_prefix(data, length, keyword, sizeof(keyword) - 1)) { \
+        *keyword_length = sizeof(keyword) - 1;                             \
+        return type;                                                       \
     }
-    return strncmp(first, second, first_size) == 0;
+
+/// Checks if a keyword starts at the beginning of the string view. Keywords are dispatched on
+/// their first character, candidates that share a first character are ordered from longest
+/// to shortest, so a lookup only compares against a handful of keywords regardless of how
+/// many keywords there are in total.
+static TokenType tokenize_keyword(const char *data, usize const length, usize *keyword_length) {
+    switch (data[0]) {
+        case 'A':
+            TOKENIZE_KEYWORD("AND", TOKEN_AND);
+            break;
+        case 'C':
+            TOKENIZE_KEYWORD("CLEAR", TOKEN_CLEAR);
+            break;
+        case 'D':
+            TOKENIZE_KEYWORD("DEF", TOKEN_DEF);
+            TOKENIZE_KEYWORD("DIM", TOKEN_DIM);
+            break;
+        case 'E':
+            TOKENIZE_KEYWORD("EXIT", TOKEN_EXIT);
+            break;
+        case 'F':
+            TOKENIZE_KEYWORD("FOR", TOKEN_FOR);
+            TOKENIZE_KEYWORD("FN", TOKEN_FN);
+            break;
+        case 'G':
+            TOKENIZE_KEYWORD("GOSUB", TOKEN_GOSUB);
+            TOKENIZE_KEYWORD("GOTO", TOKEN_GOTO);
+            break;
+        case 'I':
+            TOKENIZE_KEYWORD("IF", TOKEN_IF);
+            break;
+        case 'L':
+            TOKENIZE_KEYWORD("LET", TOKEN_LET);
+            break;
+        case 'N':
+            TOKENIZE_KEYWORD("NEXT", TOKEN_NEXT);
+            TOKENIZE_KEYWORD("NOT", TOKEN_NOT);
+            break;
+        case 'O':
+            TOKENIZE_KEYWORD("ON", TOKEN_ON);
+            TOKENIZE_KEYWORD("OR", TOKEN_OR);
+            break;
+        case 'P':
+            TOKENIZE_KEYWORD("PRINT", TOKEN_PRINT);
+            TOKENIZE_KEYWORD("POKE", TOKEN_POKE);
+            break;
+        case 'R':
+            TOKENIZE_KEYWORD("RETURN", TOKEN_RETURN);
+            TOKENIZE_KEYWORD("RUN", TOKEN_RUN);
+            break;
+        case 'S':
+            TOKENIZE_KEYWORD("STEP", TOKEN_STEP);
+            break;
+        case 'T':
+            TOKENIZE_KEYWORD("THEN", TOKEN_THEN);
+            TOKENIZE_KEYWORD("TO", TOKEN_TO);
+            break;
+        default:
+            break;
+    }
+    *keyword_length = 0;
+    return TOKEN_IDENTIFIER;
 }
 
-/// Tokenizes the specified data
-static TokenList *tokenize(char *data, usize const length) {
-    TokenList *list = token_list_new();
+#undef TOKENIZE_KEYWORD
+
+/// Tokenizes the specified data into the token list, previous tokens are removed
+static void tokenize(TokenList *self, char const *data, usize const length) {
+    token_list_clear(self);
+    self->source = data;
+
     StringIterator iterator;
     string_iterator_create(&iterator, data, length);
     while (!string_iterator_end(&iterator)) {
@@ -192,67 +221,59 @@ static TokenList *tokenize(char *data, usize const length) {
         }
 
         // check if we have a trivial token (i.e., token of length 1)
-        char current_trivial = string_iterator_current(&iterator);
+        char const current_trivial = string_iterator_current(&iterator);
         if (tokenize_is_trivial_token(current_trivial)) {
-            TokenType const type = tokenize_trivial_to_type(current_trivial);
-            token_list_push(list, type, &current_trivial, 1);
+            token_list_push(self, tokenize_trivial_to_type(current_trivial), iterator.index, 1);
             string_iterator_advance(&iterator);
             continue;
         }
 
-        // string-literals
+        // string-literals, the lexeme does not include the quotes
         if (string_iterator_current(&iterator) == '"') {
             string_iterator_advance(&iterator);
-            char const *lexeme = iterator.base + iterator.index;
             usize const begin_index = iterator.index;
 
             char previous = 0;
-            while (string_iterator_current(&iterator) != '"' || previous == '\\') {
+            while (!string_iterator_end(&iterator) && (string_iterator_current(&iterator) != '"' || previous == '\\')) {
                 previous = string_iterator_current(&iterator);
                 string_iterator_advance(&iterator);
             }
-            usize const end_index = iterator.index;
-            usize const lexeme_length = end_index - begin_index;
-            token_list_push(list, TOKEN_STRING, lexeme, lexeme_length);
+            token_list_push(self, TOKEN_STRING, begin_index, iterator.index - begin_index);
+            string_iterator_advance(&iterator);
+            continue;
         }
 
-        // alphabetic characters
+        // alphabetic characters, keywords are recognized even if they are not separated from the
+        // surrounding text (e.g. PRINTA or DEFFNF(X)), just like in Applesoft BASIC
         if (isalpha(string_iterator_current(&iterator))) {
-            char const *lexeme = iterator.base + iterator.index;
-            usize const begin_index = iterator.index;
+            usize keyword_length;
+            TokenType const keyword = tokenize_keyword(iterator.base + iterator.index,
+                                                       iterator.length - iterator.index, &keyword_length);
+            if (keyword != TOKEN_IDENTIFIER) {
+                token_list_push(self, keyword, iterator.index, keyword_length);
+                iterator.index += keyword_length;
+                continue;
+            }
 
-            // NOTE(elias): could include a shortcut here because once we stumble upon
-            // a numeric character, we know that it can only be an identifier.
-            while (isalnum(string_iterator_current(&iterator))) {
+            // An identifier ends where the next keyword starts
+            usize const begin_index = iterator.index;
+            do {
                 string_iterator_advance(&iterator);
-            }
+            } while (isalnum(string_iterator_current(&iterator)) &&
+                     (isdigit(string_iterator_current(&iterator)) ||
+                      tokenize_keyword(iterator.base + iterator.index, iterator.length - iterator.index,
+                                       &keyword_length) == TOKEN_IDENTIFIER));
 
-            usize const end_index = iterator.index;
-            usize const lexeme_length = end_index - begin_index;
-
-            if (string_view_equal(lexeme, lexeme_length, "PRINT", 5)) {
-                token_list_push(list, TOKEN_PRINT, lexeme, lexeme_length);
-            } else if (string_view_equal(lexeme, lexeme_length, "FN", 2)) {
-                token_list_push(list, TOKEN_FN, lexeme, lexeme_length);
-            } else if (string_view_equal(lexeme, lexeme_length, "DEF", 3)) {
-                token_list_push(list, TOKEN_DEF, lexeme, lexeme_length);
-            } else if (string_view_equal(lexeme, lexeme_length, "LET", 3)) {
-                token_list_push(list, TOKEN_LET, lexeme, lexeme_length);
-            } else if (string_view_equal(lexeme, lexeme_length, "RUN", 3)) {
-                token_list_push(list, TOKEN_RUN, lexeme, lexeme_length);
-            } else if (string_view_equal(lexeme, lexeme_length, "EXIT", 4)) {
-                token_list_push(list, TOKEN_EXIT, lexeme, lexeme_length);
-            } else if (string_view_equal(lexeme, lexeme_length, "CLEAR", 5)) {
-                token_list_push(list, TOKEN_CLEAR, lexeme, lexeme_length);
-            } else {
-                token_list_push(list, TOKEN_IDENTIFIER, lexeme, lexeme_length);
+            // The type suffix of integer and string variables is part of the identifier
+            if (string_iterator_current(&iterator) == '%' || string_iterator_current(&iterator) == '$') {
+                string_iterator_advance(&iterator);
             }
+            token_list_push(self, TOKEN_IDENTIFIER, begin_index, iterator.index - begin_index);
             continue;
         }
 
         // numbers
         if (isdigit(string_iterator_current(&iterator))) {
-            char const *lexeme = iterator.base + iterator.index;
             TokenType type = TOKEN_NUMBER;
             usize const begin_index = iterator.index;
             while (isdigit(string_iterator_current(&iterator))) {
@@ -264,34 +285,38 @@ static TokenList *tokenize(char *data, usize const length) {
                     string_iterator_advance(&iterator);
                 } while (isdigit(string_iterator_current(&iterator)));
             }
-            token_list_push(list, type, lexeme, iterator.index - begin_index);
+            token_list_push(self, type, begin_index, iterator.index - begin_index);
             continue;
         }
 
         string_iterator_advance(&iterator);
     }
-    return list;
+}
+
+/// Creates a token iterator over all tokens of the list
+static void token_iterator_create(TokenIterator *self, TokenList const *list) {
+    self->source = list->source;
+    self->current = list->data;
+    self->end = list->data + list->count;
 }
 
 /// Checks if the token iterator reached the end
 static b32 token_iterator_end(TokenIterator const *self) {
-    return self->current == self->end;
+    return self->current >= self->end;
 }
 
 /// Returns an invalid token
 static Token *token_iterator_invalid(void) {
     static Token token = { 0 };
     token.type = TOKEN_INVALID;
-    token.lexeme = "";
+    token.offset = 0;
     token.length = 0;
-    token.prev = NULL;
-    token.next = NULL;
     return &token;
 }
 
 /// Retrieves the current token
 static Token *token_iterator_current(TokenIterator const *self) {
-    if (self->current) {
+    if (!token_iterator_end(self)) {
         return self->current;
     }
     return token_iterator_invalid();
@@ -299,8 +324,8 @@ static Token *token_iterator_current(TokenIterator const *self) {
 
 /// Retrieves the next token
 static Token *token_iterator_next(TokenIterator const *self) {
-    if (!token_iterator_end(self)) {
-        return self->current->next;
+    if (self->current + 1 < self->end) {
+        return self->current + 1;
     }
     return token_iterator_invalid();
 }
@@ -308,8 +333,25 @@ static Token *token_iterator_next(TokenIterator const *self) {
 /// Advances the token cursor by one
 static void token_iterator_advance(TokenIterator *self) {
     if (!token_iterator_end(self)) {
-        self->current = self->current->next;
-    } else {
-        self->current = token_iterator_invalid();
+        self->current++;
     }
 }
+
+/// Retrieves the lexeme of the specified token, which is not terminated
+static char const *token_iterator_lexeme(TokenIterator const *self, Token const *token) {
+    if (token->type == TOKEN_INVALID) {
+        return "";
+    }
+    return self->source + token->offset;
+}
+
+/// Converts the lexeme of the specified number token to its value
+static f64 token_iterator_number(TokenIterator const *self, Token const *token) {
+    // The lexeme is not terminated and may be followed by characters that strtod would
+    // consume (e.g. an exponent), so it is copied into a terminated buffer first
+    char buffer[TOKEN_NUMBER_LENGTH];
+    usize const length = token->length < sizeof buffer - 1 ? token->length : sizeof buffer - 1;
+    memcpy(buffer, token_iterator_lexeme(self, token), length);
+    buffer[length] = '\0';
+    return strtod(buffer, NULL);
+}
@@ -28,73 +28,93 @@ typedef enum TokenType {
     // Keywords
     TOKEN_LET,
     TOKEN_CLEAR,
+    TOKEN_DIM,
     TOKEN_PRINT,
+    TOKEN_POKE,
     TOKEN_DEF,
     TOKEN_FN,
+    TOKEN_GOTO,
+    TOKEN_GOSUB,
+    TOKEN_RETURN,
+    TOKEN_ON,
+    TOKEN_FOR,
+    TOKEN_TO,
+    TOKEN_STEP,
+    TOKEN_NEXT,
+    TOKEN_IF,
+    TOKEN_THEN,
+    TOKEN_AND,
+    TOKEN_OR,
+    TOKEN_NOT,
 
     // Emulator commands
     TOKEN_RUN,
     TOKEN_EXIT
 } TokenType;
 
+/// A token refers to its lexeme by an offset into the source buffer, the
+/// source must therefore outlive the token
 typedef struct Token {
-    struct Token *prev;
-    struct Token *next;
     TokenType type;
-    char *lexeme;
-    usize length;
+    u32 offset;
+    u32 length;
 } Token;
 
-/// Creates a new token instance
-/// @param type The type of the token
-/// @param lexeme The string of the token
-/// @param length The length of the lexeme
-/// @return A new token instance
-static Token *token_new(TokenType type, char const *lexeme, usize length);
-
-/// Frees the specified token instance
-/// @param self The token instance
-static void token_free(Token *self);
+enum {
+    TOKEN_LIST_CAPACITY = 256,
+    TOKEN_NUMBER_LENGTH = 64
+};
 
+/// The tokens of a source buffer, which are stored contiguously. A token list
+/// can be reused for multiple sources, in which case tokenizing does not allocate
+/// once the list is large enough.
 typedef struct TokenList {
-    Token *begin;
-    Token *end;
-    usize tokens;
+    char const *source;
+    Token *data;
+    u32 count;
+    u32 capacity;
 } TokenList;
 
-/// Creates a new token list instance
-/// @return A new token list
-static TokenList *token_list_new(void);
+/// Creates a new token list
+/// @param self The token list instance
+/// @param capacity The amount of tokens for which space is reserved
+static void token_list_create(TokenList *self, u32 capacity);
 
-/// Clears the specified token list (i.e. deletes all tokens)
+/// Destroys the specified token list
 /// @param self The token list instance
-static void token_list_clear(TokenList *self);
+static void token_list_destroy(TokenList *self);
 
-/// Frees the specified token list (i.e. deletes tokens and free list)
+/// Removes all tokens from the specified token list
 /// @param self The token list instance
-static void token_list_free(TokenList *self);
+static void token_list_clear(TokenList *self);
 
 /// Pushes a token to the specified token list
 /// @param self The token list instance
 /// @param type The type of the token
-/// @param lexeme The string of the token
+/// @param offset The offset of the lexeme in the source
 /// @param length The length of the lexeme
-static void token_list_push(TokenList *self, TokenType type, char const *lexeme, usize length);
+static void token_list_push(TokenList *self, TokenType type, usize offset, usize length);
 
-/// Tokenizes the specified data
+/// Tokenizes the specified data into the token list, previous tokens are removed
+/// @param self The token list instance
 /// @param data The string that shall be tokenized
 /// @param length The length of the string
-/// @return A new token list
-static TokenList *tokenize(char *data, usize length);
+static void tokenize(TokenList *self, char const *data, usize length);
 
 typedef struct TokenIterator {
+    char const *source;
     Token *current;
     Token *end;
 } TokenIterator;
 
+/// Creates a token iterator over all tokens of the list
+/// @param self The token iterator
+/// @param list The token list
+static void token_iterator_create(TokenIterator *self, TokenList const *list);
+
 /// Checks if the token iterator reached the end
 /// @param self The token iterator
-/// @return A b32ean that indicates whether the iterator is at the end
+/// @return A boolean that indicates whether the iterator is at the end
 static b32 token_iterator_end(TokenIterator const *self);
 
 /// Returns an invalid token
@@ -115,4 +135,16 @@ static Token *token_iterator_next(TokenIterator const *self);
 /// @param self The token iterator
 static void token_iterator_advance(TokenIterator *self);
 
+/// Retrieves the lexeme of the specified token, which is not terminated
+/// @param self The token iterator
+/// @param token The token
+/// @return A pointer to the first character of the lexeme
+static char const *token_iterator_lexeme(TokenIterator const *self, Token const *token);
+
+/// Converts the lexeme of the specified number token to its value
+/// @param self The token iterator
+/// @param token The token
+/// @return The value of the number
+static f64 token_iterator_number(TokenIterator const *self, Token const *token);
+
 #endif// RETRO_LEXER_H
@@ -1,140 +1,806 @@
 ﻿// Copyright (c) 2025 Elias Engelbert Plank
 
-/// Creates a new program tree
-static void program_tree_create(ProgramTree *tree) {
-    tree->root = NULL;
-    tree->arena = arena_identity(ALIGNMENT8);
-}
-
-/// Destroys the program tree
-static void program_tree_destroy(ProgramTree *tree) {
-    tree->root = NULL;
-    arena_destroy(&tree->arena);
-}
-
-/// Clears all nodes of the program tree
-static void program_tree_clear(ProgramTree *tree) {
-    program_tree_destroy(tree);
-    program_tree_create(tree);
-}
-
-/// Creates a program tree node
-static ProgramTreeNode *program_tree_node_create(MemoryArena *arena, Statement *stmt) {
-    ProgramTreeNode *self = arena_alloc(arena, sizeof(ProgramTreeNode));
-    self->left = NULL;
-    self->right = NULL;
-    self->stmt = stmt;
-    return self;
-}
-
-/// Insert the given statement at a feasible position starting at the specified node
-static void program_tree_node_insert(MemoryArena *arena, ProgramTreeNode *node, Statement *stmt) {
-    // TODO(elias): program tree should probably be ordered into heap rather than tree
-    usize const node_line = node->stmt->line;
-    usize const stmt_line = stmt->line;
-
-    ProgramTreeNode **walk_position = NULL;
-    if (stmt_line > node_line) {
-        walk_position = &node->right;
-    } else if (stmt_line < node_line) {
-        walk_position = &node->left;
-    } else {
-        // Change stmt at the current node
-        node->stmt = stmt;
-        return;
-    }
+/// Creates a new program line array
+static void program_lines_create(ProgramLines *lines) {
+    lines->count = 0;
+    lines->capacity = PROGRAM_LINE_CAPACITY;
+    lines->data = malloc(lines->capacity * sizeof(ProgramLine));
+    lines->indices = malloc(lines->capacity * sizeof(u32));
+    lines->pending = malloc(lines->capacity * sizeof(u32));
+    lines->pending_count = 0;
+}
+
+/// Destroys the program line array
+static void program_lines_destroy(ProgramLines *lines) {
+    free(lines->data);
+    free(lines->indices);
+    free(lines->pending);
+    lines->data = NULL;
+    lines->indices = NULL;
+    lines->pending = NULL;
+    lines->count = 0;
+    lines->capacity = 0;
+    lines->pending_count = 0;
+}
 
-    // No node at walk position
-    if (*walk_position == NULL) {
-        *walk_position = program_tree_node_create(arena, stmt);
-    } else {
-        // Node at walk position, traverse down
-        program_tree_node_insert(arena, *walk_position, stmt);
+/// Removes all lines of the program
+static void program_lines_clear(ProgramLines *lines) {
+    lines->count = 0;
+    lines->pending_count = 0;
+}
+
+/// Retrieves the index of the first line whose number is not less than the specified line
+static u32 program_lines_search(ProgramLines const *lines, usize const line) {
+    u32 low = 0;
+    u32 high = lines->count;
+    while (low < high) {
+        u32 const middle = low + (high - low) / 2;
+        if (lines->data[middle].line < line) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
     }
+    return low;
 }
 
-/// Inserts the given statement into the program tree
-static void program_tree_insert(ProgramTree *tree, Statement *stmt) {
-    if (tree->root == NULL) {
-        tree->root = program_tree_node_create(&tree->arena, stmt);
-    } else {
-        program_tree_node_insert(&tree->arena, tree->root, stmt);
+/// Marks the line as pending, so that its jumps are linked before the program is run
+static void program_lines_mark(ProgramLines *lines, ProgramLine *line) {
+    if (!line->pending) {
+        line->pending = true;
+        lines->pending[lines->pending_count++] = line->identifier;
     }
 }
 
-static ProgramTreeNode *program_tree_node_get(ProgramTreeNode *node, usize const line) {
-    if (node == NULL) {
-        return NULL;
+/// Inserts the given statement into the program, a statement with the same line number is replaced
+static void program_lines_insert(ProgramLines *lines, Statement *stmt) {
+    // Lines are usually typed in ascending order, in which case they are simply appended
+    u32 index = lines->count;
+    if (lines->count > 0 && lines->data[lines->count - 1].line >= stmt->line) {
+        index = program_lines_search(lines, stmt->line);
+        if (lines->data[index].line == stmt->line) {
+            lines->data[index].stmt = stmt;
+            program_lines_mark(lines, lines->data + index);
+            return;
+        }
     }
-    usize const node_line = node->stmt->line;
-    if (node_line > line) {
-        return program_tree_node_get(node->left, line);
+
+    if (lines->count == lines->capacity) {
+        lines->capacity *= 2;
+        lines->data = realloc(lines->data, lines->capacity * sizeof(ProgramLine));
+        lines->indices = realloc(lines->indices, lines->capacity * sizeof(u32));
+        lines->pending = realloc(lines->pending, lines->capacity * sizeof(u32));
     }
-    if (node_line < line) {
-        return program_tree_node_get(node->right, line);
+
+    // Lines are never removed, so the line count is a fresh identifier. Only the lines after the
+    // inserted one move, and jumps to them stay valid since only their indices are updated.
+    memmove(lines->data + index + 1, lines->data + index, (lines->count - index) * sizeof(ProgramLine));
+    for (u32 moved = index + 1; moved <= lines->count; ++moved) {
+        lines->indices[lines->data[moved].identifier] = moved;
     }
-    return node;
+    ProgramLine *line = lines->data + index;
+    line->line = stmt->line;
+    line->stmt = stmt;
+    line->identifier = lines->count++;
+    line->pending = false;
+    lines->indices[line->identifier] = index;
+    program_lines_mark(lines, line);
+}
+
+/// Links the jumps of the pending lines
+static void program_lines_link(ProgramLines *lines) {
+    // A jump to a missing line may be resolved by a line that has been inserted since
+    u32 count = 0;
+    for (u32 index = 0; index < lines->pending_count; ++index) {
+        ProgramLine *line = lines->data + lines->indices[lines->pending[index]];
+        line->pending = !statement_link(line->stmt, lines);
+        if (line->pending) {
+            lines->pending[count++] = line->identifier;
+        }
+    }
+    lines->pending_count = count;
+}
+
+/// Retrieves a program line from the given line number
+static ProgramLine *program_lines_get(ProgramLines const *lines, usize const line) {
+    u32 const index = program_lines_search(lines, line);
+    if (index < lines->count && lines->data[index].line == line) {
+        return lines->data + index;
+    }
+    return NULL;
+}
+
+/// Creates the arena of the program objects, which reserves address space up front and commits it
+/// as the program grows, so that large programs do not allocate block after block
+static MemoryArena program_objects_arena(void) {
+#ifdef LIBRETRO_PLATFORM_WIN32
+    return arena_identity(ALIGNMENT8);
+#else
+    ArenaSpecification spec;
+    spec.alignment = ALIGNMENT8;
+    spec.reserve = memory_reserve;
+    spec.commit = memory_commit;
+    spec.release = memory_unmap;
+    return arena_make(&spec);
+#endif
+}
+
+/// Creates an empty symbol table, where no name has a slot yet
+static void program_symbols_create(ProgramSymbols *self) {
+    self->capacity = PROGRAM_SLOT_CAPACITY;
+    self->slots = malloc(self->capacity * sizeof(u32));
+    memset(self->slots, 0xFF, self->capacity * sizeof(u32));
 }
 
-/// Retrieves a program tree node from the given line
-static ProgramTreeNode *program_tree_get(ProgramTree const *tree, usize const line) {
-    return program_tree_node_get(tree->root, line);
+/// Destroys the symbol table
+static void program_symbols_destroy(ProgramSymbols *self) {
+    free(self->slots);
+    self->slots = NULL;
+    self->capacity = 0;
 }
 
 /// Creates a program which serves as the handle between emulator and AST
 static void program_create(Program *self, Renderer *renderer) {
-    self->objects = arena_identity(ALIGNMENT8);
-    self->symbols = hash_map_new();
+    self->objects = program_objects_arena();
+    self->runtime = arena_identity(ALIGNMENT8);
+    expression_pool_create(&self->expressions);
+    program_symbols_create(&self->symbols);
+    program_symbols_create(&self->function_symbols);
+    program_symbols_create(&self->array_symbols);
+
+    self->variable_count = 0;
+    self->variable_capacity = PROGRAM_SLOT_CAPACITY;
+    self->variables = calloc(self->variable_capacity, sizeof(f64));
+
+    self->integer_count = 0;
+    self->integer_capacity = PROGRAM_SLOT_CAPACITY;
+    self->integers = calloc(self->integer_capacity, sizeof(s16));
+
+    self->string_count = 0;
+    self->string_capacity = PROGRAM_SLOT_CAPACITY;
+    self->strings = calloc(self->string_capacity, sizeof(String));
+    string_heap_create(&self->heap);
+
+    self->array_count = 0;
+    self->array_capacity = PROGRAM_SLOT_CAPACITY;
+    self->arrays = calloc(self->array_capacity, sizeof(Array));
+    self->real_element_count = 0;
+    self->real_element_capacity = 0;
+    self->real_elements = NULL;
+    self->integer_element_count = 0;
+    self->integer_element_capacity = 0;
+    self->integer_elements = NULL;
+    self->string_element_count = 0;
+    self->string_element_capacity = 0;
+    self->string_elements = NULL;
+
+    self->function_count = 0;
+    self->function_capacity = PROGRAM_SLOT_CAPACITY;
+    self->functions = calloc(self->function_capacity, sizeof(FunctionDefinition const *));
+    self->defined_functions = calloc(self->function_capacity, sizeof(b32));
+    self->pending_functions = calloc(self->function_capacity, sizeof(b32));
+    self->parameter_top = 0;
+    self->parameter_frame = 0;
     self->renderer = renderer;
     self->text_position.x = (f32) PROGRAM_MARGIN_SIZE;
     self->text_position.y = (f32) PROGRAM_MARGIN_SIZE;
 
-    program_tree_create(&self->lines);
+    program_lines_create(&self->lines);
+    self->counter = 0;
+    self->loop_count = 0;
+    self->return_count = 0;
+    self->error = NULL;
+    self->mode = PROGRAM_MODE_BYTECODE;
+    jit_create(&self->jit);
+    address_space_create(&self->memory);
     self->last_key = -1;
     self->no_wait = false;
 }
 
 /// Destroys the program and all its data
 static void program_destroy(Program *self) {
-    program_tree_destroy(&self->lines);
+    program_lines_destroy(&self->lines);
 
-    hash_map_free(self->symbols);
-    self->symbols = NULL;
+    program_symbols_destroy(&self->symbols);
+    program_symbols_destroy(&self->function_symbols);
+    program_symbols_destroy(&self->array_symbols);
+
+    free(self->variables);
+    free(self->integers);
+    free(self->strings);
+    free(self->functions);
+    free(self->defined_functions);
+    free(self->pending_functions);
+    self->variables = NULL;
+    self->integers = NULL;
+    self->strings = NULL;
+    string_heap_destroy(&self->heap);
+    free(self->arrays);
+    self->arrays = NULL;
+    self->real_elements = NULL;
+    self->integer_elements = NULL;
+    self->string_elements = NULL;
+    self->functions = NULL;
+    self->defined_functions = NULL;
+    self->pending_functions = NULL;
     self->renderer = NULL;
 
+    jit_destroy(&self->jit);
+    expression_pool_destroy(&self->expressions);
     arena_destroy(&self->objects);
+    arena_destroy(&self->runtime);
 }
 
-/// Executes a program tree node
-static void program_tree_node_execute(ProgramTreeNode const *node, Program *program) {
-    if (node == NULL) {
+/// Reports the error that stopped the program in the specified line
+static void program_report_error(Program *self, usize const line) {
+    // Programs that are run without a window report errors on the standard error, after the output so far
+    if (self->renderer == NULL) {
+        fflush(stdout);
+        fprintf(stderr, "?%s ERROR IN %zu\n", self->error, line);
         return;
     }
-    if (node->left != NULL) {
-        program_tree_node_execute(node->left, program);
+    program_print_format(self, "?%s ERROR IN %zu\n", self->error, line);
+}
+
+/// Resolves the references of the form NAME(...) again once the whole program is known, as a line may
+/// use an array or call a function before the line that dimensions the array or defines the function
+static b32 program_bind(Program *self) {
+    ProgramLines const *lines = &self->lines;
+    if (lines->pending_count == 0) {
+        return true;
+    }
+
+    // Entering a line may add or remove a definition, which changes the meaning of the references in all lines
+    b32 *defined = self->pending_functions;
+    memset(defined, 0, self->function_capacity * sizeof(b32));
+    for (u32 index = 0; index < lines->count; ++index) {
+        statement_define_functions(lines->data[index].stmt, defined);
     }
+    b32 const changed = memcmp(defined, self->defined_functions, self->function_count * sizeof(b32)) != 0;
+    self->pending_functions = self->defined_functions;
+    self->defined_functions = defined;
 
-    statement_execute(node->stmt, program);
+    u32 const count = changed ? lines->count : lines->pending_count;
+    for (u32 index = 0; index < count; ++index) {
+        ProgramLine const *line = lines->data + (changed ? index : lines->indices[lines->pending[index]]);
+        if (statement_bind(line->stmt, self) == NULL) {
+            continue;
+        }
 
-    if (node->right != NULL) {
-        program_tree_node_execute(node->right, program);
+        // The lines are bound to the previous definitions again, which they have been compiled for before. Both
+        // buffers grow together, so the slots that binding has added are undefined in either of them.
+        b32 *current = self->defined_functions;
+        self->defined_functions = self->pending_functions;
+        self->pending_functions = current;
+        for (u32 undo = 0; undo <= index; ++undo) {
+            statement_bind(lines->data[changed ? undo : lines->indices[lines->pending[undo]]].stmt, self);
+        }
+        program_error(self, "SYNTAX");
+        program_report_error(self, line->line);
+        return false;
     }
+    return true;
 }
 
 /// Executes the program
-static void program_execute(Program *self) {
+static b32 program_execute(Program *self) {
     self->text_position.x = PROGRAM_MARGIN_SIZE;
     self->text_position.y = PROGRAM_MARGIN_SIZE;
-    program_tree_node_execute(self->lines.root, self);
+    self->error = NULL;
+
+    // Every run starts with cleared variables and arrays, just like in Applesoft BASIC
+    program_clear(self);
+
+    // Entered lines replace chunks and binding may compile lines again, so the native code of the previous
+    // run is discarded. The same happens once the executable memory is exhausted, compiling stops until then.
+    if (self->lines.pending_count > 0 || self->jit.full) {
+        jit_reset(&self->jit);
+    }
+    if (!program_bind(self)) {
+        self->no_wait = false;
+        return false;
+    }
+
+    // Only the lines that have changed since the last run are linked, so that jumping never searches for a line
+    program_lines_link(&self->lines);
+
+    // The program counter is advanced before the line is executed, so that a line may redirect
+    // the control flow by assigning the counter
+    self->counter = 0;
+    self->position = 0;
+    self->loop_count = 0;
+    self->return_count = 0;
+    while (self->counter < self->lines.count) {
+        Statement *stmt = self->lines.data[self->counter++].stmt;
+        u32 const position = self->position;
+        self->position = 0;
+        string_heap_reset_temporaries(&self->heap);
+        StringRoots const roots = program_string_roots(self);
+        string_heap_step(&self->heap, &roots);
+        if (self->mode == PROGRAM_MODE_REFERENCE) {
+            statement_execute_line(stmt, self, position);
+        } else {
+            vm_execute(self, &stmt->code, stmt->block.entries[position]);
+        }
+        if (self->error != NULL) {
+            program_report_error(self, stmt->line);
+            self->no_wait = false;
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Looks up the slot of the symbol with the specified name, the name is assigned the next free slot
+/// if it has none yet
+static u32 program_symbol(ProgramSymbols *symbols, ExpressionName const name, u32 *count) {
+    if (name >= symbols->capacity) {
+        u32 capacity = symbols->capacity * 2;
+        while (name >= capacity) {
+            capacity *= 2;
+        }
+        symbols->slots = realloc(symbols->slots, capacity * sizeof(u32));
+        memset(symbols->slots + symbols->capacity, 0xFF, (capacity - symbols->capacity) * sizeof(u32));
+        symbols->capacity = capacity;
+    }
+    if (symbols->slots[name] == PROGRAM_SLOT_NONE) {
+        symbols->slots[name] = (*count)++;
+    }
+    return symbols->slots[name];
+}
+
+/// Doubles the capacity of the slot storage once the count exceeds it, new slots are zeroed
+static void *program_slots_grow(void *data, u32 const count, u32 *capacity, usize const size) {
+    if (count <= *capacity) {
+        return data;
+    }
+    u32 const grown = *capacity * 2;
+    u8 *result = realloc(data, grown * size);
+    memset(result + *capacity * size, 0, (grown - *capacity) * size);
+    *capacity = grown;
+    return result;
+}
+
+/// Retrieves the type of the variable with the specified name
+static VariableType program_variable_type(char const *name, usize const length) {
+    switch (length > 0 ? name[length - 1] : '\0') {
+        case '%':
+            return VARIABLE_TYPE_INTEGER;
+        case '$':
+            return VARIABLE_TYPE_STRING;
+        default:
+            return VARIABLE_TYPE_REAL;
+    }
+}
+
+/// Retrieves the slot of the variable with the specified name. The name includes the type suffix,
+/// therefore A, A% and A$ are different symbols that refer to slots of different storages.
+static u32 program_variable_slot(Program *self, ExpressionName const name) {
+    ExpressionPool const *pool = &self->expressions;
+    u32 slot;
+    switch (program_variable_type(expression_pool_name(pool, name), expression_pool_name_length(pool, name))) {
+        case VARIABLE_TYPE_INTEGER:
+            slot = program_symbol(&self->symbols, name, &self->integer_count);
+            self->integers = program_slots_grow(self->integers, self->integer_count, &self->integer_capacity,
+                                                sizeof(s16));
+            break;
+        case VARIABLE_TYPE_STRING:
+            slot = program_symbol(&self->symbols, name, &self->string_count);
+            self->strings = program_slots_grow(self->strings, self->string_count, &self->string_capacity,
+                                               sizeof(String));
+            break;
+        case VARIABLE_TYPE_REAL:
+        default:
+            slot = program_symbol(&self->symbols, name, &self->variable_count);
+            self->variables = program_slots_grow(self->variables, self->variable_count, &self->variable_capacity,
+                                                 sizeof(f64));
+            break;
+    }
+    return slot;
+}
+
+/// Converts the value to an integer by truncating its fractional part
+static b32 program_integer(Program *self, f64 const value, s16 *result) {
+    // The comparison is false for NaN, which is not in range either
+    f64 const truncated = trunc(value);
+    if (!(truncated >= PROGRAM_INTEGER_MIN && truncated <= PROGRAM_INTEGER_MAX)) {
+        program_error(self, "ILLEGAL QUANTITY");
+        return false;
+    }
+    *result = (s16) truncated;
+    return true;
+}
+
+/// Converts the integral value to an integer
+static b32 program_integer_exact(Program *self, s32 const value, s16 *result) {
+    if (value < PROGRAM_INTEGER_MIN || value > PROGRAM_INTEGER_MAX) {
+        program_error(self, "ILLEGAL QUANTITY");
+        return false;
+    }
+    *result = (s16) value;
+    return true;
+}
+
+/// Stores the value in the integer variable with the specified slot
+static b32 program_store_integer(Program *self, u32 const slot, f64 const value) {
+    return program_integer(self, value, self->integers + slot);
+}
+
+/// Stores the integral value in the integer variable with the specified slot
+static b32 program_store_integer_exact(Program *self, u32 const slot, s32 const value) {
+    return program_integer_exact(self, value, self->integers + slot);
+}
+
+/// Retrieves the strings that may own strings of the heap
+static StringRoots program_string_roots(Program const *self) {
+    StringRoots roots;
+    roots.variables = self->strings;
+    roots.variable_count = self->string_count;
+    roots.elements = self->string_elements;
+    roots.element_count = self->string_element_count;
+    return roots;
+}
+
+/// Assigns a copy of the value to the string variable with the specified slot
+static void program_store_string(Program *self, u32 const slot, String const value) {
+    StringRoots const roots = program_string_roots(self);
+    string_heap_store(&self->heap, &roots, slot, value);
+}
+
+/// Retrieves the slot of the array with the specified name
+static u32 program_array_slot(Program *self, ExpressionName const name) {
+    u32 const count = self->array_count;
+    u32 const slot = program_symbol(&self->array_symbols, name, &self->array_count);
+    if (self->array_count != count) {
+        ExpressionPool const *pool = &self->expressions;
+        self->arrays = program_slots_grow(self->arrays, self->array_count, &self->array_capacity, sizeof(Array));
+        self->arrays[slot].type =
+                program_variable_type(expression_pool_name(pool, name), expression_pool_name_length(pool, name));
+    }
+    return slot;
+}
+
+/// Reserves the specified amount of zeroed elements at the end of the element storage. Storage that
+/// is outgrown is moved to the runtime arena, the old storage is reclaimed when the program is cleared.
+static void *program_elements_reserve(MemoryArena *runtime,
+                                      void *data,
+                                      u32 *count,
+                                      u32 *capacity,
+                                      u32 const amount,
+                                      usize const size) {
+    u32 const required = *count + amount;
+    if (required > *capacity) {
+        u32 grown = *capacity > 0 ? *capacity : PROGRAM_SLOT_CAPACITY;
+        while (grown < required) {
+            grown *= 2;
+        }
+        void *moved = arena_alloc(runtime, grown * size);
+        if (*count > 0) {
+            memcpy(moved, data, *count * size);
+        }
+        data = moved;
+        *capacity = grown;
+    }
+    memset((u8 *) data + *count * size, 0, amount * size);
+    *count = required;
+    return data;
+}
+
+/// Dimensions the array with the specified slot
+static b32 program_dimension_array(Program *self, u32 const slot, f64 const *bounds, u32 const count) {
+    Array *array = self->arrays + slot;
+    if (array->dimension_count > 0) {
+        program_error(self, "REDIM'D ARRAY");
+        return false;
+    }
+
+    u64 elements = 1;
+    for (u32 dimension = 0; dimension < count; ++dimension) {
+        f64 const bound = trunc(bounds[dimension]);
+        if (!(bound >= 0.0 && bound <= PROGRAM_INTEGER_MAX)) {
+            program_error(self, "ILLEGAL QUANTITY");
+            return false;
+        }
+        array->extents[dimension] = (u32) bound + 1;
+        elements *= array->extents[dimension];
+        if (elements > PROGRAM_ARRAY_ELEMENT_MAX) {
+            program_error(self, "OUT OF MEMORY");
+            return false;
+        }
+    }
+
+    // The elements of the array are appended to the storage of its type, the storage may move
+    // but elements are always addressed relative to it
+    u32 const amount = (u32) elements;
+    switch (array->type) {
+        case VARIABLE_TYPE_INTEGER:
+            array->offset = self->integer_element_count;
+            self->integer_elements = program_elements_reserve(&self->runtime, self->integer_elements,
+                                                              &self->integer_element_count,
+                                                              &self->integer_element_capacity, amount, sizeof(s16));
+            break;
+        case VARIABLE_TYPE_STRING:
+            array->offset = self->string_element_count;
+            self->string_elements = program_elements_reserve(&self->runtime, self->string_elements,
+                                                             &self->string_element_count,
+                                                             &self->string_element_capacity, amount, sizeof(String));
+            break;
+        case VARIABLE_TYPE_REAL:
+        default:
+            array->offset = self->real_element_count;
+            self->real_elements = program_elements_reserve(&self->runtime, self->real_elements,
+                                                           &self->real_element_count,
+                                                           &self->real_element_capacity, amount, sizeof(f64));
+            break;
+    }
+    array->dimension_count = count;
+    return true;
+}
+
+/// Retrieves the index of an element in the element storage of the array
+static b32 program_array_element(Program *self,
+                                 u32 const slot,
+                                 f64 const *indices,
+                                 u32 const count,
+                                 u32 *element) {
+    Array const *array = self->arrays + slot;
+    if (array->dimension_count == 0) {
+        f64 bounds[PROGRAM_ARRAY_DIMENSION_MAX];
+        for (u32 dimension = 0; dimension < count; ++dimension) {
+            bounds[dimension] = PROGRAM_ARRAY_DEFAULT_BOUND;
+        }
+        if (!program_dimension_array(self, slot, bounds, count)) {
+            return false;
+        }
+    }
+    if (array->dimension_count != count) {
+        program_error(self, "BAD SUBSCRIPT");
+        return false;
+    }
+
+    // The comparison is false for NaN, so that all invalid indices are rejected by one check
+    u32 result = 0;
+    for (u32 dimension = 0; dimension < count; ++dimension) {
+        f64 const index = indices[dimension];
+        if (!(index >= 0.0 && index < (f64) array->extents[dimension])) {
+            program_error(self, "BAD SUBSCRIPT");
+            return false;
+        }
+        result = result * array->extents[dimension] + (u32) index;
+    }
+    *element = array->offset + result;
+    return true;
 }
 
-/// Submits formatted text to the renderer
+/// Stores the value in the specified integer element
+static b32 program_store_integer_element(Program *self, u32 const element, f64 const value) {
+    return program_integer(self, value, self->integer_elements + element);
+}
+
+/// Stores the integral value in the specified integer element
+static b32 program_store_integer_element_exact(Program *self, u32 const element, s32 const value) {
+    return program_integer_exact(self, value, self->integer_elements + element);
+}
+
+/// Assigns a copy of the value to the specified string element
+static void program_store_string_element(Program *self, u32 const element, String const value) {
+    StringRoots const roots = program_string_roots(self);
+    string_heap_store(&self->heap, &roots, element | STRING_HEAP_OWNER_ELEMENT, value);
+}
+
+/// Converts the value to an address of the memory
+static b32 program_address(Program *self, f64 const value, u16 *result) {
+    // The comparison is false for NaN, which is not in range either
+    f64 const truncated = trunc(value);
+    if (!(truncated > -ADDRESS_SPACE_SIZE && truncated < ADDRESS_SPACE_SIZE)) {
+        program_error(self, "ILLEGAL QUANTITY");
+        return false;
+    }
+    // Negative addresses wrap around, so -16384 is the same as 49152
+    *result = (u16) (s32) truncated;
+    return true;
+}
+
+/// Reads the byte at the specified address of the memory
+static b32 program_peek(Program *self, f64 const address, f64 *result) {
+    u16 location;
+    if (!program_address(self, address, &location)) {
+        return false;
+    }
+    *result = (f64) address_space_read(&self->memory, location);
+    return true;
+}
+
+/// Writes the byte to the specified address of the memory
+static b32 program_poke(Program *self, f64 const address, f64 const value) {
+    u16 location;
+    if (!program_address(self, address, &location)) {
+        return false;
+    }
+    f64 const truncated = trunc(value);
+    if (!(truncated >= 0 && truncated <= 255)) {
+        program_error(self, "ILLEGAL QUANTITY");
+        return false;
+    }
+    address_space_write(&self->memory, location, (u8) truncated);
+    return true;
+}
+
+/// Allocates a temporary string, which lives until the current line has been executed
+static char *program_temporary_string(Program *self, u32 const length) {
+    char *result = string_heap_temporary(&self->heap, length);
+    if (result == NULL) {
+        program_error(self, "OUT OF MEMORY");
+    }
+    return result;
+}
+
+/// Stops the program with the specified error
+static void program_error(Program *self, char const *error) {
+    if (self->error == NULL) {
+        self->error = error;
+    }
+}
+
+/// Continues execution at the specified line
+static void program_jump(Program *self, u32 const target) {
+    if (target == PROGRAM_LINE_NONE) {
+        program_error(self, "UNDEF'D STATEMENT");
+        return;
+    }
+    self->counter = self->lines.indices[target];
+    self->position = 0;
+}
+
+/// Calls the subroutine at the specified line
+static void program_gosub(Program *self, u32 const target, u32 const position) {
+    if (self->return_count == PROGRAM_RETURN_STACK_SIZE) {
+        program_error(self, "OUT OF MEMORY");
+        return;
+    }
+
+    // The counter has already been advanced past the current line
+    ProgramReturn *frame = self->returns + self->return_count++;
+    frame->line = self->counter - 1;
+    frame->position = position;
+    frame->loop_count = self->loop_count;
+    program_jump(self, target);
+}
+
+/// Returns from the innermost subroutine
+static void program_return(Program *self) {
+    if (self->return_count == 0) {
+        program_error(self, "RETURN WITHOUT GOSUB");
+        return;
+    }
+    ProgramReturn const *frame = self->returns + --self->return_count;
+    self->counter = frame->line;
+    self->position = frame->position;
+    self->loop_count = frame->loop_count;
+}
+
+/// Looks up the loop with the specified variable, searching from the innermost loop outwards
+static u32 program_loop_find(Program const *self, u32 const slot) {
+    for (u32 index = self->loop_count; index > 0; --index) {
+        if (slot == PROGRAM_LOOP_ANY || self->loops[index - 1].slot == slot) {
+            return index - 1;
+        }
+    }
+    return PROGRAM_LOOP_ANY;
+}
+
+/// Enters a FOR loop
+static void program_for(Program *self, u32 const slot, f64 const limit, f64 const step, u32 const position) {
+    // Entering a loop again, e.g. by jumping back to its FOR statement, replaces the previous loop
+    u32 const existing = program_loop_find(self, slot);
+    if (existing != PROGRAM_LOOP_ANY) {
+        self->loop_count = existing;
+    }
+    if (self->loop_count == PROGRAM_LOOP_STACK_SIZE) {
+        program_error(self, "OUT OF MEMORY");
+        return;
+    }
+    ProgramLoop *loop = self->loops + self->loop_count++;
+    loop->slot = slot;
+    loop->line = self->counter - 1;
+    loop->position = position;
+    loop->limit = limit;
+    loop->step = step;
+}
+
+/// Advances the loop with the specified variable
+static b32 program_next(Program *self, u32 const slot) {
+    u32 const index = program_loop_find(self, slot);
+    if (index == PROGRAM_LOOP_ANY) {
+        program_error(self, "NEXT WITHOUT FOR");
+        return false;
+    }
+
+    // The body is always executed at least once, the limit is only checked here
+    ProgramLoop const *loop = self->loops + index;
+    f64 const value = self->variables[loop->slot] + loop->step;
+    self->variables[loop->slot] = value;
+    if (loop->step >= 0.0 ? value <= loop->limit : value >= loop->limit) {
+        self->loop_count = index + 1;
+        self->counter = loop->line;
+        self->position = loop->position;
+        return false;
+    }
+    self->loop_count = index;
+    return true;
+}
+
+/// Retrieves the slot of the function with the specified name
+static u32 program_function_slot(Program *self, ExpressionName const name) {
+    u32 const slot = program_symbol(&self->function_symbols, name, &self->function_count);
+    u32 capacity = self->function_capacity;
+    self->defined_functions = program_slots_grow(self->defined_functions, self->function_count, &capacity, sizeof(b32));
+    capacity = self->function_capacity;
+    self->pending_functions = program_slots_grow(self->pending_functions, self->function_count, &capacity, sizeof(b32));
+    self->functions = program_slots_grow((void *) self->functions, self->function_count, &self->function_capacity,
+                                         sizeof(FunctionDefinition const *));
+    return slot;
+}
+
+/// Checks if the name refers to a builtin function or to a function that is defined by the program
+static b32 program_function_exists(Program const *self, ExpressionName const name) {
+    if (name >= self->function_symbols.capacity || self->function_symbols.slots[name] == PROGRAM_SLOT_NONE) {
+        return false;
+    }
+    u32 const slot = self->function_symbols.slots[name];
+    FunctionDefinition const *definition = self->functions[slot];
+    return self->defined_functions[slot] || (definition != NULL && definition->type == FUNCTION_DEFINITION_BUILTIN);
+}
+
+/// Binds the specified definition to the function with the name of the definition
+static void program_define_function(Program *self, FunctionDefinition const *definition) {
+    self->functions[program_function_slot(self, definition->name)] = definition;
+}
+
+/// Resets all variables to zero, releases all arrays and removes all user defined functions
+static void program_clear(Program *self) {
+    memset(self->variables, 0, self->variable_count * sizeof(f64));
+    memset(self->integers, 0, self->integer_count * sizeof(s16));
+    memset(self->strings, 0, self->string_count * sizeof(String));
+    string_heap_clear(&self->heap);
+    for (u32 slot = 0; slot < self->array_count; ++slot) {
+        self->arrays[slot].dimension_count = 0;
+    }
+    self->real_element_count = 0;
+    self->real_element_capacity = 0;
+    self->real_elements = NULL;
+    self->integer_element_count = 0;
+    self->integer_element_capacity = 0;
+    self->integer_elements = NULL;
+    self->string_element_count = 0;
+    self->string_element_capacity = 0;
+    self->string_elements = NULL;
+    arena_reset(&self->runtime);
+    for (u32 slot = 0; slot < self->function_count; ++slot) {
+        FunctionDefinition const *definition = self->functions[slot];
+        if (definition != NULL && definition->type == FUNCTION_DEFINITION_DYNAMIC) {
+            self->functions[slot] = NULL;
+        }
+    }
+}
+
+/// Submits formatted text to the renderer, or to the standard output if there is no renderer
 static void program_print_format(Program *self, const char *fmt, ...) {
     char buffer[1024];
     va_list list;
     va_start(list, fmt);
-    u32 length = (u32) vsnprintf(buffer, sizeof buffer, fmt, list);
+    s32 const written = vsnprintf(buffer, sizeof buffer, fmt, list);
     va_end(list);
+    if (written < 0) {
+        return;
+    }
+    u32 const length = written < (s32) sizeof buffer ? (u32) written : (u32) sizeof buffer - 1;
+
+    // Programs that are run without a window print to the standard output
+    if (self->renderer == NULL) {
+        fwrite(buffer, sizeof(char), length, stdout);
+        return;
+    }
 
     static F32Vector3 msg = { 1.0f, 0.55f, 0.0f };
     renderer_draw_text(self->renderer, &self->text_position, &msg, 0.5f, "%.*s", length, buffer);
@@ -5,62 +5,243 @@
 
 /// Forward declares
 typedef struct Statement Statement;
-typedef struct ProgramTreeNode ProgramTreeNode;
-typedef struct ProgramTreeIterator ProgramTreeIterator;
-
-typedef struct ProgramTreeNode {
+typedef struct FunctionDefinition FunctionDefinition;
+/// A line of the program, the line number is stored next to the statement so that
+/// searching for a line does not need to touch the statements
+typedef struct ProgramLine {
+    usize line;
     Statement *stmt;
-    ProgramTreeNode *left;
-    ProgramTreeNode *right;
-} ProgramTreeNode;
 
-typedef struct ProgramTreeIterator {
-    Statement *stmt;
-    ProgramTreeIterator *next;
-} ProgramTreeIterator;
+    /// The identifier of the line, which stays the same when the line is replaced or when
+    /// other lines are inserted before it. Jumps are linked to identifiers.
+    u32 identifier;
+
+    /// Whether the jumps of the line must be linked before the program is run
+    b32 pending;
+} ProgramLine;
+
+/// The lines of the program, which are stored contiguously and sorted by their line number
+typedef struct ProgramLines {
+    ProgramLine *data;
+    u32 count;
+    u32 capacity;
 
-typedef struct ProgramTree {
-    ProgramTreeNode *root;
-    MemoryArena arena;
-} ProgramTree;
+    /// The index of every line by its identifier
+    u32 *indices;
 
-/// Creates a new program tree
-/// @param tree The program tree
-static void program_tree_create(ProgramTree *tree);
+    /// The identifiers of the lines whose jumps must be linked, which are the lines that have
+    /// been entered since the last run and the lines that jump to a missing line
+    u32 *pending;
+    u32 pending_count;
+} ProgramLines;
 
-/// Destroys the program tree
-/// @param tree The program tree
-static void program_tree_destroy(ProgramTree *tree);
+/// Creates a new program line array
+/// @param lines The program lines
+static void program_lines_create(ProgramLines *lines);
 
-/// Clears all nodes of the program tree
-static void program_tree_clear(ProgramTree *tree);
+/// Destroys the program line array
+/// @param lines The program lines
+static void program_lines_destroy(ProgramLines *lines);
 
-/// Inserts the given statement into the program tree
-/// @param tree The program tree
+/// Removes all lines of the program
+/// @param lines The program lines
+static void program_lines_clear(ProgramLines *lines);
+
+/// Inserts the given statement into the program, a statement with the same line number is replaced.
+/// The jumps of the statement are linked once the program is run.
+/// @param lines The program lines
 /// @param stmt The statement
-static void program_tree_insert(ProgramTree *tree, Statement *stmt);
+static void program_lines_insert(ProgramLines *lines, Statement *stmt);
+
+/// Links the jumps of the pending lines, lines that still jump to a missing line remain pending.
+/// All other lines keep their links, as jumps refer to the identifiers of lines.
+/// @param lines The program lines
+static void program_lines_link(ProgramLines *lines);
+
+/// Retrieves the index of the first line whose number is not less than the specified line
+/// @param lines The program lines
+/// @param line The line number
+/// @return The index of the line, which equals the line count if there is no such line
+static u32 program_lines_search(ProgramLines const *lines, usize line);
 
-/// Retrieves a program tree node from the given line
-/// @param tree The program tree
+/// Retrieves a program line from the given line number
+/// @param lines The program lines
 /// @param line The line which is requested
-/// @return The request program tree node or NULL
-static ProgramTreeNode *program_tree_get(ProgramTree const *tree, usize line);
+/// @return The requested program line or NULL
+static ProgramLine *program_lines_get(ProgramLines const *lines, usize line);
 
 enum {
     PROGRAM_MARGIN_SIZE = 30,
-    PROGRAM_MEMORY_SIZE = 0x10000
+    PROGRAM_SLOT_CAPACITY = 64,
+    PROGRAM_LINE_CAPACITY = 64,
+    PROGRAM_PARAMETER_STACK_SIZE = 256,
+    PROGRAM_LOOP_STACK_SIZE = 64,
+    PROGRAM_RETURN_STACK_SIZE = 256
+};
+
+enum {
+    /// The target of a jump to a line that does not exist
+    PROGRAM_LINE_NONE = 0xFFFFFFFFu,
+
+    /// NEXT without a variable continues the innermost loop
+    PROGRAM_LOOP_ANY = 0xFFFFFFFFu,
+
+    /// The slot of a name that has not been referenced yet
+    PROGRAM_SLOT_NONE = 0xFFFFFFFFu
+};
+
+/// An active FOR loop. The limit and the step are evaluated once when the loop is entered,
+/// the body starts at the statement that follows the FOR statement, which may be on the same line.
+typedef struct ProgramLoop {
+    u32 slot;
+    u32 line;
+    u32 position;
+    f64 limit;
+    f64 step;
+} ProgramLoop;
+
+/// An active GOSUB, which remembers the statement to return to and the loops that were active
+/// when the subroutine was called
+typedef struct ProgramReturn {
+    u32 line;
+    u32 position;
+    u32 loop_count;
+} ProgramReturn;
+
+/// The type of a variable, which is determined by the suffix of its name. Every type has
+/// its own slots and its own storage, so that values are stored in place without a tag.
+typedef enum VariableType {
+    /// Real variables (e.g. A) hold a double precision floating point number
+    VARIABLE_TYPE_REAL,
+
+    /// Integer variables (e.g. A%) hold a signed 16 bit integer
+    VARIABLE_TYPE_INTEGER,
+
+    /// String variables (e.g. A$) hold a string of the string heap
+    VARIABLE_TYPE_STRING
+} VariableType;
+
+enum {
+    /// The range of integer variables, Applesoft BASIC does not allow -32768
+    PROGRAM_INTEGER_MIN = -32767,
+    PROGRAM_INTEGER_MAX = 32767
 };
 
+enum {
+    PROGRAM_ARRAY_DIMENSION_MAX = 8,
+
+    /// Arrays that are used before they are dimensioned have this upper bound in every dimension
+    PROGRAM_ARRAY_DEFAULT_BOUND = 10,
+
+    /// The maximum amount of elements of a single array
+    PROGRAM_ARRAY_ELEMENT_MAX = 1 << 24
+};
+
+/// The descriptor of an array. The elements of an array are stored contiguously in row-major order,
+/// in the element storage of its type, so that accessing an element only takes one multiply-add per
+/// dimension and a bounds check. Descriptors are referred to by the slot that was assigned to the
+/// array at compile time.
+typedef struct Array {
+    /// The type of the elements
+    VariableType type;
+
+    /// The amount of dimensions, which is zero while the array has not been dimensioned yet
+    u32 dimension_count;
+
+    /// The amount of elements in every dimension, which is one more than the upper bound
+    u32 extents[PROGRAM_ARRAY_DIMENSION_MAX];
+
+    /// The index of the first element in the element storage of the type
+    u32 offset;
+} Array;
+
+/// The symbols associate the interned names of the expression pool with the slots that were assigned
+/// to them at compile time. The slots are indexed by the identifier of the name, so that looking up a
+/// symbol neither hashes nor compares the name, names without a slot map to PROGRAM_SLOT_NONE.
+typedef struct ProgramSymbols {
+    u32 *slots;
+    u32 capacity;
+} ProgramSymbols;
+
+typedef enum ProgramMode {
+    /// Statements are executed by the bytecode virtual machine
+    PROGRAM_MODE_BYTECODE = 0,
+
+    /// Statements are executed by walking the syntax tree, which serves
+    /// as the reference the virtual machine can be compared against
+    PROGRAM_MODE_REFERENCE = 1
+} ProgramMode;
+
 typedef struct Program {
-    /// The symbols which are stored in the program.
-    /// Symbols can be function definitions or user defined variables.
-    HashMap *symbols;
+    /// The variable symbols of the program. The symbol table is only consulted
+    /// while compiling (and debugging), executing code refers to slots instead.
+    ProgramSymbols symbols;
+
+    /// The function symbols of the program, which includes the builtin functions
+    ProgramSymbols function_symbols;
+
+    /// The array symbols of the program, arrays and variables with the same name are distinct
+    ProgramSymbols array_symbols;
+
+    /// The values of all real variables, indexed by their slot
+    f64 *variables;
+    u32 variable_count;
+    u32 variable_capacity;
+
+    /// The values of all integer variables, indexed by their slot
+    s16 *integers;
+    u32 integer_count;
+    u32 integer_capacity;
+
+    /// The values of all string variables, indexed by their slot. The strings
+    /// are owned by the variables and reside in the string heap.
+    String *strings;
+    u32 string_count;
+    u32 string_capacity;
+    StringHeap heap;
+
+    /// The descriptors of all arrays, indexed by their slot
+    Array *arrays;
+    u32 array_count;
+    u32 array_capacity;
+
+    /// The elements of all arrays, grouped by their type. Elements are allocated in the runtime
+    /// arena when an array is dimensioned and released when the program is cleared.
+    f64 *real_elements;
+    u32 real_element_count;
+    u32 real_element_capacity;
+    s16 *integer_elements;
+    u32 integer_element_count;
+    u32 integer_element_capacity;
+    String *string_elements;
+    u32 string_element_count;
+    u32 string_element_capacity;
 
-    /// The program memory, which is usually 64 Kb.
-    /// TODO(plank): Not really in use yet, we want to write some data
-    /// (like keyboard input) to specific memory locations as described
-    /// in the Applesoft BASIC spec.
-    u8 memory[PROGRAM_MEMORY_SIZE];
+    /// The definitions of all functions, indexed by their slot. The slot of a
+    /// function that has not been defined yet is NULL.
+    FunctionDefinition const **functions;
+    u32 function_count;
+    u32 function_capacity;
+
+    /// Whether a DEF FN statement of the program defines the function, indexed by its slot.
+    /// References of the form NAME(...) call builtins and defined functions, any other name
+    /// refers to an array.
+    b32 *defined_functions;
+
+    /// The definitions the lines are bound to next, which are swapped with the defined functions
+    /// once they have been collected, so that binding the lines never allocates
+    b32 *pending_functions;
+
+    /// The arguments of the user defined functions that are currently evaluated by the
+    /// reference interpreter. The frame is the index of the first argument of the innermost
+    /// call, the virtual machine keeps arguments in its registers instead.
+    f64 parameters[PROGRAM_PARAMETER_STACK_SIZE];
+    u32 parameter_top;
+    u32 parameter_frame;
+
+    /// The 64 Kb address space that PEEK and POKE access, which holds the text page
+    /// and the keyboard soft switches at their Applesoft BASIC locations
+    AddressSpace memory;
 
     /// Required for text rendering
     Renderer *renderer;
@@ -68,8 +249,32 @@ typedef struct Program {
     /// Next text position
     F32Vector2 text_position;
 
-    /// A tree map that stores the lines of the actual program.
-    ProgramTree lines;
+    /// The lines of the actual program, sorted by their line number
+    ProgramLines lines;
+
+    /// The index of the line that is executed next
+    u32 counter;
+
+    /// The index of the statement within the next line that execution starts at, which is only
+    /// not zero when a loop or a subroutine continues in the middle of a line
+    u32 position;
+
+    /// The active FOR loops, the innermost loop is on top
+    ProgramLoop loops[PROGRAM_LOOP_STACK_SIZE];
+    u32 loop_count;
+
+    /// The active subroutines, the innermost subroutine is on top
+    ProgramReturn returns[PROGRAM_RETURN_STACK_SIZE];
+    u32 return_count;
+
+    /// The message of the error that stopped the program, or NULL while the program is running
+    char const *error;
+
+    /// The mode in which the lines of the program are executed
+    ProgramMode mode;
+
+    /// The native code of the chunks that the virtual machine runs most often
+    Jit jit;
 
     /// A b32ean whose values indicates whether the program should wait
     /// for the users input to cancel execution. possible values are:
@@ -78,28 +283,212 @@ typedef struct Program {
     ///          to source
     b32 no_wait;
 
-    /// The last key that was pressed by the user.
-    /// TODO(plank): Replace with memory
+    /// The last key that was pressed by the user, which the emulator waits on for ESC. Programs
+    /// read keys from the keyboard soft switch of the memory instead.
     s32 last_key;
 
-    /// The arena in which all program objects are allocated in.
+    /// The nodes of all expressions of the program, statements refer to them by index
+    ExpressionPool expressions;
+
+    /// The arena in which all program objects are allocated in, which persist as long as the program.
     MemoryArena objects;
+
+    /// The arena for the memory of a single run, such as the element storage of the arrays. It is reset
+    /// whenever the program is cleared, which keeps its blocks, so that repeated runs do not grow memory.
+    MemoryArena runtime;
 } Program;
 
 /// Creates a program which serves as the handle between emulator and AST
 /// @param self The program handle
-/// @param renderer The renderer
+/// @param renderer The renderer, or NULL if the program is run without a window
 static void program_create(Program *self, Renderer *renderer);
 
 /// Destroys the program and all its data
 /// @param self The program handle
 static void program_destroy(Program *self);
 
-/// Executes the program
+/// Executes the program, an error that stops the program is reported on the screen, or on the
+/// standard error if there is no renderer
+/// @param self The program handle
+/// @return A boolean value that indicates whether the program ran without an error
+static b32 program_execute(Program *self);
+
+/// Retrieves the type of the variable with the specified name
+/// @param name The name of the variable
+/// @param length The length of the name
+/// @return The type of the variable
+static VariableType program_variable_type(char const *name, usize length);
+
+/// Retrieves the slot of the variable with the specified name, the variable
+/// is assigned a new slot when it is referenced for the first time. The slot
+/// refers to the storage of the type of the variable.
+/// @param self The program handle
+/// @param name The interned name of the variable
+/// @return The slot of the variable
+static u32 program_variable_slot(Program *self, ExpressionName name);
+
+/// Stores the value in the integer variable with the specified slot, the fractional part
+/// of the value is truncated
+/// @param self The program handle
+/// @param slot The slot of the integer variable
+/// @param value The value
+/// @return A boolean value that indicates whether the value is in range, otherwise the
+///         program is stopped with an error
+static b32 program_store_integer(Program *self, u32 slot, f64 value);
+
+/// Stores the integral value in the integer variable with the specified slot
+/// @param self The program handle
+/// @param slot The slot of the integer variable
+/// @param value The value
+/// @return A boolean value that indicates whether the value is in range, otherwise the
+///         program is stopped with an error
+static b32 program_store_integer_exact(Program *self, u32 slot, s32 value);
+
+/// Retrieves the strings that may own strings of the heap
+/// @param self The program handle
+/// @return The string variables and the string elements of the program
+static StringRoots program_string_roots(Program const *self);
+
+/// Assigns a copy of the value to the string variable with the specified slot
+/// @param self The program handle
+/// @param slot The slot of the string variable
+/// @param value The value
+static void program_store_string(Program *self, u32 slot, String value);
+
+/// Retrieves the slot of the array with the specified name, the array is assigned
+/// a new slot when it is referenced for the first time
+/// @param self The program handle
+/// @param name The interned name of the array
+/// @return The slot of the array
+static u32 program_array_slot(Program *self, ExpressionName name);
+
+/// Dimensions the array with the specified slot, all elements are zero or empty
+/// @param self The program handle
+/// @param slot The slot of the array
+/// @param bounds The upper bound of every dimension
+/// @param count The amount of dimensions
+/// @return A boolean value that indicates whether the array was dimensioned, otherwise
+///         the program is stopped with an error
+static b32 program_dimension_array(Program *self, u32 slot, f64 const *bounds, u32 count);
+
+/// Retrieves the index of an element in the element storage of the array. Arrays that have
+/// not been dimensioned yet are dimensioned with the default bound.
+/// @param self The program handle
+/// @param slot The slot of the array
+/// @param indices The index of the element in every dimension
+/// @param count The amount of indices
+/// @param element Receives the index of the element in the element storage
+/// @return A boolean value that indicates whether the indices are in range, otherwise
+///         the program is stopped with an error
+static b32 program_array_element(Program *self, u32 slot, f64 const *indices, u32 count, u32 *element);
+
+/// Stores the value in the specified integer element, like program_store_integer
+/// @param self The program handle
+/// @param element The index of the element in the integer element storage
+/// @param value The value
+/// @return A boolean value that indicates whether the value is in range
+static b32 program_store_integer_element(Program *self, u32 element, f64 value);
+
+/// Stores the integral value in the specified integer element, like program_store_integer_exact
+/// @param self The program handle
+/// @param element The index of the element in the integer element storage
+/// @param value The value
+/// @return A boolean value that indicates whether the value is in range
+static b32 program_store_integer_element_exact(Program *self, u32 element, s32 value);
+
+/// Assigns a copy of the value to the specified string element
+/// @param self The program handle
+/// @param element The index of the element in the string element storage
+/// @param value The value
+static void program_store_string_element(Program *self, u32 element, String value);
+
+/// Reads the byte at the specified address of the memory. Negative addresses down to -65535
+/// count back from the end of the memory, like in Applesoft BASIC.
+/// @param self The program handle
+/// @param address The address
+/// @param result Receives the byte
+/// @return A boolean value that indicates whether the address is in range, otherwise the
+///         program is stopped with an error
+static b32 program_peek(Program *self, f64 address, f64 *result);
+
+/// Writes the byte to the specified address of the memory, addresses are like in program_peek
+/// @param self The program handle
+/// @param address The address
+/// @param value The byte, which must be between 0 and 255
+/// @return A boolean value that indicates whether the address and the value are in range,
+///         otherwise the program is stopped with an error
+static b32 program_poke(Program *self, f64 address, f64 value);
+
+/// Allocates a temporary string, which lives until the current line has been executed
+/// @param self The program handle
+/// @param length The length of the string
+/// @return The characters of the string or NULL if the program has been stopped
+///         because there is no memory left
+static char *program_temporary_string(Program *self, u32 length);
+
+/// Stops the program with the specified error, the error is reported once the current
+/// line has finished executing
+/// @param self The program handle
+/// @param error The error message
+static void program_error(Program *self, char const *error);
+
+/// Continues execution at the specified line
+/// @param self The program handle
+/// @param target The identifier of the line or PROGRAM_LINE_NONE, which stops the program with an error
+static void program_jump(Program *self, u32 target);
+
+/// Calls the subroutine at the specified line
+/// @param self The program handle
+/// @param target The identifier of the line or PROGRAM_LINE_NONE
+/// @param position The index of the statement within the current line that the subroutine returns to
+static void program_gosub(Program *self, u32 target, u32 position);
+
+/// Returns from the innermost subroutine, loops that were entered by the subroutine are left
+/// @param self The program handle
+static void program_return(Program *self);
+
+/// Enters a FOR loop, the loop variable must already hold the start value. A loop with the
+/// same variable, and all loops that were entered after it, are left first.
+/// @param self The program handle
+/// @param slot The slot of the real loop variable
+/// @param limit The limit of the loop
+/// @param step The step of the loop
+/// @param position The index of the statement within the current line that the body starts at
+static void program_for(Program *self, u32 slot, f64 limit, f64 step, u32 position);
+
+/// Advances the loop with the specified variable, which continues at the statement after its
+/// FOR statement until the variable passes the limit. Inner loops are left.
+/// @param self The program handle
+/// @param slot The slot of the loop variable or PROGRAM_LOOP_ANY for the innermost loop
+/// @return A boolean value that indicates whether the loop has finished, which is false
+///         if the loop continues or the program has been stopped
+static b32 program_next(Program *self, u32 slot);
+
+/// Retrieves the slot of the function with the specified name, the function
+/// is assigned a new slot when it is referenced for the first time
+/// @param self The program handle
+/// @param name The interned name of the function
+/// @return The slot of the function
+static u32 program_function_slot(Program *self, ExpressionName name);
+
+/// Checks if the name refers to a builtin function or to a function that is defined by a
+/// DEF FN statement of the program, rather than to an array
+/// @param self The program handle
+/// @param name The interned name
+/// @return A boolean value that indicates whether the function exists
+static b32 program_function_exists(Program const *self, ExpressionName name);
+
+/// Binds the specified definition to the function with the name of the definition
+/// @param self The program handle
+/// @param definition The function definition
+static void program_define_function(Program *self, FunctionDefinition const *definition);
+
+/// Resets all variables to zero, releases all arrays and removes all user defined functions.
+/// All memory of the runtime arena is released at once.
 /// @param self The program handle
-static void program_execute(Program *self);
+static void program_clear(Program *self);
 
-/// Submits formatted text to the renderer
+/// Submits formatted text to the renderer, or to the standard output if there is no renderer
 /// @param self The program handle
 /// @param fmt The text format string
 /// @param ... The variadic arguments
@@ -3,8 +3,8 @@
 /// Creates a new let statement
 static Statement *let_statement_new(MemoryArena *arena,
                                     usize const line,
-                                    Expression *variable,
-                                    Expression *initializer) {
+                                    ExpressionIndex const variable,
+                                    ExpressionIndex const initializer) {
     Statement *self = arena_alloc(arena, sizeof(Statement));
     self->line = line;
     self->type = STATEMENT_LET;
@@ -21,23 +21,152 @@ static Statement *clear_statement_new(MemoryArena *arena, usize const line) {
     return self;
 }
 
+/// Creates a new dim statement
+static Statement *dim_statement_new(MemoryArena *arena,
+                                    usize const line,
+                                    ExpressionIndex *arrays,
+                                    u32 const array_count) {
+    Statement *self = arena_alloc(arena, sizeof(Statement));
+    self->line = line;
+    self->type = STATEMENT_DIM;
+    self->dim.arrays = arrays;
+    self->dim.array_count = array_count;
+    return self;
+}
+
 /// Creates a new def fn statement
 static Statement *def_fn_statement_new(MemoryArena *arena,
+                                       ExpressionPool const *pool,
                                        usize line,
-                                       Expression *name,
-                                       Expression *variable,
-                                       Expression *body) {
+                                       ExpressionIndex const name,
+                                       ExpressionIndex const variable,
+                                       ExpressionIndex const body) {
     Statement *self = arena_alloc(arena, sizeof(Statement));
     self->line = line;
     self->type = STATEMENT_DEF_FN;
     self->def_fn.name = name;
     self->def_fn.variable = variable;
     self->def_fn.body = body;
+    self->def_fn.slot = 0;
+
+    FunctionDefinition *definition = &self->def_fn.definition;
+    definition->name = expression_pool_get(pool, name)->variable.name;
+    definition->type = FUNCTION_DEFINITION_DYNAMIC;
+    definition->variable.variable = variable;
+    definition->variable.body = body;
+    return self;
+}
+
+/// Creates a new goto or gosub statement
+static Statement *jump_statement_new(MemoryArena *arena,
+                                     usize const line,
+                                     StatementType const type,
+                                     usize const target) {
+    Statement *self = arena_alloc(arena, sizeof(Statement));
+    self->line = line;
+    self->type = type;
+    self->jump.line = target;
+    self->jump.target = PROGRAM_LINE_NONE;
+    return self;
+}
+
+/// Creates a new return statement
+static Statement *return_statement_new(MemoryArena *arena, usize const line) {
+    Statement *self = arena_alloc(arena, sizeof(Statement));
+    self->line = line;
+    self->type = STATEMENT_RETURN;
+    return self;
+}
+
+/// Creates a new on statement
+static Statement *on_statement_new(MemoryArena *arena,
+                                   usize const line,
+                                   ExpressionIndex const selector,
+                                   b32 const gosub,
+                                   JumpStatement *jumps,
+                                   u32 const jump_count) {
+    Statement *self = arena_alloc(arena, sizeof(Statement));
+    self->line = line;
+    self->type = STATEMENT_ON;
+    self->on.selector = selector;
+    self->on.gosub = gosub;
+    self->on.jumps = jumps;
+    self->on.jump_count = jump_count;
+    return self;
+}
+
+/// Creates a new for statement
+static Statement *for_statement_new(MemoryArena *arena,
+                                    usize const line,
+                                    ExpressionIndex const variable,
+                                    ExpressionIndex const start,
+                                    ExpressionIndex const limit,
+                                    ExpressionIndex const step) {
+    Statement *self = arena_alloc(arena, sizeof(Statement));
+    self->line = line;
+    self->type = STATEMENT_FOR;
+    self->for_loop.variable = variable;
+    self->for_loop.start = start;
+    self->for_loop.limit = limit;
+    self->for_loop.step = step;
+    return self;
+}
+
+/// Creates a new next statement
+static Statement *next_statement_new(MemoryArena *arena,
+                                     usize const line,
+                                     ExpressionIndex *variables,
+                                     u32 const variable_count) {
+    Statement *self = arena_alloc(arena, sizeof(Statement));
+    self->line = line;
+    self->type = STATEMENT_NEXT;
+    self->next.variables = variables;
+    self->next.variable_count = variable_count;
+    return self;
+}
+
+/// Creates a new if statement
+static Statement *if_statement_new(MemoryArena *arena, usize const line, ExpressionIndex const condition) {
+    Statement *self = arena_alloc(arena, sizeof(Statement));
+    self->line = line;
+    self->type = STATEMENT_IF;
+    self->if_then.condition = condition;
+    return self;
+}
+
+/// Creates a new block statement
+static Statement *block_statement_new(MemoryArena *arena,
+                                      usize const line,
+                                      Statement **statements,
+                                      u32 const statement_count) {
+    Statement *self = arena_alloc(arena, sizeof(Statement));
+    self->line = line;
+    self->type = STATEMENT_BLOCK;
+    self->block.statements = arena_alloc(arena, statement_count * sizeof(Statement));
+    self->block.statement_count = statement_count;
+    self->block.entries = arena_alloc(arena, (statement_count + 1) * sizeof(u32));
+    for (u32 index = 0; index < statement_count; ++index) {
+        self->block.statements[index] = *statements[index];
+        self->block.statements[index].index = index;
+    }
+    return self;
+}
+
+/// Creates a new poke statement
+static Statement *poke_statement_new(MemoryArena *arena,
+                                     usize const line,
+                                     ExpressionIndex const address,
+                                     ExpressionIndex const value) {
+    Statement *self = arena_alloc(arena, sizeof(Statement));
+    self->line = line;
+    self->type = STATEMENT_POKE;
+    self->poke.address = address;
+    self->poke.value = value;
     return self;
 }
 
 /// Creates a new print statement
-static Statement *print_statement_new(MemoryArena *arena, usize const line, Expression *printable) {
+static Statement *print_statement_new(MemoryArena *arena, usize const line, ExpressionIndex const printable) {
     Statement *self = arena_alloc(arena, sizeof(Statement));
     self->line = line;
     self->type = STATEMENT_PRINT;
@@ -80,29 +209,70 @@ static StatementResult statement_result_make_error(const char *error) {
 }
 
 /// Compiles a statement from the token state
-static StatementResult statement_compile_internal(MemoryArena *arena, usize line, TokenIterator *state);
+static StatementResult statement_compile_internal(MemoryArena *arena,
+                                                  ExpressionPool *pool,
+                                                  usize line,
+                                                  TokenIterator *state);
+
+/// Makes room for one more element in a list that is allocated in the arena, a full list is
+/// copied into an allocation of twice its capacity
+static void *statement_list_reserve(MemoryArena *arena, void *list, u32 const count, u32 *capacity, usize const size) {
+    if (list == NULL || count == *capacity) {
+        *capacity = list == NULL ? 4 : *capacity * 2;
+        void *grown = arena_alloc(arena, *capacity * size);
+        if (list != NULL) {
+            memcpy(grown, list, count * size);
+        }
+        return grown;
+    }
+    return list;
+}
 
 /// Compiles a let statement from the token state
-static StatementResult statement_compile_let(MemoryArena *arena, usize const line, TokenIterator *state) {
+static StatementResult statement_compile_let(MemoryArena *arena,
+                                             ExpressionPool *pool,
+                                             usize const line,
+                                             TokenIterator *state) {
     if (match(state, TOKEN_LET)) {
         token_iterator_advance(state);
     }
+
+    // Assignment to an array element
+    if (match(state, TOKEN_IDENTIFIER) && match_next(state, TOKEN_LEFT_PARENTHESIS)) {
+        ExpressionIndex element = expression_compile_element(pool, state);
+        if (element == EXPRESSION_NONE || !match(state, TOKEN_EQUAL_SIGN)) {
+            return statement_result_make_error("LET statement must take form of [ LET ] <identifier>(<index>, ...) = "
+                                               "<initializer>");
+        }
+        token_iterator_advance(state);
+
+        ExpressionIndex initializer = expression_compile(pool, state);
+        if (initializer == EXPRESSION_NONE) {
+            return statement_result_make_error("LET statement has invalid initializer");
+        }
+        return statement_result_make(let_statement_new(arena, line, element, initializer));
+    }
+
     if (match(state, TOKEN_IDENTIFIER) && match_next(state, TOKEN_EQUAL_SIGN)) {
         Token const *identifier_token = token_iterator_current(state);
         token_iterator_advance(state);
         token_iterator_advance(state);
 
-        Expression *initializer = expression_compile(arena, state->current, state->end);
-        if (initializer == NULL) {
+        ExpressionIndex initializer = expression_compile(pool, state);
+        if (initializer == EXPRESSION_NONE) {
             return statement_result_make_error("LET statement has invalid initializer");
         }
-        Expression *variable = variable_expression_new(arena, identifier_token->lexeme, identifier_token->length);
+        char const *identifier = token_iterator_lexeme(state, identifier_token);
+        ExpressionIndex variable = variable_expression_new(pool, identifier, identifier_token->length);
         return statement_result_make(let_statement_new(arena, line, variable, initializer));
     }
     return statement_result_make_error("LET statement must take form of [ LET ] <identifier> = <initializer>");
 }
 
-static StatementResult statement_compile_def_fn(MemoryArena *arena, usize const line, TokenIterator *state) {
+static StatementResult statement_compile_def_fn(MemoryArena *arena,
+                                                ExpressionPool *pool,
+                                                usize const line,
+                                                TokenIterator *state) {
     static const char *form_err = "DEF FN statement must take form of DEF FN <name>(<var>) = <body>";
     token_iterator_advance(state);
     if (!match(state, TOKEN_FN)) {
@@ -133,14 +303,186 @@ static StatementResult statement_compile_def_fn(MemoryArena *arena, usize const
     token_iterator_advance(state);
     token_iterator_advance(state);
 
-    Expression *body = expression_compile(arena, state->current, state->end);
-    if (body == NULL) {
+    ExpressionIndex body = expression_compile(pool, state);
+    if (body == EXPRESSION_NONE) {
         return statement_result_make_error("LET statement has invalid initializer");
     }
 
-    Expression *name = variable_expression_new(arena, name_token->lexeme, name_token->length);
-    Expression *var = variable_expression_new(arena, variable_token->lexeme, variable_token->length);
-    return statement_result_make(def_fn_statement_new(arena, line, name, var, body));
+    char const *name_lexeme = token_iterator_lexeme(state, name_token);
+    char const *variable_lexeme = token_iterator_lexeme(state, variable_token);
+    ExpressionIndex name = variable_expression_new(pool, name_lexeme, name_token->length);
+    ExpressionIndex var = variable_expression_new(pool, variable_lexeme, variable_token->length);
+    return statement_result_make(def_fn_statement_new(arena, pool, line, name, var, body));
+}
+
+/// Compiles a dim statement, which declares a comma separated list of arrays
+static StatementResult statement_compile_dim(MemoryArena *arena,
+                                             ExpressionPool *pool,
+                                             usize const line,
+                                             TokenIterator *state) {
+    static const char *form_err = "DIM statement must take form of DIM <name>(<bound>, ...), ...";
+    token_iterator_advance(state);
+
+    u32 count = 0;
+    u32 capacity = 0;
+    ExpressionIndex *arrays = NULL;
+    for (;;) {
+        ExpressionIndex array = expression_compile_element(pool, state);
+        if (array == EXPRESSION_NONE) {
+            return statement_result_make_error(form_err);
+        }
+        arrays = statement_list_reserve(arena, arrays, count, &capacity, sizeof(ExpressionIndex));
+        arrays[count++] = array;
+        if (!match(state, TOKEN_COMMA)) {
+            break;
+        }
+        token_iterator_advance(state);
+    }
+    return statement_result_make(dim_statement_new(arena, line, arrays, count));
+}
+
+/// Compiles the line number of a goto or gosub statement
+static StatementResult statement_compile_jump_target(MemoryArena *arena,
+                                                     usize const line,
+                                                     TokenIterator *state,
+                                                     StatementType const type) {
+    if (!match(state, TOKEN_NUMBER)) {
+        return statement_result_make_error(type == STATEMENT_GOSUB ? "GOSUB statement must take form of GOSUB <line>"
+                                                                   : "GOTO statement must take form of GOTO <line>");
+    }
+    usize const target = (usize) token_iterator_number(state, token_iterator_current(state));
+    token_iterator_advance(state);
+    return statement_result_make(jump_statement_new(arena, line, type, target));
+}
+
+/// Compiles a goto or gosub statement
+static StatementResult statement_compile_jump(MemoryArena *arena, usize const line, TokenIterator *state) {
+    StatementType const type = match(state, TOKEN_GOSUB) ? STATEMENT_GOSUB : STATEMENT_GOTO;
+    token_iterator_advance(state);
+    return statement_compile_jump_target(arena, line, state, type);
+}
+
+/// Compiles a return statement
+static StatementResult statement_compile_return(MemoryArena *arena, usize const line, TokenIterator *state) {
+    token_iterator_advance(state);
+    return statement_result_make(return_statement_new(arena, line));
+}
+
+/// Compiles an on statement, which selects one of a comma separated list of lines
+static StatementResult statement_compile_on(MemoryArena *arena,
+                                            ExpressionPool *pool,
+                                            usize const line,
+                                            TokenIterator *state) {
+    static const char *form_err = "ON statement must take form of ON <expr> GOTO|GOSUB <line>, ...";
+    token_iterator_advance(state);
+
+    ExpressionIndex selector = expression_compile(pool, state);
+    if (selector == EXPRESSION_NONE || !(match(state, TOKEN_GOTO) || match(state, TOKEN_GOSUB))) {
+        return statement_result_make_error(form_err);
+    }
+    b32 const gosub = match(state, TOKEN_GOSUB);
+    token_iterator_advance(state);
+
+    u32 count = 0;
+    u32 capacity = 0;
+    JumpStatement *jumps = NULL;
+    for (;;) {
+        if (!match(state, TOKEN_NUMBER)) {
+            return statement_result_make_error(form_err);
+        }
+        jumps = statement_list_reserve(arena, jumps, count, &capacity, sizeof(JumpStatement));
+        jumps[count].line = (usize) token_iterator_number(state, token_iterator_current(state));
+        jumps[count].target = PROGRAM_LINE_NONE;
+        count++;
+        token_iterator_advance(state);
+        if (!match(state, TOKEN_COMMA)) {
+            break;
+        }
+        token_iterator_advance(state);
+    }
+    return statement_result_make(on_statement_new(arena, line, selector, gosub, jumps, count));
+}
+
+/// Compiles a for statement
+static StatementResult statement_compile_for(MemoryArena *arena,
+                                             ExpressionPool *pool,
+                                             usize const line,
+                                             TokenIterator *state) {
+    static const char *form_err = "FOR statement must take form of FOR <var> = <start> TO <limit> [ STEP <step> ]";
+    token_iterator_advance(state);
+    if (!match(state, TOKEN_IDENTIFIER) || !match_next(state, TOKEN_EQUAL_SIGN)) {
+        return statement_result_make_error(form_err);
+    }
+    Token const *variable_token = token_iterator_current(state);
+    token_iterator_advance(state);
+    token_iterator_advance(state);
+
+    ExpressionIndex start = expression_compile(pool, state);
+    if (start == EXPRESSION_NONE || !match(state, TOKEN_TO)) {
+        return statement_result_make_error(form_err);
+    }
+    token_iterator_advance(state);
+
+    ExpressionIndex limit = expression_compile(pool, state);
+    if (limit == EXPRESSION_NONE) {
+        return statement_result_make_error(form_err);
+    }
+
+    ExpressionIndex step;
+    if (match(state, TOKEN_STEP)) {
+        token_iterator_advance(state);
+        if ((step = expression_compile(pool, state)) == EXPRESSION_NONE) {
+            return statement_result_make_error(form_err);
+        }
+    } else {
+        step = number_expression_new(pool, 1.0);
+    }
+
+    char const *variable_lexeme = token_iterator_lexeme(state, variable_token);
+    ExpressionIndex variable = variable_expression_new(pool, variable_lexeme, variable_token->length);
+    return statement_result_make(for_statement_new(arena, line, variable, start, limit, step));
+}
+
+/// Compiles a next statement, which takes an optional comma separated list of loop variables
+static StatementResult statement_compile_next(MemoryArena *arena,
+                                              ExpressionPool *pool,
+                                              usize const line,
+                                              TokenIterator *state) {
+    token_iterator_advance(state);
+
+    u32 count = 0;
+    u32 capacity = 0;
+    ExpressionIndex *variables = NULL;
+    while (match(state, TOKEN_IDENTIFIER)) {
+        Token const *variable_token = token_iterator_current(state);
+        char const *variable_lexeme = token_iterator_lexeme(state, variable_token);
+        variables = statement_list_reserve(arena, variables, count, &capacity, sizeof(ExpressionIndex));
+        variables[count++] = variable_expression_new(pool, variable_lexeme, variable_token->length);
+        token_iterator_advance(state);
+        if (!match(state, TOKEN_COMMA)) {
+            break;
+        }
+        token_iterator_advance(state);
+    }
+    return statement_result_make(next_statement_new(arena, line, variables, count));
+}
+
+/// Compiles an if statement, the statements that are executed if the condition holds follow it on the same line
+static StatementResult statement_compile_if(MemoryArena *arena,
+                                            ExpressionPool *pool,
+                                            usize const line,
+                                            TokenIterator *state) {
+    token_iterator_advance(state);
+    ExpressionIndex condition = expression_compile(pool, state);
+    if (condition == EXPRESSION_NONE || !(match(state, TOKEN_THEN) || match(state, TOKEN_GOTO))) {
+        return statement_result_make_error("IF statement must take form of IF <expr> THEN <statement>|<line>");
+    }
+
+    // In IF <expr> GOTO <line>, the GOTO is left for the statement that follows
+    if (match(state, TOKEN_THEN)) {
+        token_iterator_advance(state);
+    }
+    return statement_result_make(if_statement_new(arena, line, condition));
 }
 
 /// Compiles a clear statement
@@ -149,11 +491,34 @@ static StatementResult statement_compile_clear(MemoryArena *arena, usize const l
     return statement_result_make(clear_statement_new(arena, line));
 }
 
+/// Compiles a poke statement
+static StatementResult statement_compile_poke(MemoryArena *arena,
+                                              ExpressionPool *pool,
+                                              usize const line,
+                                              TokenIterator *state) {
+    static const char *form_err = "POKE statement must take form of POKE <address>, <value>";
+    token_iterator_advance(state);
+    ExpressionIndex address = expression_compile(pool, state);
+    if (address == EXPRESSION_NONE || !match(state, TOKEN_COMMA)) {
+        return statement_result_make_error(form_err);
+    }
+    token_iterator_advance(state);
+
+    ExpressionIndex value = expression_compile(pool, state);
+    if (value == EXPRESSION_NONE) {
+        return statement_result_make_error(form_err);
+    }
+    return statement_result_make(poke_statement_new(arena, line, address, value));
+}
+
 /// Compiles a print statement
-static StatementResult statement_compile_print(MemoryArena *arena, usize const line, TokenIterator *state) {
+static StatementResult statement_compile_print(MemoryArena *arena,
+                                               ExpressionPool *pool,
+                                               usize const line,
+                                               TokenIterator *state) {
     token_iterator_advance(state);
-    Expression *printable = expression_compile(arena, state->current, state->end);
-    if (printable == NULL) {
+    ExpressionIndex printable = expression_compile(pool, state);
+    if (printable == EXPRESSION_NONE) {
         return statement_result_make_error("Invalid expression after PRINT statement");
     }
     return statement_result_make(print_statement_new(arena, line, printable));
@@ -164,7 +529,10 @@ static StatementResult statement_compile_run(MemoryArena *arena) {
 }
 
 /// Compiles a statement from the token state
-static StatementResult statement_compile_internal(MemoryArena *arena, usize const line, TokenIterator *state) {
+static StatementResult statement_compile_internal(MemoryArena *arena,
+                                                  ExpressionPool *pool,
+                                                  usize const line,
+                                                  TokenIterator *state) {
     // Clear all variables
     if (match(state, TOKEN_CLEAR)) {
         return statement_compile_clear(arena, line, state);
@@ -172,26 +540,112 @@ static StatementResult statement_compile_internal(MemoryArena *arena, usize cons
 
     // Assignment
     if (match(state, TOKEN_IDENTIFIER) || match(state, TOKEN_LET)) {
-        return statement_compile_let(arena, line, state);
+        return statement_compile_let(arena, pool, line, state);
+    }
+
+    // Array declaration
+    if (match(state, TOKEN_DIM)) {
+        return statement_compile_dim(arena, pool, line, state);
     }
 
     // Single variable function
     if (match(state, TOKEN_DEF)) {
-        return statement_compile_def_fn(arena, line, state);
+        return statement_compile_def_fn(arena, pool, line, state);
+    }
+
+    // Control flow
+    if (match(state, TOKEN_GOTO) || match(state, TOKEN_GOSUB)) {
+        return statement_compile_jump(arena, line, state);
+    }
+    if (match(state, TOKEN_RETURN)) {
+        return statement_compile_return(arena, line, state);
+    }
+    if (match(state, TOKEN_ON)) {
+        return statement_compile_on(arena, pool, line, state);
+    }
+    if (match(state, TOKEN_FOR)) {
+        return statement_compile_for(arena, pool, line, state);
+    }
+    if (match(state, TOKEN_NEXT)) {
+        return statement_compile_next(arena, pool, line, state);
+    }
+    if (match(state, TOKEN_IF)) {
+        return statement_compile_if(arena, pool, line, state);
+    }
+
+    // Memory access
+    if (match(state, TOKEN_POKE)) {
+        return statement_compile_poke(arena, pool, line, state);
     }
 
     // Printing
     if (match(state, TOKEN_PRINT)) {
-        return statement_compile_print(arena, line, state);
+        return statement_compile_print(arena, pool, line, state);
     }
     return statement_result_make_error("Encountered invalid token");
 }
 
+/// Compiles the statements of a line, which are separated by colons. The statement after an IF
+/// follows without a colon, a line number after THEN is a GOTO statement.
+static StatementResult statement_compile_line(MemoryArena *arena,
+                                              ExpressionPool *pool,
+                                              usize const line,
+                                              TokenIterator *state) {
+    u32 count = 0;
+    u32 capacity = 0;
+    Statement **statements = NULL;
+    for (;;) {
+        b32 const then = count > 0 && statements[count - 1]->type == STATEMENT_IF;
+        if (then && token_iterator_end(state)) {
+            return statement_result_make_error("IF statement must take form of IF <expr> THEN <statement>|<line>");
+        }
+        StatementResult const result = then && match(state, TOKEN_NUMBER)
+                                               ? statement_compile_jump_target(arena, line, state, STATEMENT_GOTO)
+                                               : statement_compile_internal(arena, pool, line, state);
+        if (result.type == RESULT_ERROR) {
+            return result;
+        }
+        statements = statement_list_reserve(arena, statements, count, &capacity, sizeof(Statement *));
+        statements[count++] = result.statement;
+        if (result.statement->type == STATEMENT_IF) {
+            continue;
+        }
+        if (token_iterator_end(state)) {
+            break;
+        }
+        if (!match(state, TOKEN_COLON)) {
+            return statement_result_make_error("Statements must be separated by ':'");
+        }
+        token_iterator_advance(state);
+    }
+    return statement_result_make(block_statement_new(arena, line, statements, count));
+}
+
+/// Compiles the bodies of the functions that are defined by the statement. Function bodies are compiled
+/// on their own, as they are evaluated whenever the function is called.
+static const char *statement_compile_functions(MemoryArena *arena, ExpressionPool const *pool, Statement *self) {
+    switch (self->type) {
+        case STATEMENT_DEF_FN:
+            // The statement has been moved into its line, so the definition is only bound to its code here
+            self->def_fn.definition.variable.code = &self->def_fn.body_code;
+            return code_compile_expression(arena, pool, self->def_fn.body, &self->def_fn.body_code);
+        case STATEMENT_BLOCK:
+            for (u32 index = 0; index < self->block.statement_count; ++index) {
+                char const *error = statement_compile_functions(arena, pool, self->block.statements + index);
+                if (error != NULL) {
+                    return error;
+                }
+            }
+            return NULL;
+        default:
+            return NULL;
+    }
+}
+
 /// Compiles a statement from a list of tokens
-StatementResult statement_compile(MemoryArena *arena, Token *begin, Token *end) {
-    TokenIterator state = { 0 };
-    state.current = begin;
-    state.end = end;
+static StatementResult statement_compile(MemoryArena *arena, Program *program, TokenList const *tokens) {
+    TokenIterator state;
+    token_iterator_create(&state, tokens);
 
     if (match(&state, TOKEN_RUN)) {
         return statement_compile_run(arena);
@@ -209,57 +663,454 @@ StatementResult statement_compile(MemoryArena *arena, Token *begin, Token *end)
     Token const *line_token = token_iterator_current(&state);
     token_iterator_advance(&state);
 
-    char *line_begin = line_token->lexeme;
-    char *line_end = line_begin + line_token->length;
-    return statement_compile_internal(arena, strtoull(line_begin, &line_end, 10), &state);
+    usize const line = (usize) token_iterator_number(&state, line_token);
+    ExpressionPool *pool = &program->expressions;
+    StatementResult const result = statement_compile_line(arena, pool, line, &state);
+    if (result.type == RESULT_ERROR) {
+        return result;
+    }
+
+    // Identifiers are resolved to slots once, so that neither the virtual machine nor the
+    // reference interpreter have to consult the symbol table during execution
+    Statement *statement = result.statement;
+    statement_resolve(statement, program);
+    const char *error = statement_check(statement, program);
+    if (error != NULL) {
+        return statement_result_make_error(error);
+    }
+    statement_fold(statement, program);
+
+    // Lower the line to bytecode, the syntax tree is kept for the reference interpreter
+    error = statement_compile_functions(arena, pool, statement);
+    if (error == NULL) {
+        error = code_compile_line(arena, pool, statement, &statement->code);
+    }
+    if (error != NULL) {
+        return statement_result_make_error(error);
+    }
+    return result;
+}
+
+/// Resolves the slots of all variables and functions that are referenced by the statement
+static b32 statement_resolve(Statement *self, Program *program) {
+    b32 changed = false;
+    switch (self->type) {
+        case STATEMENT_LET:
+            changed |= expression_resolve_target(self->let.variable, program);
+            changed |= expression_resolve(self->let.initializer, program, EXPRESSION_NAME_NONE);
+            break;
+        case STATEMENT_DIM:
+            for (u32 index = 0; index < self->dim.array_count; ++index) {
+                changed |= expression_resolve_target(self->dim.arrays[index], program);
+            }
+            break;
+        case STATEMENT_DEF_FN: {
+            ExpressionPool const *pool = &program->expressions;
+            self->def_fn.slot = program_function_slot(program, self->def_fn.definition.name);
+            // The parameter is bound lexically, it does not occupy the slot of a global variable
+            ExpressionName const parameter = expression_pool_get(pool, self->def_fn.variable)->variable.name;
+            changed |= expression_resolve(self->def_fn.body, program, parameter);
+            break;
+        }
+        case STATEMENT_ON:
+            changed |= expression_resolve(self->on.selector, program, EXPRESSION_NAME_NONE);
+            break;
+        case STATEMENT_FOR:
+            changed |= expression_resolve(self->for_loop.variable, program, EXPRESSION_NAME_NONE);
+            changed |= expression_resolve(self->for_loop.start, program, EXPRESSION_NAME_NONE);
+            changed |= expression_resolve(self->for_loop.limit, program, EXPRESSION_NAME_NONE);
+            changed |= expression_resolve(self->for_loop.step, program, EXPRESSION_NAME_NONE);
+            break;
+        case STATEMENT_NEXT:
+            for (u32 index = 0; index < self->next.variable_count; ++index) {
+                changed |= expression_resolve(self->next.variables[index], program, EXPRESSION_NAME_NONE);
+            }
+            break;
+        case STATEMENT_IF:
+            changed |= expression_resolve(self->if_then.condition, program, EXPRESSION_NAME_NONE);
+            break;
+        case STATEMENT_POKE:
+            changed |= expression_resolve(self->poke.address, program, EXPRESSION_NAME_NONE);
+            changed |= expression_resolve(self->poke.value, program, EXPRESSION_NAME_NONE);
+            break;
+        case STATEMENT_BLOCK:
+            for (u32 index = 0; index < self->block.statement_count; ++index) {
+                changed |= statement_resolve(self->block.statements + index, program);
+            }
+            break;
+        case STATEMENT_PRINT:
+            changed |= expression_resolve(self->print.printable, program, EXPRESSION_NAME_NONE);
+            break;
+        default:
+            break;
+    }
+    return changed;
+}
+
+/// Marks the functions that are defined by the statement
+static void statement_define_functions(Statement const *self, b32 *defined) {
+    if (self->type == STATEMENT_DEF_FN) {
+        defined[self->def_fn.slot] = true;
+    } else if (self->type == STATEMENT_BLOCK) {
+        for (u32 index = 0; index < self->block.statement_count; ++index) {
+            statement_define_functions(self->block.statements + index, defined);
+        }
+    }
+}
+
+/// Resolves the statement again and compiles it once more if a reference has turned from a call into an
+/// element or vice versa, the previous bytecode stays valid otherwise
+static char const *statement_bind(Statement *self, Program *program) {
+    if (!statement_resolve(self, program)) {
+        return NULL;
+    }
+    char const *error = statement_check(self, program);
+    if (error == NULL) {
+        error = statement_compile_functions(&program->objects, &program->expressions, self);
+    }
+    if (error == NULL) {
+        error = code_compile_line(&program->objects, &program->expressions, self, &self->code);
+    }
+    return error;
+}
+
+/// Resolves the line number of the jump into a line identifier
+static b32 statement_link_jump(JumpStatement *jump, ProgramLines const *lines) {
+    u32 const index = program_lines_search(lines, jump->line);
+    b32 const found = index < lines->count && lines->data[index].line == jump->line;
+    jump->target = found ? lines->data[index].identifier : PROGRAM_LINE_NONE;
+    return found;
+}
+
+/// Resolves the line numbers the statement jumps to into line identifiers
+static b32 statement_link(Statement *self, ProgramLines const *lines) {
+    b32 linked = true;
+    switch (self->type) {
+        case STATEMENT_GOTO:
+        case STATEMENT_GOSUB:
+            linked = statement_link_jump(&self->jump, lines);
+            break;
+        case STATEMENT_ON:
+            for (u32 index = 0; index < self->on.jump_count; ++index) {
+                linked &= statement_link_jump(self->on.jumps + index, lines);
+            }
+            break;
+        case STATEMENT_BLOCK:
+            for (u32 index = 0; index < self->block.statement_count; ++index) {
+                linked &= statement_link(self->block.statements + index, lines);
+            }
+            break;
+        default:
+            break;
+    }
+    return linked;
+}
+
+/// Checks that the expressions of the statement have the correct types
+static char const *statement_check(Statement const *self, Program const *program) {
+    ExpressionPool const *pool = &program->expressions;
+    char const *error = NULL;
+    switch (self->type) {
+        case STATEMENT_LET: {
+            if ((error = expression_check(pool, self->let.variable)) != NULL ||
+                (error = expression_check(pool, self->let.initializer)) != NULL) {
+                break;
+            }
+            if (expression_is_string(pool, self->let.initializer) != expression_is_string(pool, self->let.variable)) {
+                error = "LET statement assigns a value of the wrong type";
+            }
+            break;
+        }
+        case STATEMENT_DIM:
+            for (u32 index = 0; index < self->dim.array_count && error == NULL; ++index) {
+                error = expression_check(pool, self->dim.arrays[index]);
+            }
+            break;
+        case STATEMENT_DEF_FN: {
+            // Calls to builtins are folded or bound at compile time, therefore builtins must not be redefined
+            FunctionDefinition const *definition = program->functions[self->def_fn.slot];
+            ExpressionName const name = expression_pool_get(pool, self->def_fn.name)->variable.name;
+            char const *identifier = expression_pool_name(pool, name);
+            if ((definition != NULL && definition->type == FUNCTION_DEFINITION_BUILTIN) ||
+                string_function_find(identifier) != STRING_FUNCTION_COUNT || strcmp(identifier, "PEEK") == 0) {
+                error = "DEF FN statement cannot redefine a builtin function";
+                break;
+            }
+            if (expression_pool_get(pool, self->def_fn.variable)->variable.type != VARIABLE_TYPE_REAL) {
+                error = "DEF FN statement must take a real variable";
+                break;
+            }
+            if ((error = expression_check(pool, self->def_fn.body)) == NULL &&
+                expression_is_string(pool, self->def_fn.body)) {
+                error = "DEF FN statement must have an arithmetic body";
+            }
+            break;
+        }
+        case STATEMENT_ON:
+            if ((error = expression_check(pool, self->on.selector)) == NULL &&
+                expression_is_string(pool, self->on.selector)) {
+                error = "ON statement must have an arithmetic selector";
+            }
+            break;
+        case STATEMENT_FOR: {
+            if (expression_pool_get(pool, self->for_loop.variable)->variable.type != VARIABLE_TYPE_REAL) {
+                error = "FOR statement must take a real variable";
+                break;
+            }
+            ExpressionIndex const values[] = { self->for_loop.start, self->for_loop.limit, self->for_loop.step };
+            for (usize index = 0; index < STACK_ARRAY_SIZE(values) && error == NULL; ++index) {
+                if ((error = expression_check(pool, values[index])) == NULL &&
+                    expression_is_string(pool, values[index])) {
+                    error = "FOR statement must have arithmetic bounds";
+                }
+            }
+            break;
+        }
+        case STATEMENT_NEXT:
+            for (u32 index = 0; index < self->next.variable_count; ++index) {
+                if (expression_pool_get(pool, self->next.variables[index])->variable.type != VARIABLE_TYPE_REAL) {
+                    error = "NEXT statement must take real variables";
+                    break;
+                }
+            }
+            break;
+        case STATEMENT_IF:
+            if ((error = expression_check(pool, self->if_then.condition)) == NULL &&
+                expression_is_string(pool, self->if_then.condition)) {
+                error = "IF statement must have an arithmetic condition";
+            }
+            break;
+        case STATEMENT_POKE: {
+            ExpressionIndex const values[] = { self->poke.address, self->poke.value };
+            for (usize index = 0; index < STACK_ARRAY_SIZE(values) && error == NULL; ++index) {
+                if ((error = expression_check(pool, values[index])) == NULL &&
+                    expression_is_string(pool, values[index])) {
+                    error = "POKE statement must have an arithmetic address and value";
+                }
+            }
+            break;
+        }
+        case STATEMENT_BLOCK:
+            for (u32 index = 0; index < self->block.statement_count && error == NULL; ++index) {
+                error = statement_check(self->block.statements + index, program);
+            }
+            break;
+        case STATEMENT_PRINT:
+            error = expression_check(pool, self->print.printable);
+            break;
+        default:
+            break;
+    }
+    return error;
+}
+
+/// Folds the constant subexpressions of all expressions of the statement
+static void statement_fold(Statement *self, Program *program) {
+    switch (self->type) {
+        case STATEMENT_LET:
+            self->let.variable = expression_fold(self->let.variable, program);
+            self->let.initializer = expression_fold(self->let.initializer, program);
+            break;
+        case STATEMENT_DIM:
+            for (u32 index = 0; index < self->dim.array_count; ++index) {
+                self->dim.arrays[index] = expression_fold(self->dim.arrays[index], program);
+            }
+            break;
+        case STATEMENT_DEF_FN:
+            self->def_fn.body = expression_fold(self->def_fn.body, program);
+            self->def_fn.definition.variable.body = self->def_fn.body;
+            break;
+        case STATEMENT_ON:
+            self->on.selector = expression_fold(self->on.selector, program);
+            break;
+        case STATEMENT_FOR:
+            self->for_loop.start = expression_fold(self->for_loop.start, program);
+            self->for_loop.limit = expression_fold(self->for_loop.limit, program);
+            self->for_loop.step = expression_fold(self->for_loop.step, program);
+            break;
+        case STATEMENT_IF:
+            self->if_then.condition = expression_fold(self->if_then.condition, program);
+            break;
+        case STATEMENT_POKE:
+            self->poke.address = expression_fold(self->poke.address, program);
+            self->poke.value = expression_fold(self->poke.value, program);
+            break;
+        case STATEMENT_BLOCK:
+            for (u32 index = 0; index < self->block.statement_count; ++index) {
+                statement_fold(self->block.statements + index, program);
+            }
+            break;
+        case STATEMENT_PRINT:
+            self->print.printable = expression_fold(self->print.printable, program);
+            break;
+        default:
+            break;
+    }
+}
+
+/// Executes a let statement that assigns an array element
+static void statement_execute_let_element(Statement *self, Program *program) {
+    // The indices are evaluated after the value, just like in the virtual machine
+    Expression const *target = expression_pool_get(&program->expressions, self->let.variable);
+    if (expression_is_string(&program->expressions, self->let.variable)) {
+        String const value = expression_evaluate_string(self->let.initializer, program);
+        u32 element;
+        if (element_expression_locate(target, program, &element)) {
+            program_store_string_element(program, element, value);
+        }
+    } else {
+        f64 const value = expression_evaluate(self->let.initializer, program);
+        u32 element;
+        if (!element_expression_locate(target, program, &element)) {
+            return;
+        }
+        if (program->arrays[target->element.slot].type == VARIABLE_TYPE_INTEGER) {
+            program_store_integer_element(program, element, value);
+        } else {
+            program->real_elements[element] = value;
+        }
+    }
+    program->no_wait = true;
 }
 
 /// Executes a line statement
 static void statement_execute_let(Statement *self, Program *program) {
-    Expression *var = self->let.variable;
-    if (expression_is_arithmetic(self->let.initializer)) {
-        // TODO(elias): This here is actually a memory leak since the old unevaluated expression
-        // still lives inside the arena. Imagine having a loop that computes an expression over
-        // and over again. I don't really care about it at the moment but maybe this should be
-        // handled sometime in the future.
-        f64 const result = expression_evaluate(self->let.initializer, program->symbols);
-        self->let.initializer = number_expression_new(&program->objects, result);
-    }
-    hash_map_insert(program->symbols, var->variable.name, self->let.initializer);
+    Expression const *target = expression_pool_get(&program->expressions, self->let.variable);
+    if (target->type == EXPRESSION_ELEMENT) {
+        statement_execute_let_element(self, program);
+        return;
+    }
+
+    // The value is stored in place, in the storage that belongs to the type of the variable
+    VariableExpression const *variable = &target->variable;
+    switch (variable->type) {
+        case VARIABLE_TYPE_INTEGER:
+            program_store_integer(program, variable->slot, expression_evaluate(self->let.initializer, program));
+            break;
+        case VARIABLE_TYPE_STRING:
+            program_store_string(program, variable->slot, expression_evaluate_string(self->let.initializer, program));
+            break;
+        case VARIABLE_TYPE_REAL:
+        default:
+            program->variables[variable->slot] = expression_evaluate(self->let.initializer, program);
+            break;
+    }
     program->no_wait = true;
 }
 
 /// Executes a clear statement
 static void statement_execute_clear(Statement *self, Program *program) {
-    hash_map_clear(program->symbols);
+    program_clear(program);
+    program->no_wait = true;
+}
+
+/// Executes a dim statement
+static void statement_execute_dim(Statement const *self, Program *program) {
+    for (u32 index = 0; index < self->dim.array_count; ++index) {
+        Expression const *array = expression_pool_get(&program->expressions, self->dim.arrays[index]);
+        ExpressionIndex const *arguments = function_expression_arguments(&program->expressions, array);
+        f64 bounds[PROGRAM_ARRAY_DIMENSION_MAX];
+        for (u32 dimension = 0; dimension < array->element.argument_count; ++dimension) {
+            bounds[dimension] = expression_evaluate(arguments[dimension], program);
+        }
+        if (!program_dimension_array(program, array->element.slot, bounds, array->element.argument_count)) {
+            return;
+        }
+    }
     program->no_wait = true;
 }
 
 /// Executes a custom function definition statement
 static void statement_execute_def_fn(Statement const *self, Program *program) {
-    FunctionDefinition *definition = arena_alloc(&program->objects, sizeof(FunctionDefinition));
-    definition->type = FUNCTION_DEFINITION_DYNAMIC;
-    definition->name = self->def_fn.name->variable.name;
-    definition->variable.variable = self->def_fn.variable;
-    definition->variable.body = self->def_fn.body;
-    hash_map_insert(program->symbols, definition->name, definition);
+    program->functions[self->def_fn.slot] = &self->def_fn.definition;
+}
+
+/// Executes a goto or gosub statement, a subroutine returns to the statement after this one
+static void statement_execute_jump(Statement const *self, Program *program) {
+    if (self->type == STATEMENT_GOSUB) {
+        program_gosub(program, self->jump.target, self->index + 1);
+    } else {
+        program_jump(program, self->jump.target);
+    }
+}
+
+/// Executes an on statement with the specified selector
+static b32 statement_execute_on(Statement const *self, Program *program, f64 const selector) {
+    // Selectors that do not select a line fall through, unless they could never select one
+    f64 const index = trunc(selector);
+    if (!(index >= 0.0 && index <= 255.0)) {
+        program_error(program, "ILLEGAL QUANTITY");
+        return false;
+    }
+    if (index < 1.0 || index > (f64) self->on.jump_count) {
+        return true;
+    }
+    u32 const target = self->on.jumps[(u32) index - 1].target;
+    if (self->on.gosub) {
+        program_gosub(program, target, self->index + 1);
+    } else {
+        program_jump(program, target);
+    }
+    return false;
+}
+
+/// Executes a for statement
+static void statement_execute_for(Statement const *self, Program *program) {
+    // The limit and the step are evaluated once, before the loop variable is assigned
+    f64 const start = expression_evaluate(self->for_loop.start, program);
+    f64 const limit = expression_evaluate(self->for_loop.limit, program);
+    f64 const step = expression_evaluate(self->for_loop.step, program);
+    u32 const slot = expression_pool_get(&program->expressions, self->for_loop.variable)->variable.slot;
+    program->variables[slot] = start;
+    program_for(program, slot, limit, step, self->index + 1);
+    program->no_wait = true;
+}
+
+/// Executes a next statement
+static b32 statement_execute_next(Statement const *self, Program *program) {
+    if (self->next.variable_count == 0) {
+        return program_next(program, PROGRAM_LOOP_ANY);
+    }
+
+    // The next loop is only advanced once the previous one has finished
+    for (u32 index = 0; index < self->next.variable_count; ++index) {
+        u32 const slot = expression_pool_get(&program->expressions, self->next.variables[index])->variable.slot;
+        if (!program_next(program, slot)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Executes a poke statement
+static void statement_execute_poke(Statement const *self, Program *program) {
+    f64 const address = expression_evaluate(self->poke.address, program);
+    f64 const value = expression_evaluate(self->poke.value, program);
+    if (program->error == NULL && program_poke(program, address, value)) {
+        program->no_wait = true;
+    }
 }
 
 /// Executes a line statement
 static void statement_execute_print(Statement const *self, Program *program) {
-    Expression *printable = self->print.printable;
-    if (expression_is_arithmetic(printable)) {
-        f64 result = expression_evaluate(printable, program->symbols);
-        program_print_format(program, "%lf\n", result);
+    // Nothing is printed if evaluating the printable failed
+    ExpressionIndex const printable = self->print.printable;
+    if (expression_is_arithmetic(&program->expressions, printable)) {
+        f64 result = expression_evaluate(printable, program);
+        if (program->error == NULL) {
+            program_print_format(program, "%lf\n", result);
+        }
     } else {
-        assert(printable->type == EXPRESSION_STRING && "printable must be arithmetic or string");
-        program_print_format(program, "%.*s\n", printable->string.length, printable->string.data);
+        String const result = expression_evaluate_string(printable, program);
+        if (program->error == NULL) {
+            program_print_format(program, "%.*s\n", (s32) result.length, result.length > 0 ? result.data : "");
+        }
     }
     program->no_wait = false;
 }
 
 /// Executes the statement
-static void statement_execute(Statement *self, Program *program) {
+static b32 statement_execute(Statement *self, Program *program) {
     switch (self->type) {
         case STATEMENT_LET:
             statement_execute_let(self, program);
@@ -267,13 +1118,50 @@ static void statement_execute(Statement *self, Program *program) {
         case STATEMENT_CLEAR:
             statement_execute_clear(self, program);
             break;
+        case STATEMENT_DIM:
+            statement_execute_dim(self, program);
+            break;
         case STATEMENT_DEF_FN:
             statement_execute_def_fn(self, program);
             break;
+        case STATEMENT_GOTO:
+        case STATEMENT_GOSUB:
+            statement_execute_jump(self, program);
+            return false;
+        case STATEMENT_RETURN:
+            program_return(program);
+            return false;
+        case STATEMENT_ON:
+            return statement_execute_on(self, program, expression_evaluate(self->on.selector, program));
+        case STATEMENT_FOR:
+            statement_execute_for(self, program);
+            break;
+        case STATEMENT_NEXT:
+            return statement_execute_next(self, program);
+        case STATEMENT_IF:
+            // The rest of the line is skipped without being evaluated if the condition does not hold
+            return expression_evaluate(self->if_then.condition, program) != 0.0 && program->error == NULL;
+        case STATEMENT_POKE:
+            statement_execute_poke(self, program);
+            break;
+        case STATEMENT_BLOCK:
+            statement_execute_line(self, program, 0);
+            return false;
         case STATEMENT_PRINT:
             statement_execute_print(self, program);
             break;
         default:
             break;
     }
+    return program->error == NULL;
+}
+
+/// Executes the statements of a line, starting at the specified statement
+static void statement_execute_line(Statement *self, Program *program, u32 const position) {
+    BlockStatement const *block = &self->block;
+    for (u32 index = position; index < block->statement_count; ++index) {
+        if (!statement_execute(block->statements + index, program)) {
+            break;
+        }
+    }
 }
@@ -5,18 +5,49 @@
 
 typedef struct Statement Statement;
 
+typedef enum StatementType {
+    // Variable Control
+    STATEMENT_CLEAR,
+    STATEMENT_LET,
+    STATEMENT_DIM,
+    STATEMENT_DEF_FN,
+
+    // Control flow
+    STATEMENT_GOTO,
+    STATEMENT_GOSUB,
+    STATEMENT_RETURN,
+    STATEMENT_ON,
+    STATEMENT_FOR,
+    STATEMENT_NEXT,
+    STATEMENT_IF,
+
+    // Memory access
+    STATEMENT_POKE,
+
+    // A numbered line, which holds the statements that are separated by colons
+    STATEMENT_BLOCK,
+
+    // Emulator commands
+    STATEMENT_PRINT,
+    STATEMENT_RUN
+} StatementType;
+
 typedef struct LetStatement {
-    Expression *variable;
-    Expression *initializer;
+    /// The variable or the array element that is assigned
+    ExpressionIndex variable;
+    ExpressionIndex initializer;
 } LetStatement;
 
 /// Creates a new let statement
 /// @param arena The arena for allocations
 /// @param line The line of the statement
-/// @param variable The variable
+/// @param variable The variable or array element
 /// @param initializer The initializer value of the variable
 /// @return A new let statement
-static Statement *let_statement_new(MemoryArena *arena, usize line, Expression *variable, Expression *initializer);
+static Statement *let_statement_new(MemoryArena *arena,
+                                    usize line,
+                                    ExpressionIndex variable,
+                                    ExpressionIndex initializer);
 
 /// Creates a new clear statement
 /// @param arena The arena for allocations
@@ -24,27 +55,181 @@ static Statement *let_statement_new(MemoryArena *arena, usize line, Expression *
 /// @return A new clear statement
 static Statement *clear_statement_new(MemoryArena *arena, usize line);
 
+typedef struct DimStatement {
+    /// The declared arrays, which are element expressions whose indices are the upper bounds
+    ExpressionIndex *arrays;
+    u32 array_count;
+} DimStatement;
+
+/// Creates a new dim statement
+/// @param arena The arena for allocations
+/// @param line The line of the statement
+/// @param arrays The declared arrays
+/// @param array_count The amount of declared arrays
+/// @return A new dim statement
+static Statement *dim_statement_new(MemoryArena *arena, usize line, ExpressionIndex *arrays, u32 array_count);
+
 typedef struct DefFnStatement {
-    Expression *name;
-    Expression *variable;
-    Expression *body;
+    ExpressionIndex name;
+    ExpressionIndex variable;
+    ExpressionIndex body;
+
+    /// The function slot, which is resolved at compile time
+    u32 slot;
+
+    /// The definition that is bound to the function slot when the statement is executed
+    FunctionDefinition definition;
+    Chunk body_code;
 } DefFnStatement;
 
 /// Creates a new def fn statement
 /// @param arena The arena for allocations
+/// @param pool The expression pool, which holds the name of the function
 /// @param line The line of the statement
 /// @param name The name of the function
 /// @param variable The variable that is used
 /// @param body The body of the function
 /// @return A new def fn statement
 static Statement *def_fn_statement_new(MemoryArena *arena,
+                                       ExpressionPool const *pool,
                                        usize line,
-                                       Expression *name,
-                                       Expression *variable,
-                                       Expression *body);
+                                       ExpressionIndex name,
+                                       ExpressionIndex variable,
+                                       ExpressionIndex body);
+
+typedef struct JumpStatement {
+    /// The number of the line that is jumped to
+    usize line;
+
+    /// The identifier of the line that is jumped to, which is resolved when the program is run
+    u32 target;
+} JumpStatement;
+
+/// Creates a new goto or gosub statement
+/// @param arena The arena for allocations
+/// @param line The line of the statement
+/// @param type Either STATEMENT_GOTO or STATEMENT_GOSUB
+/// @param target The number of the line that is jumped to
+/// @return A new jump statement
+static Statement *jump_statement_new(MemoryArena *arena, usize line, StatementType type, usize target);
+
+/// Creates a new return statement
+/// @param arena The arena for allocations
+/// @param line The line of the statement
+/// @return A new return statement
+static Statement *return_statement_new(MemoryArena *arena, usize line);
+
+typedef struct OnStatement {
+    /// The one-based index of the jump that is taken, the statement is skipped if there is no such jump
+    ExpressionIndex selector;
+
+    /// Whether the lines are called as subroutines
+    b32 gosub;
+    JumpStatement *jumps;
+    u32 jump_count;
+} OnStatement;
+
+/// Creates a new on statement
+/// @param arena The arena for allocations
+/// @param line The line of the statement
+/// @param selector The selector expression
+/// @param gosub Whether the lines are called as subroutines
+/// @param jumps The jumps, one for every line
+/// @param jump_count The amount of jumps
+/// @return A new on statement
+static Statement *on_statement_new(MemoryArena *arena,
+                                   usize line,
+                                   ExpressionIndex selector,
+                                   b32 gosub,
+                                   JumpStatement *jumps,
+                                   u32 jump_count);
+
+typedef struct ForStatement {
+    ExpressionIndex variable;
+    ExpressionIndex start;
+    ExpressionIndex limit;
+
+    /// The step of the loop, which is one if the statement does not specify a step
+    ExpressionIndex step;
+} ForStatement;
+
+/// Creates a new for statement
+/// @param arena The arena for allocations
+/// @param line The line of the statement
+/// @param variable The loop variable
+/// @param start The start value
+/// @param limit The limit
+/// @param step The step
+/// @return A new for statement
+static Statement *for_statement_new(MemoryArena *arena,
+                                    usize line,
+                                    ExpressionIndex variable,
+                                    ExpressionIndex start,
+                                    ExpressionIndex limit,
+                                    ExpressionIndex step);
+
+typedef struct NextStatement {
+    /// The variables of the loops that are advanced one after another, the innermost
+    /// loop is advanced if there are none
+    ExpressionIndex *variables;
+    u32 variable_count;
+} NextStatement;
+
+/// Creates a new next statement
+/// @param arena The arena for allocations
+/// @param line The line of the statement
+/// @param variables The loop variables
+/// @param variable_count The amount of loop variables
+/// @return A new next statement
+static Statement *next_statement_new(MemoryArena *arena, usize line, ExpressionIndex *variables, u32 variable_count);
+
+typedef struct IfStatement {
+    /// The condition, the rest of the line is skipped if it does not hold
+    ExpressionIndex condition;
+} IfStatement;
+
+/// Creates a new if statement
+/// @param arena The arena for allocations
+/// @param line The line of the statement
+/// @param condition The condition
+/// @return A new if statement
+static Statement *if_statement_new(MemoryArena *arena, usize line, ExpressionIndex condition);
+
+typedef struct BlockStatement {
+    /// The statements of the line, which are stored next to each other
+    Statement *statements;
+    u32 statement_count;
+
+    /// The index of the first instruction of every statement in the bytecode of the line, followed
+    /// by the index of the final return instruction
+    u32 *entries;
+} BlockStatement;
+
+/// Creates a new block statement, the statements are copied into a single allocation
+/// @param arena The arena for allocations
+/// @param line The line of the statement
+/// @param statements The statements of the line
+/// @param statement_count The amount of statements
+/// @return A new block statement
+static Statement *block_statement_new(MemoryArena *arena, usize line, Statement **statements, u32 statement_count);
+
+typedef struct PokeStatement {
+    ExpressionIndex address;
+
+    /// The byte that is written to the address
+    ExpressionIndex value;
+} PokeStatement;
+
+/// Creates a new poke statement
+/// @param arena The arena for allocations
+/// @param line The line of the statement
+/// @param address The address
+/// @param value The byte
+/// @return A new poke statement
+static Statement *poke_statement_new(MemoryArena *arena, usize line, ExpressionIndex address, ExpressionIndex value);
 
 typedef struct PrintStatement {
-    Expression *printable;
+    ExpressionIndex printable;
 } PrintStatement;
 
 /// Creates a new print statement
@@ -52,32 +237,36 @@ typedef struct PrintStatement {
 /// @param line The line of the statement
 /// @param printable The printable expression
 /// @return A new print statement
-static Statement *print_statement_new(MemoryArena *arena, usize line, Expression *printable);
+static Statement *print_statement_new(MemoryArena *arena, usize line, ExpressionIndex printable);
 
 /// Creates a new run statement
 /// @param arena The arena for allocations
 /// @return A new run statement
 static Statement *run_statement_new(MemoryArena *arena);
 
-typedef enum StatementType {
-    // Variable Control
-    STATEMENT_CLEAR,
-    STATEMENT_LET,
-    STATEMENT_DEF_FN,
-
-    // Emulator commands
-    STATEMENT_PRINT,
-    STATEMENT_RUN
-} StatementType;
-
 typedef struct Statement {
     usize line;
     StatementType type;
+
+    /// The index of the statement within its line
+    u32 index;
     union {
         LetStatement let;
+        DimStatement dim;
         DefFnStatement def_fn;
+        JumpStatement jump;
+        OnStatement on;
+        ForStatement for_loop;
+        NextStatement next;
+        IfStatement if_then;
+        BlockStatement block;
+        PokeStatement poke;
         PrintStatement print;
     };
+
+    /// The bytecode of the line, which is executed by the virtual machine. Only block statements
+    /// are compiled, the statements of a line share the bytecode of their block.
+    Chunk code;
 } Statement;
 
 typedef enum ResultType {
@@ -95,14 +284,57 @@ typedef struct StatementResult {
 
 /// Compiles a statement from a list of tokens
 /// @param arena The arena for allocations
-/// @param begin The first token in the statement
-/// @param end The last token in the statement
+/// @param program The program whose slots identifiers are resolved to
+/// @param tokens The tokens of the statement
 /// @return The statement or nil if the statement where invalid
-static StatementResult statement_compile(MemoryArena *arena, Token *begin, Token *end);
+static StatementResult statement_compile(MemoryArena *arena, Program *program, TokenList const *tokens);
+
+/// Resolves the slots of all variables and functions that are referenced by the statement
+/// @param self The statement
+/// @param program The program state
+/// @return A boolean value that indicates whether a reference of the form NAME(...) has turned
+///         from a function call into an array element or vice versa
+static b32 statement_resolve(Statement *self, Program *program);
+
+/// Marks the functions that are defined by the DEF FN statements of the statement
+/// @param self The statement
+/// @param defined The flags of all functions, indexed by their slot
+static void statement_define_functions(Statement const *self, b32 *defined);
+
+/// Resolves the slots of the statement again once the whole program is known, and compiles
+/// the statement again if the meaning of a reference of the form NAME(...) has changed
+/// @param self The statement
+/// @param program The program state
+/// @return An error message or NULL if the statement is valid
+static char const *statement_bind(Statement *self, Program *program);
+
+/// Checks that the expressions of the statement have the correct types. Slots must already be resolved.
+/// @param self The statement
+/// @param program The program state
+/// @return An error message or NULL if the statement is valid
+static char const *statement_check(Statement const *self, Program const *program);
+
+/// Resolves the line numbers the statement jumps to into line identifiers
+/// @param self The statement
+/// @param lines The lines of the program
+/// @return A boolean value that indicates whether all lines the statement jumps to exist
+static b32 statement_link(Statement *self, ProgramLines const *lines);
+
+/// Folds the constant subexpressions of all expressions of the statement
+/// @param self The statement
+/// @param program The program state, whose expression pool receives the new nodes
+static void statement_fold(Statement *self, Program *program);
 
 /// Executes the statement
 /// @param self The statement
 /// @param program The program state
-static void statement_execute(Statement *self, Program *program);
+/// @return A boolean value that indicates whether execution continues with the next statement of the line
+static b32 statement_execute(Statement *self, Program *program);
+
+/// Executes the statements of a line, starting at the specified statement
+/// @param self The block statement of the line
+/// @param program The program state
+/// @param position The index of the first statement that is executed
+static void statement_execute_line(Statement *self, Program *program, u32 position);
 
 #endif// RETRO_STMT_H
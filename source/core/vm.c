@@ -0,0 +1,387 @@
+// Copyright (c) 2025 Elias Engelbert Plank
+
+/// Runs the specified chunk from the instruction at entry on the register window that starts at
+/// registers and ends at limit, parameters point to the arguments of the function call the chunk
+/// belongs to. The integer and string parts of the registers start at integers and strings.
+static f64 vm_run(Program *program,
+                  Chunk const *chunk,
+                  u32 entry,
+                  f64 const *parameters,
+                  f64 *registers,
+                  s32 *integers,
+                  String *strings,
+                  f64 const *limit);
+
+/// Calls the function with the specified definition, arguments are passed in the registers
+/// starting at arguments, the registers above them are used as the callee window
+static f64 vm_call(Program *program,
+                   FunctionDefinition const *definition,
+                   f64 *arguments,
+                   s32 *integers,
+                   String *strings,
+                   u32 const count,
+                   f64 const *limit) {
+    if (definition == NULL) {
+        // The DEF FN statement of the function has not been executed yet
+        program_error(program, "UNDEF'D FUNCTION");
+        return 0.0;
+    }
+
+    switch (definition->type) {
+        case FUNCTION_DEFINITION_DYNAMIC: {
+            // The arguments already reside in the registers of the caller, so they serve as the
+            // parameters of the callee without being copied. A missing argument is zero.
+            u32 parameters = count;
+            if (parameters == 0) {
+                arguments[parameters++] = 0.0;
+            }
+            return vm_run(program, definition->variable.code, 0, arguments, arguments + parameters,
+                          integers + parameters, strings + parameters, limit);
+        }
+        case FUNCTION_DEFINITION_BUILTIN: {
+            if (count == definition->builtin.parameter_count) {
+                switch (count) {
+                    case 0:
+                        return definition->builtin.func0();
+                    case 1:
+                        return definition->builtin.func1(arguments[0]);
+                    case 2:
+                        return definition->builtin.func2(arguments[0], arguments[1]);
+                    default:
+                        break;
+                }
+            }
+            break;
+        }
+        default:
+            break;
+    }
+    return 0.0;
+}
+
+/// Looks up an array element, the common case of an index into a dimensioned one-dimensional
+/// array is handled inline, anything else including errors is left to the program
+static b32 vm_element(Program *program, u32 const slot, f64 const *indices, u32 const count, u32 *element) {
+    Array const *array = program->arrays + slot;
+    if (count == 1 && array->dimension_count == 1 && indices[0] >= 0.0 && indices[0] < (f64) array->extents[0]) {
+        *element = array->offset + (u32) indices[0];
+        return true;
+    }
+    return program_array_element(program, slot, indices, count, element);
+}
+
+/// Runs the specified chunk from the instruction at entry on the register window that starts at registers
+static f64 vm_run(Program *program,
+                  Chunk const *chunk,
+                  u32 const entry,
+                  f64 const *parameters,
+                  f64 *registers,
+                  s32 *integers,
+                  String *strings,
+                  f64 const *limit) {
+    if (registers + chunk->registers > limit) {
+        // The register stack is exhausted, which only happens for deeply nested function calls
+        program_error(program, "OUT OF MEMORY");
+        return 0.0;
+    }
+
+    // Slots are only assigned at compile time, so the variable storage cannot move while running
+    f64 *variables = program->variables;
+    Instruction const *pc = chunk->code + entry;
+    if (program->jit.enabled && jit_ready(program, chunk)) {
+        // Native code runs until the chunk returns or an instruction is reached that it leaves to the virtual machine
+        JitFrame const frame = { program, parameters, registers, integers, strings, limit };
+        u32 const resume = jit_run(&program->jit, chunk, entry, &frame);
+        if (resume == JIT_EXIT) {
+            return 0.0;
+        }
+        pc = chunk->code + resume;
+    }
+    f64 const *numbers = chunk->numbers;
+    void const **objects = chunk->objects;
+    for (;;) {
+        Instruction const instruction = *pc++;
+        switch ((Opcode) instruction.opcode) {
+            case OPCODE_LOAD_CONSTANT:
+                registers[instruction.a] = numbers[instruction.c];
+                break;
+            case OPCODE_LOAD_VARIABLE:
+                registers[instruction.a] = variables[instruction.c];
+                break;
+            case OPCODE_LOAD_INTEGER:
+                integers[instruction.a] = program->integers[instruction.c];
+                break;
+            case OPCODE_LOAD_PARAMETER:
+                registers[instruction.a] = parameters[instruction.c];
+                break;
+            case OPCODE_LOAD_STRING:
+                strings[instruction.a].data = objects[instruction.c];
+                strings[instruction.a].length = instruction.b;
+                break;
+            case OPCODE_LOAD_STRING_VARIABLE:
+                strings[instruction.a] = program->strings[instruction.c];
+                break;
+            case OPCODE_LOAD_ELEMENT: {
+                u32 element;
+                if (!vm_element(program, instruction.c, registers + instruction.a, instruction.b, &element)) {
+                    return 0.0;
+                }
+                registers[instruction.a] = program->real_elements[element];
+                break;
+            }
+            case OPCODE_LOAD_INTEGER_ELEMENT: {
+                u32 element;
+                if (!vm_element(program, instruction.c, registers + instruction.a, instruction.b, &element)) {
+                    return 0.0;
+                }
+                integers[instruction.a] = program->integer_elements[element];
+                break;
+            }
+            case OPCODE_LOAD_STRING_ELEMENT: {
+                u32 element;
+                if (!vm_element(program, instruction.c, registers + instruction.a, instruction.b, &element)) {
+                    return 0.0;
+                }
+                strings[instruction.a] = program->string_elements[element];
+                break;
+            }
+            case OPCODE_STORE_VARIABLE:
+                variables[instruction.c] = registers[instruction.a];
+                program->no_wait = true;
+                break;
+            case OPCODE_STORE_INTEGER:
+                if (!program_store_integer(program, instruction.c, registers[instruction.a])) {
+                    return 0.0;
+                }
+                program->no_wait = true;
+                break;
+            case OPCODE_STORE_STRING:
+                program_store_string(program, instruction.c, strings[instruction.a]);
+                program->no_wait = true;
+                break;
+            case OPCODE_STORE_ELEMENT: {
+                u32 element;
+                if (!vm_element(program, instruction.c, registers + instruction.a + 1, instruction.b, &element)) {
+                    return 0.0;
+                }
+                program->real_elements[element] = registers[instruction.a];
+                program->no_wait = true;
+                break;
+            }
+            case OPCODE_STORE_INTEGER_ELEMENT: {
+                u32 element;
+                if (!vm_element(program, instruction.c, registers + instruction.a + 1, instruction.b, &element) ||
+                    !program_store_integer_element(program, element, registers[instruction.a])) {
+                    return 0.0;
+                }
+                program->no_wait = true;
+                break;
+            }
+            case OPCODE_STORE_STRING_ELEMENT: {
+                u32 element;
+                if (!vm_element(program, instruction.c, registers + instruction.a + 1, instruction.b, &element)) {
+                    return 0.0;
+                }
+                program_store_string_element(program, element, strings[instruction.a]);
+                program->no_wait = true;
+                break;
+            }
+            case OPCODE_PEEK:
+                if (!program_peek(program, registers[instruction.b], registers + instruction.a)) {
+                    return 0.0;
+                }
+                break;
+            case OPCODE_POKE:
+                if (!program_poke(program, registers[instruction.a], registers[instruction.b])) {
+                    return 0.0;
+                }
+                program->no_wait = true;
+                break;
+            case OPCODE_NEGATE:
+                registers[instruction.a] = -registers[instruction.b];
+                break;
+            case OPCODE_ADD:
+                registers[instruction.a] = registers[instruction.b] + registers[instruction.c];
+                break;
+            case OPCODE_SUB:
+                registers[instruction.a] = registers[instruction.b] - registers[instruction.c];
+                break;
+            case OPCODE_MUL:
+                registers[instruction.a] = registers[instruction.b] * registers[instruction.c];
+                break;
+            case OPCODE_DIV:
+                registers[instruction.a] = registers[instruction.b] / registers[instruction.c];
+                break;
+            case OPCODE_EQUAL:
+                registers[instruction.a] = registers[instruction.b] == registers[instruction.c] ? 1.0 : 0.0;
+                break;
+            case OPCODE_NOT_EQUAL:
+                registers[instruction.a] = registers[instruction.b] != registers[instruction.c] ? 1.0 : 0.0;
+                break;
+            case OPCODE_LESS:
+                registers[instruction.a] = registers[instruction.b] < registers[instruction.c] ? 1.0 : 0.0;
+                break;
+            case OPCODE_LESS_EQUAL:
+                registers[instruction.a] = registers[instruction.b] <= registers[instruction.c] ? 1.0 : 0.0;
+                break;
+            case OPCODE_GREATER:
+                registers[instruction.a] = registers[instruction.b] > registers[instruction.c] ? 1.0 : 0.0;
+                break;
+            case OPCODE_GREATER_EQUAL:
+                registers[instruction.a] = registers[instruction.b] >= registers[instruction.c] ? 1.0 : 0.0;
+                break;
+            case OPCODE_NOT:
+                registers[instruction.a] = registers[instruction.b] == 0.0 ? 1.0 : 0.0;
+                break;
+            case OPCODE_BOOLEAN:
+                registers[instruction.a] = registers[instruction.b] != 0.0 ? 1.0 : 0.0;
+                break;
+            case OPCODE_INTEGER_CONSTANT:
+                integers[instruction.a] = (s32) instruction.c;
+                break;
+            case OPCODE_INTEGER_ADD:
+                integers[instruction.a] = integers[instruction.b] + integers[instruction.c];
+                break;
+            case OPCODE_INTEGER_SUB:
+                integers[instruction.a] = integers[instruction.b] - integers[instruction.c];
+                break;
+            case OPCODE_INTEGER_MUL:
+                integers[instruction.a] = integers[instruction.b] * integers[instruction.c];
+                break;
+            case OPCODE_INTEGER_EQUAL:
+                integers[instruction.a] = integers[instruction.b] == integers[instruction.c];
+                break;
+            case OPCODE_INTEGER_NOT_EQUAL:
+                integers[instruction.a] = integers[instruction.b] != integers[instruction.c];
+                break;
+            case OPCODE_INTEGER_LESS:
+                integers[instruction.a] = integers[instruction.b] < integers[instruction.c];
+                break;
+            case OPCODE_INTEGER_LESS_EQUAL:
+                integers[instruction.a] = integers[instruction.b] <= integers[instruction.c];
+                break;
+            case OPCODE_INTEGER_GREATER:
+                integers[instruction.a] = integers[instruction.b] > integers[instruction.c];
+                break;
+            case OPCODE_INTEGER_GREATER_EQUAL:
+                integers[instruction.a] = integers[instruction.b] >= integers[instruction.c];
+                break;
+            case OPCODE_INTEGER_STORE:
+                if (!program_store_integer_exact(program, instruction.c, integers[instruction.a])) {
+                    return 0.0;
+                }
+                program->no_wait = true;
+                break;
+            case OPCODE_INTEGER_STORE_ELEMENT: {
+                u32 element;
+                if (!vm_element(program, instruction.c, registers + instruction.a + 1, instruction.b, &element) ||
+                    !program_store_integer_element_exact(program, element, integers[instruction.a])) {
+                    return 0.0;
+                }
+                program->no_wait = true;
+                break;
+            }
+            case OPCODE_INTEGER_TO_REAL:
+                registers[instruction.a] = (f64) integers[instruction.b];
+                break;
+            case OPCODE_BRANCH_FALSE:
+                if (registers[instruction.a] == 0.0) {
+                    pc = chunk->code + instruction.c;
+                }
+                break;
+            case OPCODE_BRANCH_TRUE:
+                if (registers[instruction.a] != 0.0) {
+                    pc = chunk->code + instruction.c;
+                }
+                break;
+            case OPCODE_POWER:
+                registers[instruction.a] = pow(registers[instruction.b], registers[instruction.c]);
+                break;
+            case OPCODE_CALL:
+                registers[instruction.a] =
+                        vm_call(program, program->functions[instruction.c], registers + instruction.a,
+                                integers + instruction.a, strings + instruction.a, instruction.b, limit);
+                if (program->error != NULL) {
+                    // The function stopped the program, the caller must not continue with its result
+                    return 0.0;
+                }
+                break;
+            case OPCODE_CONCATENATE:
+                strings[instruction.a] = string_concatenate(program, strings[instruction.b], strings[instruction.c]);
+                break;
+            case OPCODE_COMPARE_STRING:
+                registers[instruction.a] = (f64) string_compare(strings[instruction.b], strings[instruction.c]);
+                break;
+            case OPCODE_CALL_STRING:
+                strings[instruction.a] = string_function_string(program, (StringFunction) instruction.c,
+                                                                strings + instruction.a, registers + instruction.a,
+                                                                instruction.b);
+                break;
+            case OPCODE_CALL_STRING_NUMBER:
+                registers[instruction.a] = string_function_number(program, (StringFunction) instruction.c,
+                                                                  strings + instruction.a, registers + instruction.a,
+                                                                  instruction.b);
+                break;
+            case OPCODE_JUMP:
+                statement_execute_jump(objects[instruction.c], program);
+                return 0.0;
+            case OPCODE_JUMP_ON:
+                if (!statement_execute_on(objects[instruction.c], program, registers[instruction.a])) {
+                    return 0.0;
+                }
+                break;
+            case OPCODE_RETURN_SUBROUTINE:
+                program_return(program);
+                return 0.0;
+            case OPCODE_FOR:
+                variables[instruction.c] = registers[0];
+                program_for(program, instruction.c, registers[1], registers[2], instruction.b);
+                program->no_wait = true;
+                break;
+            case OPCODE_NEXT:
+                // The following loops are only advanced once this one has finished
+                if (!program_next(program, instruction.c)) {
+                    return 0.0;
+                }
+                break;
+            case OPCODE_CLEAR:
+                program_clear(program);
+                program->no_wait = true;
+                break;
+            case OPCODE_DIMENSION:
+                if (!program_dimension_array(program, instruction.c, registers + instruction.a, instruction.b)) {
+                    return 0.0;
+                }
+                program->no_wait = true;
+                break;
+            case OPCODE_DEFINE_FUNCTION:
+                statement_execute_def_fn(objects[instruction.c], program);
+                break;
+            case OPCODE_PRINT_NUMBER:
+                // Nothing is printed if evaluating the printable failed
+                if (program->error == NULL) {
+                    program_print_format(program, "%lf\n", registers[instruction.a]);
+                }
+                program->no_wait = false;
+                break;
+            case OPCODE_PRINT_STRING: {
+                String const string = strings[instruction.a];
+                if (program->error == NULL) {
+                    program_print_format(program, "%.*s\n", (s32) string.length, string.length > 0 ? string.data : "");
+                }
+                program->no_wait = false;
+                break;
+            }
+            case OPCODE_RETURN:
+                return registers[instruction.a];
+        }
+    }
+}
+
+/// Executes the specified chunk, starting at the instruction at entry
+static f64 vm_execute(Program *program, Chunk const *chunk, u32 const entry) {
+    f64 registers[VM_REGISTER_STACK_SIZE];
+    s32 integers[VM_REGISTER_STACK_SIZE];
+    String strings[VM_REGISTER_STACK_SIZE];
+    return vm_run(program, chunk, entry, NULL, registers, integers, strings, registers + VM_REGISTER_STACK_SIZE);
+}
@@ -0,0 +1,44 @@
+// Copyright (c) 2025 Elias Engelbert Plank
+
+#ifndef RETRO_VM_H
+#define RETRO_VM_H
+
+enum {
+    VM_REGISTER_STACK_SIZE = 4 * CHUNK_REGISTER_COUNT
+};
+
+/// Calls the function with the specified definition, arguments are passed in the registers
+/// starting at arguments, the registers above them are used as the callee window
+/// @param program The program state
+/// @param definition The definition of the function, or NULL if it is not defined
+/// @param arguments The registers that hold the arguments
+/// @param integers The integer part of the registers that hold the arguments
+/// @param strings The string part of the registers that hold the arguments
+/// @param count The amount of arguments
+/// @param limit The end of the register stack
+/// @return The result of the function, or zero if it could not be called
+static f64 vm_call(Program *program,
+                   FunctionDefinition const *definition,
+                   f64 *arguments,
+                   s32 *integers,
+                   String *strings,
+                   u32 count,
+                   f64 const *limit);
+
+/// Looks up an array element
+/// @param program The program state
+/// @param slot The slot of the array
+/// @param indices The registers that hold the indices
+/// @param count The amount of indices
+/// @param element The resulting index of the element in the element storage of the array type
+/// @return A boolean value that indicates whether the element exists, the program stops otherwise
+static b32 vm_element(Program *program, u32 slot, f64 const *indices, u32 count, u32 *element);
+
+/// Executes the specified chunk
+/// @param program The program state
+/// @param chunk The chunk
+/// @param entry The index of the first instruction that is executed, which is the entry of a statement for lines
+/// @return The value of the register named by the final return instruction
+static f64 vm_execute(Program *program, Chunk const *chunk, u32 entry);
+
+#endif// RETRO_VM_H
@@ -1,8 +1,8 @@
 // Copyright (c) 2025 Elias Engelbert Plank
 
 /// Creates a new render command
-static RenderCommand *render_command_new(Vertex const *vertices, u32 const *indices) {
-    RenderCommand *self = malloc(sizeof(RenderCommand));
+static RenderCommand *render_command_new(MemoryPool *pool, Vertex const *vertices, u32 const *indices) {
+    RenderCommand *self = pool_alloc(pool);
     self->prev = NULL;
     self->next = NULL;
     memcpy(self->vertices, vertices, sizeof self->vertices);
@@ -10,11 +10,6 @@ static RenderCommand *render_command_new(Vertex const *vertices, u32 const *indi
     return self;
 }
 
-/// Frees the specified render command instance
-static void render_command_free(RenderCommand *self) {
-    free(self);
-}
-
 /// Creates a new render group
 static RenderGroup *render_group_new(void) {
     RenderGroup *self = malloc(sizeof(RenderGroup));
@@ -22,6 +17,7 @@ static RenderGroup *render_group_new(void) {
     self->end = NULL;
     self->commands = 0;
     self->mutex = mutex_new();
+    POOL_CREATE(&self->pool, RenderCommand);
 
     vertex_array_create(&self->vertex_array);
     vertex_buffer_create(&self->vertex_buffer);
@@ -42,14 +38,9 @@ static RenderGroup *render_group_new(void) {
 /// Clears the specified render group (i.e. deletes the commands)
 static void render_group_clear(RenderGroup *self) {
     mutex_lock(self->mutex);
-    RenderCommand *it = self->begin;
-
-    while (it != NULL) {
-        RenderCommand *tmp = it;
-        it = it->next;
-        render_command_free(tmp);
-    }
 
+    // All commands are dropped at once, the slabs of the pool are kept for the next frame
+    pool_clear(&self->pool);
     self->begin = NULL;
     self->end = NULL;
     self->commands = 0;
@@ -59,6 +50,7 @@ static void render_group_clear(RenderGroup *self) {
 /// Frees the specified render group (i.e. delete the commands and free memory)
 static void render_group_free(RenderGroup *self) {
     render_group_clear(self);
+    pool_destroy(&self->pool);
     mutex_free(self->mutex);
     index_buffer_destroy(&self->index_buffer);
     vertex_buffer_destroy(&self->vertex_buffer);
@@ -72,21 +64,13 @@ static void render_group_push(RenderGroup *self, Vertex const *vertices, u32 con
         ;
 
     mutex_lock(self->mutex);
-    RenderCommand *command = render_command_new(vertices, indices);
+    RenderCommand *command = render_command_new(&self->pool, vertices, indices);
     if (self->begin == NULL) {
         self->begin = command;
-        self->commands++;
-        mutex_unlock(self->mutex);
-        return;
-    }
-
-    RenderCommand *tmp = self->begin;
-    while (tmp->next != NULL) {
-        tmp = tmp->next;
+    } else {
+        self->end->next = command;
+        command->prev = self->end;
     }
-
-    tmp->next = command;
-    command->prev = tmp;
     self->end = command;
     self->commands++;
     mutex_unlock(self->mutex);
@@ -25,14 +25,11 @@ typedef struct RenderCommand {
 } RenderCommand;
 
 /// Creates a new render command
+/// @param pool The pool of the render group that owns the command
 /// @param vertices A list of vertices, must be exactly 4
 /// @param indices A list of indices, must be exactly 6
 /// @return A new render command instance
-static RenderCommand *render_command_new(Vertex const *vertices, u32 const *indices);
-
-/// Frees the specified render command instance
-/// @param self The render command
-static void render_command_free(RenderCommand *self);
+static RenderCommand *render_command_new(MemoryPool *pool, Vertex const *vertices, u32 const *indices);
 
 enum {
     RENDER_GROUP_COMMANDS_MAX = 512
@@ -49,6 +46,9 @@ typedef struct RenderGroup {
     RenderCommand *end;
     u32 commands;
 
+    // the commands are allocated from a pool that is cleared every frame
+    MemoryPool pool;
+
     // drawing data
     VertexArray vertex_array;
     VertexBuffer vertex_buffer;
@@ -1,47 +1,95 @@
 ﻿// Copyright (c) 2025 Elias Engelbert Plank
 
-/// Aligns the specified size according to arena alignment
-static usize arena_alignment_size(MemoryArena const *self, usize size) {
-    usize const align_distance = size % self->alignment;
-    if (align_distance != 0) {
-        size += align_distance;
-    }
-    return size;
+/// Rounds the size up to the next multiple of the granularity, which must be a power of two
+static usize arena_round(usize const size, usize const granularity) {
+    return (size + granularity - 1) & ~(granularity - 1);
 }
 
-/// Aligns the used offset according to arena alignment
-static usize arena_alignment_offset(MemoryArena const *self) {
-    return arena_alignment_size(self, self->current->used);
+/// Aligns the specified size according to arena alignment
+static usize arena_alignment_size(MemoryArena const *self, usize const size) {
+    return arena_round(size, (usize) self->alignment);
 }
 
-static MemoryBlock *arena_block_new(MemoryArena *self, usize const requested_size, b32 const temporary) {
-    // Default block size is 4 Kb, which should be a page?
-    usize const block_size = 4 * 1024;
+/// Releases heap memory that was reserved with malloc
+static void arena_heap_release(void *memory, usize const size) {
+    (void) size;
+    free(memory);
+}
 
+/// Reserves a new block that can hold at least the requested size. Blocks grow geometrically up to
+/// the maximum block size, blocks of arenas with a commit function reserve address space up front.
+static MemoryBlock *arena_block_new(MemoryArena *self, usize const requested_size) {
     // At this point, the requested size is already aligned
-    usize const actual_size = requested_size > block_size ? requested_size : block_size;
+    usize size = requested_size > self->block_size ? requested_size : self->block_size;
+    usize reserved = sizeof(MemoryBlock) + size;
+    usize committed = reserved;
+    if (self->commit != NULL) {
+        reserved = arena_round(reserved > ARENA_RESERVE_SIZE ? reserved : ARENA_RESERVE_SIZE, ARENA_COMMIT_SIZE);
+        committed = arena_round(sizeof(MemoryBlock) + requested_size, ARENA_COMMIT_SIZE);
+        size = reserved - sizeof(MemoryBlock);
+    }
+
+    u8 *memory = self->reserve(reserved);
+    if (memory == NULL) {
+        return NULL;
+    }
+    if (self->commit != NULL && !self->commit(memory, committed)) {
+        self->release(memory, reserved);
+        return NULL;
+    }
 
-    MemoryBlock *block = self->reserve(sizeof(MemoryBlock) + actual_size);
-    block->base = (u8 *) block + sizeof(MemoryBlock);
-    block->size = actual_size;
+    MemoryBlock *block = (MemoryBlock *) memory;
+    block->base = memory + sizeof(MemoryBlock);
+    block->size = size;
+    block->committed = committed;
     block->used = 0;
     block->before = NULL;
-    block->id = self->blocks++;
-    block->temporary = temporary;
-    self->total_memory += block_size;
+    self->blocks++;
+    self->committed += committed;
+    if (self->block_size < ARENA_BLOCK_SIZE_MAX) {
+        self->block_size *= 2;
+    }
     return block;
 }
 
+/// Takes the first unused block that can hold the requested size, or reserves a new one
+static MemoryBlock *arena_block_acquire(MemoryArena *self, usize const requested_size) {
+    for (MemoryBlock **it = &self->unused; *it != NULL; it = &(*it)->before) {
+        MemoryBlock *block = *it;
+        if (block->size >= requested_size) {
+            *it = block->before;
+            block->used = 0;
+            block->before = NULL;
+            return block;
+        }
+    }
+    return arena_block_new(self, requested_size);
+}
+
+/// Moves the current block to the unused blocks, the block before it becomes the current block
+static void arena_block_retire(MemoryArena *self) {
+    MemoryBlock *block = self->current;
+    self->current = block->before;
+    self->used -= block->used;
+    block->before = self->unused;
+    self->unused = block;
+}
+
 /// Creates a new memory arena
 static MemoryArena arena_make(ArenaSpecification const *spec) {
     MemoryArena result;
     result.alignment = spec->alignment;
     result.reserve = spec->reserve;
+    result.commit = spec->commit;
     result.release = spec->release;
     result.blocks = 0;
-    result.total_memory = 0;
-    result.current = arena_block_new(&result, 0, false);
-    result.temporary = false;
+    result.block_size = ARENA_BLOCK_SIZE_MIN;
+    result.committed = 0;
+    result.used = 0;
+    result.unused = NULL;
+    result.temporary = NULL;
+    result.temporary_used = 0;
+    result.current = arena_block_new(&result, 0);
     return result;
 }
 
@@ -50,57 +98,100 @@ static MemoryArena arena_identity(MemoryAlignment const alignment) {
     ArenaSpecification spec;
     spec.alignment = alignment;
     spec.reserve = malloc;
-    spec.release = free;
+    spec.commit = NULL;
+    spec.release = arena_heap_release;
     return arena_make(&spec);
 }
 
-/// Destroys the specified memory arena
-static void arena_destroy(MemoryArena *self) {
-    while (self->current != NULL) {
-        MemoryBlock *before = self->current->before;
+/// Releases all blocks of the list
+static void arena_release_blocks(MemoryArena const *self, MemoryBlock *block) {
+    while (block != NULL) {
+        MemoryBlock *before = block->before;
         // We must release the memory block itself as it is the base of the allocation
-        self->release(self->current);
-        self->current = before;
+        self->release(block, sizeof(MemoryBlock) + block->size);
+        block = before;
     }
+}
+
+/// Destroys the specified memory arena
+static void arena_destroy(MemoryArena *self) {
+    arena_release_blocks(self, self->current);
+    arena_release_blocks(self, self->unused);
     self->reserve = NULL;
+    self->commit = NULL;
     self->release = NULL;
     self->current = NULL;
-}
-
-static void arena_append_block(MemoryArena *self, MemoryBlock *block) {
-    block->before = self->current;
-    self->current = block;
+    self->unused = NULL;
+    self->temporary = NULL;
+    self->blocks = 0;
+    self->committed = 0;
+    self->used = 0;
 }
 
 /// Allocates a block of memory in the specified arena
 static void *arena_alloc(MemoryArena *self, usize const size) {
+    // Every allocation is padded to the alignment, so the used offset is always aligned
     usize const aligned_size = arena_alignment_size(self, size);
 
-    if (self->current->used + aligned_size > self->current->size) {
-        MemoryBlock *block = arena_block_new(self, aligned_size, self->temporary);
-        arena_append_block(self, block);
+    MemoryBlock *block = self->current;
+    if (block->used + aligned_size > block->size) {
+        if ((block = arena_block_acquire(self, aligned_size)) == NULL) {
+            return NULL;
+        }
+        block->before = self->current;
+        self->current = block;
     }
 
-    usize const aligned_offset = arena_alignment_offset(self);
-    u8 *result = self->current->base + aligned_offset;
-    self->current->used = aligned_offset + aligned_size;
+    usize const end = sizeof(MemoryBlock) + block->used + aligned_size;
+    if (end > block->committed) {
+        usize const committed = arena_round(end, ARENA_COMMIT_SIZE);
+        if (!self->commit((u8 *) block + block->committed, committed - block->committed)) {
+            return NULL;
+        }
+        self->committed += committed - block->committed;
+        block->committed = committed;
+    }
+
+    u8 *result = block->base + block->used;
+    block->used += aligned_size;
+    self->used += aligned_size;
     return result;
 }
 
+/// Frees all allocations of the arena at once, the blocks are kept for reuse
+static void arena_reset(MemoryArena *self) {
+    while (self->current->before != NULL) {
+        arena_block_retire(self);
+    }
+    self->current->used = 0;
+    self->used = 0;
+    self->temporary = NULL;
+}
+
 /// Begins a temporary scope where all subsequent allocations are freed after
 /// calling arena_end_temporary(). Note that previous allocations are not
 /// affected.
 static void arena_begin_temporary(MemoryArena *self) {
-    self->temporary = true;
-    MemoryBlock *block = arena_block_new(self, 0, true);
-    arena_append_block(self, block);
+    self->temporary = self->current;
+    self->temporary_used = self->current->used;
 }
 
-/// Ends the temporary scope by freeing all memory allocations that are
-/// marked as temporary.
+/// Ends the temporary scope by freeing all allocations that were made since
+/// the scope began, their blocks are kept for reuse.
 static void arena_end_temporary(MemoryArena *self) {
-    self->temporary = false;
-    for (; self->current != NULL && self->current->temporary; self->current = self->current->before) {
-        self->release(self->current);
+    if (self->temporary == NULL) {
+        return;
     }
+    while (self->current != self->temporary) {
+        arena_block_retire(self);
+    }
+    self->used -= self->current->used - self->temporary_used;
+    self->current->used = self->temporary_used;
+    self->temporary = NULL;
+}
+
+/// Ends the temporary scope, but keeps all allocations that were made since
+/// the scope began, as if they had never been temporary.
+static void arena_keep_temporary(MemoryArena *self) {
+    self->temporary = NULL;
 }
@@ -4,7 +4,8 @@
 #define RETRO_UTILS_ARENA_H
 
 typedef void *(*ReserveFunction)(usize);
-typedef void (*ReleaseFunction)(void *);
+typedef b32 (*CommitFunction)(void *, usize);
+typedef void (*ReleaseFunction)(void *, usize);
 
 typedef enum MemoryAlignment {
     ALIGNMENT1 = 1,
@@ -12,31 +13,66 @@ typedef enum MemoryAlignment {
     ALIGNMENT8 = 8
 } MemoryAlignment;
 
+enum {
+    /// The size of the first block of an arena, every further block is twice as large as the one before
+    ARENA_BLOCK_SIZE_MIN = 4 * 1024,
+
+    /// Blocks stop growing once they reach this size, unless a single allocation is larger
+    ARENA_BLOCK_SIZE_MAX = 1024 * 1024,
+
+    /// The address space that a block of an arena with a commit function reserves
+    ARENA_RESERVE_SIZE = 64 * 1024 * 1024,
+
+    /// Reserved memory is committed in steps of this size, which must be a multiple of the page size
+    ARENA_COMMIT_SIZE = 64 * 1024
+};
+
 typedef struct ArenaSpecification {
     MemoryAlignment alignment;
     ReserveFunction reserve;
+
+    /// Commits reserved memory before it is used, or NULL if reserved memory can be used right away
+    CommitFunction commit;
     ReleaseFunction release;
 } ArenaSpecification;
 
 typedef struct MemoryBlock MemoryBlock;
 
 typedef struct MemoryBlock {
+    /// The size of the memory after the block header, which is the usable size of the block
     usize size;
+
+    /// The size of the memory that is committed, including the block header
+    usize committed;
     usize used;
     u8 *base;
     MemoryBlock *before;
-    usize id;
-    b32 temporary;
 } MemoryBlock;
 
 typedef struct MemoryArena {
     MemoryBlock *current;
+
+    /// The blocks that are kept for reuse after the arena has been reset
+    MemoryBlock *unused;
     MemoryAlignment alignment;
     ReserveFunction reserve;
+    CommitFunction commit;
     ReleaseFunction release;
     u32 blocks;
-    u32 total_memory;
-    b32 temporary;
+
+    /// The size of the next block that is reserved
+    usize block_size;
+
+    /// The bytes that are committed in all blocks, including the block headers
+    usize committed;
+
+    /// The bytes that have been handed out, including the padding for the alignment
+    usize used;
+
+    /// The block and its used bytes at the beginning of the temporary scope, the block is NULL
+    /// if there is no temporary scope
+    MemoryBlock *temporary;
+    usize temporary_used;
 } MemoryArena;
 
 /// Creates a new memory arena
@@ -62,16 +98,26 @@ static void arena_destroy(MemoryArena *self);
 /// @return Memory
 static void *arena_alloc(MemoryArena *self, usize size);
 
+/// Frees all allocations of the arena at once. The blocks are kept and reused by
+/// later allocations, so that they do not need to be reserved again.
+/// @param self The arena
+static void arena_reset(MemoryArena *self);
+
 /// Begins a temporary scope where all subsequent allocations are freed after
 /// calling arena_end_temporary(). Note that previous allocations are not
 /// affected.
 /// @param self The arena
 static void arena_begin_temporary(MemoryArena *self);
 
-/// Ends the temporary scope by freeing all memory allocations that are
-/// marked as temporary.
+/// Ends the temporary scope by freeing all allocations that were made since
+/// the scope began, their blocks are kept for reuse.
 /// @param self The arena
 static void arena_end_temporary(MemoryArena *self);
 
+/// Ends the temporary scope, but keeps all allocations that were made since
+/// the scope began, as if they had never been temporary.
+/// @param self The arena
+static void arena_keep_temporary(MemoryArena *self);
+
 
 #endif// RETRO_UTILS_ARENA_H
@@ -0,0 +1,57 @@
+// Copyright (c) 2025 Elias Engelbert Plank
+
+/// Retrieves the first 16 bits of the data string
+static u32 hash_get16bits(const char *data) {
+    return (((u32) (data[1])) << 8) + (u32) data[0];
+}
+
+/// Computes hash of byte array
+static u32 hash(const char *data, usize size) {
+    if (size == 0 || data == NULL) {
+        return 0;
+    }
+
+    u32 result = size;
+    u32 const remainder = size & 3;
+    size >>= 2;
+
+    // main loop
+    for (u32 temp = 0; size > 0; size--) {
+        result += hash_get16bits(data);
+        temp = (u32) (hash_get16bits(data + 2) << 11) ^ result;
+        result = (result << 16) ^ temp;
+        data += 2 * sizeof(u16);
+        result += result >> 11;
+    }
+
+    // handle end cases
+    switch (remainder) {
+        case 3:
+            result += hash_get16bits(data);
+            result ^= result << 16;
+            result ^= (u32) (((signed char) data[sizeof(u16)]) << 18);
+            result += result >> 11;
+            break;
+        case 2:
+            result += hash_get16bits(data);
+            result ^= result << 11;
+            result += result >> 17;
+            break;
+        case 1:
+            result += (u32) ((signed char) *data);
+            result ^= result << 10;
+            result += result >> 1;
+        default:
+            break;
+    }
+
+    // force avalanche of final 127 bites
+    result ^= result << 3;
+    result += result >> 5;
+    result ^= result << 4;
+    result += result >> 17;
+    result ^= result << 25;
+    result += result >> 6;
+
+    return result;
+}
@@ -0,0 +1,17 @@
+// Copyright (c) 2025 Elias Engelbert Plank
+
+#ifndef RETRO_UTIL_HASH_H
+#define RETRO_UTIL_HASH_H
+
+/// Superfast hash function by paul hsieh
+/// @cite http://www.azillionmonkeys.com/qed/hash.html
+/// @author paul hsieh
+/// @copyright 2010, paul hsieh
+///
+/// Computes hash of byte array
+/// @param data byte array that shall be hashed
+/// @param size size of the byte array
+/// @return superfast hash
+static u32 hash(const char *data, usize size);
+
+#endif// RETRO_UTIL_HASH_H
@@ -0,0 +1,108 @@
+// Copyright (c) 2025 Elias Engelbert Plank
+
+/// Allocates empty buckets with the specified capacity, which must be a power of two
+static void intern_table_allocate(InternTable *self, u32 const capacity) {
+    self->buckets = calloc(capacity, sizeof(InternName));
+    self->bucket_capacity = capacity;
+}
+
+/// Creates an empty intern table
+static void intern_table_create(InternTable *self) {
+    self->capacity = INTERN_TABLE_CAPACITY;
+    self->entries = malloc(self->capacity * sizeof(InternEntry));
+    self->characters = arena_identity(ALIGNMENT1);
+    intern_table_allocate(self, INTERN_TABLE_CAPACITY * 2);
+
+    // The first entry is reserved, so that its identifier can stand for none
+    self->entries[INTERN_NAME_NONE].string = "";
+    self->entries[INTERN_NAME_NONE].length = 0;
+    self->entries[INTERN_NAME_NONE].hash = 0;
+    self->count = 1;
+}
+
+/// Destroys the intern table and all its strings
+static void intern_table_destroy(InternTable *self) {
+    free(self->entries);
+    free(self->buckets);
+    arena_destroy(&self->characters);
+    self->entries = NULL;
+    self->buckets = NULL;
+    self->count = 0;
+    self->capacity = 0;
+    self->bucket_capacity = 0;
+}
+
+/// Looks up the bucket of the string, which is either the bucket that holds its identifier or
+/// the empty bucket where it would be placed
+static InternName *intern_table_bucket(InternTable const *self,
+                                       char const *string,
+                                       usize const length,
+                                       u32 const hash) {
+    u32 const mask = self->bucket_capacity - 1;
+    for (u32 index = hash & mask;; index = (index + 1) & mask) {
+        InternName *bucket = self->buckets + index;
+        if (*bucket == INTERN_NAME_NONE) {
+            return bucket;
+        }
+        InternEntry const *entry = self->entries + *bucket;
+        if (entry->hash == hash && entry->length == length && memcmp(entry->string, string, length) == 0) {
+            return bucket;
+        }
+    }
+}
+
+/// Doubles the capacity of the buckets and places all identifiers again, using the hashes that
+/// were computed when the strings were interned
+static void intern_table_grow(InternTable *self) {
+    InternName *buckets = self->buckets;
+    u32 const capacity = self->bucket_capacity;
+    intern_table_allocate(self, capacity * 2);
+
+    u32 const mask = self->bucket_capacity - 1;
+    for (u32 index = 0; index < capacity; ++index) {
+        if (buckets[index] == INTERN_NAME_NONE) {
+            continue;
+        }
+        u32 bucket = self->entries[buckets[index]].hash & mask;
+        while (self->buckets[bucket] != INTERN_NAME_NONE) {
+            bucket = (bucket + 1) & mask;
+        }
+        self->buckets[bucket] = buckets[index];
+    }
+    free(buckets);
+}
+
+/// Interns the string, so that equal strings have the same identifier
+static InternName intern_table_intern(InternTable *self, char const *string, usize const length) {
+    u32 const key_hash = hash(string, length);
+    InternName *bucket = intern_table_bucket(self, string, length, key_hash);
+    if (*bucket != INTERN_NAME_NONE) {
+        return *bucket;
+    }
+
+    // Keep the load factor of the buckets at or below one half
+    if ((self->count + 1) * 2 > self->bucket_capacity) {
+        intern_table_grow(self);
+        bucket = intern_table_bucket(self, string, length, key_hash);
+    }
+    if (self->count == self->capacity) {
+        self->capacity *= 2;
+        self->entries = realloc(self->entries, self->capacity * sizeof(InternEntry));
+    }
+
+    char *copy = arena_alloc(&self->characters, length + 1);
+    memcpy(copy, string, length);
+    copy[length] = '\0';
+
+    InternEntry *entry = self->entries + self->count;
+    entry->string = copy;
+    entry->length = (u32) length;
+    entry->hash = key_hash;
+    *bucket = self->count;
+    return self->count++;
+}
+
+/// Retrieves the interned string with the specified identifier
+static InternEntry const *intern_table_entry(InternTable const *self, InternName const name) {
+    return self->entries + name;
+}
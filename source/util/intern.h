@@ -0,0 +1,63 @@
+// Copyright (c) 2025 Elias Engelbert Plank
+
+#ifndef RETRO_UTIL_INTERN_H
+#define RETRO_UTIL_INTERN_H
+
+/// The identifier of an interned string, equal strings have the same identifier
+typedef u32 InternName;
+
+enum {
+    /// The identifier of no string, which is never assigned to a string
+    INTERN_NAME_NONE = 0,
+
+    /// The initial capacity of the strings of an intern table, the buckets hold twice as many
+    INTERN_TABLE_CAPACITY = 64
+};
+
+/// An interned string. The hash is computed once when the string is interned, so that looking
+/// up an interned string never needs to hash it again.
+typedef struct InternEntry {
+    char const *string;
+    u32 length;
+    u32 hash;
+} InternEntry;
+
+/// The intern table stores every distinct string exactly once and assigns it a small identifier,
+/// therefore comparing interned strings is an integer comparison and the identifiers can index
+/// arrays directly. The buckets are an open addressing hash table with linear probing that maps
+/// the strings to their identifiers, an empty bucket holds INTERN_NAME_NONE.
+typedef struct InternTable {
+    /// The interned strings, indexed by their identifier
+    InternEntry *entries;
+    u32 count;
+    u32 capacity;
+
+    InternName *buckets;
+    u32 bucket_capacity;
+
+    /// The characters of the interned strings
+    MemoryArena characters;
+} InternTable;
+
+/// Creates an empty intern table
+/// @param self The intern table
+static void intern_table_create(InternTable *self);
+
+/// Destroys the intern table and all its strings
+/// @param self The intern table
+static void intern_table_destroy(InternTable *self);
+
+/// Interns the string, so that equal strings have the same identifier
+/// @param self The intern table
+/// @param string The string, which does not need to be terminated
+/// @param length The length of the string
+/// @return The identifier of the string
+static InternName intern_table_intern(InternTable *self, char const *string, usize length);
+
+/// Retrieves the interned string with the specified identifier
+/// @param self The intern table
+/// @param name The identifier of the string
+/// @return The interned string
+static InternEntry const *intern_table_entry(InternTable const *self, InternName name);
+
+#endif// RETRO_UTIL_INTERN_H
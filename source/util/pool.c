@@ -0,0 +1,69 @@
+// Copyright (c) 2025 Elias Engelbert Plank
+
+/// Creates an empty pool
+static void pool_create(MemoryPool *self, usize const slot_size) {
+    self->arena = arena_identity(ALIGNMENT8);
+
+    // Free slots hold the link to the next free slot, so every slot must be able to hold a pointer
+    usize const size = slot_size > sizeof(PoolSlot) ? slot_size : sizeof(PoolSlot);
+    self->slot_size = arena_alignment_size(&self->arena, size);
+    self->free = NULL;
+    self->cursor = NULL;
+    self->limit = NULL;
+    self->slab_slots = POOL_SLAB_SLOTS;
+    self->used = 0;
+}
+
+/// Destroys the pool and all its slots
+static void pool_destroy(MemoryPool *self) {
+    arena_destroy(&self->arena);
+    self->free = NULL;
+    self->cursor = NULL;
+    self->limit = NULL;
+    self->used = 0;
+}
+
+/// Allocates an uninitialized slot
+static void *pool_alloc(MemoryPool *self) {
+    if (self->free != NULL) {
+        PoolSlot *slot = self->free;
+        self->free = slot->next;
+        self->used++;
+        return slot;
+    }
+
+    if (self->cursor == self->limit) {
+        usize const size = self->slab_slots * self->slot_size;
+        u8 *slab = arena_alloc(&self->arena, size);
+        if (slab == NULL) {
+            return NULL;
+        }
+        self->cursor = slab;
+        self->limit = slab + size;
+        if (self->slab_slots < POOL_SLAB_SLOTS_MAX) {
+            self->slab_slots *= 2;
+        }
+    }
+    void *slot = self->cursor;
+    self->cursor += self->slot_size;
+    self->used++;
+    return slot;
+}
+
+/// Returns the slot to the pool
+static void pool_free(MemoryPool *self, void *slot) {
+    PoolSlot *free = slot;
+    free->next = self->free;
+    self->free = free;
+    self->used--;
+}
+
+/// Frees all slots at once, the slabs are kept for reuse
+static void pool_clear(MemoryPool *self) {
+    arena_reset(&self->arena);
+    self->free = NULL;
+    self->cursor = NULL;
+    self->limit = NULL;
+    self->slab_slots = POOL_SLAB_SLOTS;
+    self->used = 0;
+}
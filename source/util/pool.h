@@ -0,0 +1,68 @@
+// Copyright (c) 2025 Elias Engelbert Plank
+
+#ifndef RETRO_UTIL_POOL_H
+#define RETRO_UTIL_POOL_H
+
+enum {
+    /// The amount of slots of the first slab, every further slab is twice as large as the one before
+    POOL_SLAB_SLOTS = 64,
+
+    /// Slabs stop growing once they have this amount of slots
+    POOL_SLAB_SLOTS_MAX = 4096
+};
+
+/// A free slot of the pool, which links to the next free slot
+typedef struct PoolSlot PoolSlot;
+
+typedef struct PoolSlot {
+    PoolSlot *next;
+} PoolSlot;
+
+/// A pool hands out slots of a fixed size. Slots are carved out of slabs, which are allocated in the
+/// arena of the pool, and freed slots are kept in a free list, so that allocating and freeing a slot
+/// takes constant time and never calls the system allocator once the pool has grown large enough.
+typedef struct MemoryPool {
+    MemoryArena arena;
+    usize slot_size;
+
+    /// The free slots, the most recently freed slot is reused first
+    PoolSlot *free;
+
+    /// The slots of the current slab that have never been handed out
+    u8 *cursor;
+    u8 *limit;
+    u32 slab_slots;
+
+    /// The amount of slots that are currently handed out
+    u32 used;
+} MemoryPool;
+
+/// Creates a pool for slots of the specified type
+/// @param pool The pool
+/// @param type The type of the slots
+#define POOL_CREATE(pool, type) pool_create((pool), sizeof(type))
+
+/// Creates an empty pool
+/// @param self The pool
+/// @param slot_size The size of every slot
+static void pool_create(MemoryPool *self, usize slot_size);
+
+/// Destroys the pool and all its slots
+/// @param self The pool
+static void pool_destroy(MemoryPool *self);
+
+/// Allocates an uninitialized slot
+/// @param self The pool
+/// @return The slot
+static void *pool_alloc(MemoryPool *self);
+
+/// Returns the slot to the pool
+/// @param self The pool
+/// @param slot The slot, which must have been allocated from this pool
+static void pool_free(MemoryPool *self, void *slot);
+
+/// Frees all slots at once, the slabs are kept for reuse
+/// @param self The pool
+static void pool_clear(MemoryPool *self);
+
+#endif// RETRO_UTIL_POOL_H
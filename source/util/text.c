@@ -68,52 +68,45 @@ static void text_cursor_clear(TextCursor *self) {
 }
 
 /// Creates a new text entry
-static TextEntry *text_entry_new(char const *data, usize const length) {
-    TextEntry *self = malloc(sizeof(TextEntry));
+static TextEntry *text_entry_new(TextQueue *queue, char const *data, usize const length) {
+    TextEntry *self = pool_alloc(&queue->pool);
     self->prev = NULL;
     self->next = NULL;
 
-    self->data = (char *) malloc((usize) (length) + 1);
-    self->length = length;
-    memcpy(self->data, data, length);
+    // The text is stored in the slot right behind the entry
+    self->data = (char *) (self + 1);
+    self->length = length < TEXT_ENTRY_LENGTH_MAX ? length : TEXT_ENTRY_LENGTH_MAX;
+    memcpy(self->data, data, self->length);
     self->data[self->length] = '\0';
     return self;
 }
 
-/// Frees the text entry
-static void text_entry_free(TextEntry *self) {
-    free(self->data);
-    self->prev = NULL;
-    self->next = NULL;
-    self->data = NULL;
-    self->length = 0;
-    free(self);
+/// Frees the text entry, its slot is returned to the pool of the text queue
+static void text_entry_free(TextQueue *queue, TextEntry *self) {
+    pool_free(&queue->pool, self);
 }
 
 /// Creates a new text queue
-static TextQueue *text_queue_new(void) {
+static TextQueue *text_queue_new(usize const capacity) {
     TextQueue *self = malloc(sizeof(TextQueue));
     self->begin = NULL;
     self->end = NULL;
     self->entries = 0;
+    self->capacity = capacity;
+    pool_create(&self->pool, sizeof(TextEntry) + TEXT_ENTRY_LENGTH_MAX + 1);
     return self;
 }
 
 /// Frees the text queue
 static void text_queue_free(TextQueue *self) {
     text_queue_clear(self);
+    pool_destroy(&self->pool);
     free(self);
 }
 
 /// Clears the text queue
 static void text_queue_clear(TextQueue *self) {
-    TextEntry *it = self->begin;
-
-    while (it != NULL) {
-        TextEntry *tmp = it;
-        it = it->next;
-        text_entry_free(tmp);
-    }
+    pool_clear(&self->pool);
     self->begin = NULL;
     self->end = NULL;
     self->entries = 0;
@@ -121,21 +114,25 @@ static void text_queue_clear(TextQueue *self) {
 
 /// Pushes data to the text queue
 static void text_queue_push(TextQueue *self, char const *data, usize const length) {
-    TextEntry *entry = text_entry_new(data, length);
-    if (self->begin == NULL) {
-        self->begin = entry;
-        entry->prev = NULL;
-        self->entries++;
-        return;
+    if (self->entries == self->capacity) {
+        TextEntry *oldest = self->begin;
+        self->begin = oldest->next;
+        if (self->begin != NULL) {
+            self->begin->prev = NULL;
+        } else {
+            self->end = NULL;
+        }
+        self->entries--;
+        text_entry_free(self, oldest);
     }
 
-    TextEntry *tmp = self->begin;
-    while (tmp->next != NULL) {
-        tmp = tmp->next;
+    TextEntry *entry = text_entry_new(self, data, length);
+    if (self->begin == NULL) {
+        self->begin = entry;
+    } else {
+        self->end->next = entry;
+        entry->prev = self->end;
     }
-
-    tmp->next = entry;
-    entry->prev = tmp;
     self->end = entry;
     self->entries++;
 }
@@ -44,6 +44,11 @@ static b32 text_cursor_is_full(TextCursor const *self);
 /// @param self The text cursor handle
 static void text_cursor_clear(TextCursor *self);
 
+enum {
+    /// The longest text a text entry holds, longer text is cut off
+    TEXT_ENTRY_LENGTH_MAX = 255
+};
+
 typedef struct TextEntry {
     struct TextEntry *prev;
     struct TextEntry *next;
@@ -51,25 +56,35 @@ typedef struct TextEntry {
     usize length;
 } TextEntry;
 
+typedef struct TextQueue {
+    TextEntry *begin;
+    TextEntry *end;
+    usize entries;
+
+    /// The maximum amount of entries, the oldest entry is dropped once the queue is full
+    usize capacity;
+
+    /// The entries are allocated from a pool together with their text, so that the slot of a
+    /// dropped entry is reused by the next one
+    MemoryPool pool;
+} TextQueue;
+
 /// Creates a new text entry
+/// @param queue The text queue that owns the entry
 /// @param data The text data
 /// @param length The length of the text
 /// @return A new text entry
-static TextEntry *text_entry_new(char const *data, usize length);
+static TextEntry *text_entry_new(TextQueue *queue, char const *data, usize length);
 
-/// Frees the text entry
+/// Frees the text entry, its slot is returned to the pool of the text queue
+/// @param queue The text queue that owns the entry
 /// @param self The text entry handle
-static void text_entry_free(TextEntry *self);
-
-typedef struct TextQueue {
-    TextEntry *begin;
-    TextEntry *end;
-    usize entries;
-} TextQueue;
+static void text_entry_free(TextQueue *queue, TextEntry *self);
 
 /// Creates a new text queue
+/// @param capacity The maximum amount of entries, which must not be zero
 /// @return A new text queue
-static TextQueue *text_queue_new(void);
+static TextQueue *text_queue_new(usize capacity);
 
 /// Frees the text queue
 /// @param self The text queue handle
@@ -79,7 +94,7 @@ static void text_queue_free(TextQueue *self);
 /// @param self The text queue handle
 static void text_queue_clear(TextQueue *self);
 
-/// Pushes data to the text queue
+/// Pushes data to the text queue, the oldest entry is dropped if the queue is full
 /// @param self The text queue handle
 /// @param data The text data
 /// @param length The text length
@@ -4,9 +4,10 @@
 
 #include "arena.c"
 #include "file.c"
-#include "list.c"
-#include "map.c"
+#include "hash.c"
+#include "intern.c"
 #include "math.c"
+#include "pool.c"
 #include "random.c"
 #include "stack.c"
 #include "text.c"
@@ -5,10 +5,13 @@
 
 #include "types.h"
 
+// Pools are embedded in the containers below
 #include "arena.h"
+#include "pool.h"
+
 #include "file.h"
-#include "list.h"
-#include "map.h"
+#include "hash.h"
+#include "intern.h"
 #include "math.h"
 #include "random.h"
 #include "stack.h"